@@ -89,6 +89,137 @@ namespace dd4hep {
     };
 
 
+    /// Lightweight handle to one field of a BitFieldCoder with inlined encoding and decoding
+    /** The handle caches mask, offset and sign of a field resolved once by name or index.
+     *  Decoding is branch free (sign extension by xor and subtraction), encoding only
+     *  branches on the range check. Out of range values throw the same exception as
+     *  BitFieldElement::set. The handle refers to the field element of the coder:
+     *  the coder must outlive the handle.
+     *
+     *  Example:<br>
+     *    BitFieldHandle layer = bc.handle( "layer" ) ;  <br>
+     *    for( auto id : ids ) ++count[ layer.value( id ) ] ;  <br>
+     */
+    class BitFieldHandle   {
+    public :
+      /// Default constructor: invalid handle
+      BitFieldHandle() = default ;
+      /// Initializing constructor
+      explicit BitFieldHandle( const BitFieldElement& element ) :
+        _mask( element.mask() ),
+        _sign( element.isSigned() ? CellID(1) << ( element.width() - 1 ) : CellID(0) ),
+        _offset( element.offset() ),
+        _minVal( element.minValue() ),
+        _maxVal( element.maxValue() ),
+        _element( &element ) {
+      }
+
+      /** True if the handle is bound to a field */
+      bool isValid() const  { return _element != nullptr ; }
+
+      /** The field element of the coder */
+      const BitFieldElement* element() const { return _element ; }
+
+      /** The field's mask */
+      CellID mask() const  { return _mask ; }
+
+      /** The field's offset */
+      unsigned offset() const  { return _offset ; }
+
+      /// calculate this field's value given an external 64 bit bitmap
+      FieldID value( CellID bitfield ) const {
+        CellID val = ( bitfield & _mask ) >> _offset ;
+        return FieldID( val ^ _sign ) - FieldID( _sign ) ;
+      }
+
+      /// the bits of the value at the field's position (no range check)
+      CellID bits( FieldID in ) const {
+        return ( CellID( in ) << _offset ) & _mask ;
+      }
+
+      /// assign the given value to the bit field
+      void set( CellID& bitfield, FieldID in ) const {
+        if( in < _minVal || in > _maxVal )
+          _element->set( bitfield, in ) ;   // throws the range error
+        bitfield = ( bitfield & ~_mask ) | bits( in ) ;
+      }
+
+      /// calculate this field's values of n bit fields (contiguous arrays, vectorizable)
+      void values( const CellID* bitfields, std::size_t n, FieldID* out ) const {
+        const CellID   mask = _mask, sign = _sign ;
+        const unsigned off  = _offset ;
+        for( std::size_t i = 0 ; i < n ; ++i )
+          out[i] = FieldID( ( ( bitfields[i] & mask ) >> off ) ^ sign ) - FieldID( sign ) ;
+      }
+
+      /// assign the values to this field of n bit fields (contiguous arrays, vectorizable)
+      /** The range of all values is checked first: if one is out of range the
+       *  exception is thrown before any bit field is modified.
+       */
+      void set( CellID* bitfields, std::size_t n, const FieldID* in ) const {
+        const CellID   mask = _mask ;
+        const unsigned off  = _offset ;
+        int bad = 0 ;
+        for( std::size_t i = 0 ; i < n ; ++i )
+          bad |= int( in[i] < _minVal ) | int( in[i] > _maxVal ) ;
+        if( bad ) {
+          for( std::size_t i = 0 ; i < n ; ++i ) {
+            CellID dummy = 0 ;
+            set( dummy, in[i] ) ;   // throws the range error of the first bad value
+          }
+        }
+        for( std::size_t i = 0 ; i < n ; ++i )
+          bitfields[i] = ( bitfields[i] & ~mask ) | ( ( CellID( in[i] ) << off ) & mask ) ;
+      }
+
+    protected:
+      CellID  _mask      {} ;
+      CellID  _sign      {} ;
+      unsigned _offset   {} ;
+      FieldID _minVal    {} ;
+      FieldID _maxVal    {} ;
+      const BitFieldElement* _element { nullptr } ;
+    };
+
+
+    /// Compile time description of a field with fixed offset and width
+    /** For ID descriptors fixed at compile time the field layout may be given
+     *  as template arguments. WIDTH is negative for signed fields, as in the
+     *  descriptor string. All accessors are constexpr and fully inlined.
+     *  Use matches() to verify the layout against the runtime descriptor.
+     *
+     *  Example:<br>
+     *    using Layer = BitFieldFixed<8,8> ;    // "system:8,layer:8,..."  <br>
+     *    assert( Layer::matches( bc["layer"] ) ) ;  <br>
+     *    int layer = Layer::value( id ) ;  <br>
+     */
+    template <unsigned OFFSET, int WIDTH> struct BitFieldFixed   {
+      static constexpr unsigned width    = unsigned( WIDTH < 0 ? -WIDTH : WIDTH ) ;
+      static constexpr unsigned offset   = OFFSET ;
+      static constexpr bool     isSigned = WIDTH < 0 ;
+      static_assert( width > 0 && OFFSET + width <= 64, "BitFieldFixed: field out of range" ) ;
+      static constexpr CellID   mask     = ( width == 64 ? ~CellID(0) : ( CellID(1) << width ) - 1 ) << OFFSET ;
+      static constexpr CellID   sign     = isSigned ? CellID(1) << ( width - 1 ) : CellID(0) ;
+
+      /// calculate this field's value given an external 64 bit bitmap
+      static constexpr FieldID value( CellID bitfield ) {
+        return FieldID( ( ( bitfield & mask ) >> OFFSET ) ^ sign ) - FieldID( sign ) ;
+      }
+      /// the bits of the value at the field's position (no range check)
+      static constexpr CellID bits( FieldID in ) {
+        return ( CellID( in ) << OFFSET ) & mask ;
+      }
+      /// return the bit field with the given value assigned to this field (no range check)
+      static constexpr CellID set( CellID bitfield, FieldID in ) {
+        return ( bitfield & ~mask ) | bits( in ) ;
+      }
+      /// check the layout against a field of a runtime descriptor
+      static bool matches( const BitFieldElement& element ) {
+        return element.offset() == OFFSET && element.width() == width && element.isSigned() == isSigned ;
+      }
+    };
+
+
   
     /// Helper class for decoding and encoding a bit field of 64bits for convenient declaration
     /** and manipulation of sub fields of various widths.<br>
@@ -183,6 +314,29 @@ namespace dd4hep {
         _fields.at( index( name ) ).set( bitfield, value ) ;
       }
 
+      /** get the values of sub-field idx of n bit fields (contiguous arrays)
+       */
+      void get(const CellID* bitfields, size_t n, size_t idx, FieldID* values) const {
+        handle( idx ).values( bitfields, n, values ) ;
+      }
+
+      /** set the values of sub-field idx of n bit fields (contiguous arrays).
+       *  No bit field is modified if a value is out of range.
+       */
+      void set(CellID* bitfields, size_t n, size_t idx, const FieldID* values) const {
+        handle( idx ).set( bitfields, n, values ) ;
+      }
+
+      /** encode n tuples of field values into n bit fields.
+       *  The values are given row by row: size() values per tuple in field order.
+       */
+      void encode(const FieldID* values, size_t n, CellID* bitfields) const ;
+
+      /** decode n bit fields into n tuples of field values.
+       *  The values are returned row by row: size() values per tuple in field order.
+       */
+      void decode(const CellID* bitfields, size_t n, FieldID* values) const ;
+
       /** Highest bit used in fields [0-63]
        */
       unsigned highestBit() const ;
@@ -206,6 +360,20 @@ namespace dd4hep {
         return _fields[ idx ] ;
       }
 
+      /** Handle with inlined access to the field specified by index.
+       *  Resolve handles once outside of loops.
+       */
+      BitFieldHandle handle(size_t idx) const {
+        return BitFieldHandle( _fields.at( idx ) ) ;
+      }
+
+      /** Handle with inlined access to the field named 'name'.
+       *  Resolve handles once outside of loops.
+       */
+      BitFieldHandle handle(const std::string& name) const {
+        return BitFieldHandle( _fields.at( index( name ) ) ) ;
+      }
+
       /** Return a valid description string of all fields
        */
       std::string fieldDescription() const ;
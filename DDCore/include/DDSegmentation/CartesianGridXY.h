@@ -80,11 +80,15 @@ namespace dd4hep {
       /// set the field name used for X
       void setFieldNameX(const std::string& fieldName) {
         _xId = fieldName;
+        updateFieldHandles();
       }
       /// set the field name used for Y
       void setFieldNameY(const std::string& fieldName) {
         _yId = fieldName;
+        updateFieldHandles();
       }
+      /// Set the underlying decoder and resolve the field handles of X and Y
+      virtual void setDecoder(const BitFieldCoder* decoder);
       /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
           in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
 
@@ -97,6 +101,18 @@ namespace dd4hep {
       virtual std::vector<double> cellDimensions(const CellID& cellID) const;
 
     protected:
+      /// Cell ID identifier parameter resolving the field handles again when it is set
+      class IdentifierParameter;
+      /// Field handles of X and Y
+      struct FieldHandles  {
+        BitFieldHandle x, y;
+      };
+      /// Resolve the field handles of X and Y from the decoder
+      void updateFieldHandles();
+      /// Register a cell ID identifier, which resolves the field handles again when it is set
+      void registerFieldIdentifier(const std::string& nam, const std::string& desc,
+                                   std::string& ident, const std::string& defaultVal);
+
       /// the grid size in X
       double _gridSizeX;
       /// the coordinate offset in X
@@ -109,6 +125,8 @@ namespace dd4hep {
       std::string _xId;
       /// the field name used for Y
       std::string _yId;
+      /// field handles of the identifiers. Invalid handles if the decoder has no such field
+      FieldHandles _fields;   //!
     };
 
   } /* namespace DDSegmentation */
@@ -17,6 +17,9 @@
 // Framework include files
 #include <XML/XMLElements.h>
 
+// C/C++ include files
+#include <vector>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -65,6 +68,11 @@ namespace dd4hep {
 
       /// Set minimum print level
       static int setMinimumPrintLevel(int level);
+      /// Install recorder of the system paths of all loaded documents. Returns the previous recorder
+      /** Note: installing the recorder is not thread safe.
+       *  Only to be used while the detector description is loaded.
+       */
+      static std::vector<std::string>* setDocumentRecorder(std::vector<std::string>* recorder);
       /// System ID of a given XML entity
       static std::string system_path(Handle_t base);
       /// System ID of a new XML entity in the same directory as base
@@ -505,6 +505,7 @@ UNICODE (temperature);
 UNICODE (theta);
 UNICODE (thetaBins);
 UNICODE (thickness);
+UNICODE (threads);
 UNICODE (threshold);
 UNICODE (title);
 UNICODE (torus);
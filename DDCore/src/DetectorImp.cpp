@@ -45,6 +45,7 @@
 #include <TClass.h>
 
 #include <XML/DocumentHandler.h>
+#include "GeometryCache.h"
 
 #ifndef __TIXML__
 #include <xercesc/dom/DOMException.hpp>
@@ -799,6 +800,36 @@ void DetectorImp::init() {
 void DetectorImp::fromXML(const std::string& xmlfile, DetectorBuildType build_type) {
   std::lock_guard<std::recursive_mutex> lock(s_detector_apply_lock);
   m_buildType = build_type;
+  std::string cache_dir = detail::GeometryCache::environment_directory();
+  if ( !cache_dir.empty() && m_state == NOT_READY )   {
+    detail::GeometryCache cache(cache_dir, xmlfile, build_type);
+    if ( cache.usable() )   {
+      std::vector<std::string> documents;
+      detail::GeometryCache::PluginRecord plugins;
+      if ( cache.load(*this) )   {
+        mapDetectorTypes();
+        m_state = READY;
+        cache.replay(*this);
+        return;
+      }
+      /// Record all XML documents contributing to the geometry and the executed <plugins> sections
+      auto* previous = xml::DocumentHandler::setDocumentRecorder(&documents);
+      auto* previous_plugins = detail::GeometryCache::setPluginRecorder(&plugins);
+      try  {
+        processXML(xmlfile, nullptr);
+      }
+      catch(...)  {
+        xml::DocumentHandler::setDocumentRecorder(previous);
+        detail::GeometryCache::setPluginRecorder(previous_plugins);
+        throw;
+      }
+      xml::DocumentHandler::setDocumentRecorder(previous);
+      detail::GeometryCache::setPluginRecorder(previous_plugins);
+      if ( m_state == READY )
+        cache.save(*this, documents, plugins);
+      return;
+    }
+  }
   processXML(xmlfile, nullptr);
 }
 
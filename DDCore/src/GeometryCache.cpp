@@ -0,0 +1,406 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Handle.h>
+#include <DD4hep/Plugins.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/Primitives.h>
+#include <DD4hep/DetectorTools.h>
+#include <DD4hep/ExtensionEntry.h>
+#include <DD4hep/detail/DetectorInterna.h>
+#include <DD4hep/DD4hepRootPersistency.h>
+#include <XML/DocumentHandler.h>
+#include "GeometryCache.h"
+
+// ROOT include files
+#include <TROOT.h>
+#include <TFile.h>
+#include <TClass.h>
+#include <TSystem.h>
+
+// C/C++ include files
+#include <set>
+#include <cctype>
+#include <memory>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <functional>
+
+using namespace dd4hep;
+using namespace dd4hep::detail;
+
+namespace {
+  std::string to_hex(GeometryCache::hash_t hash)   {
+    char text[32];
+    ::snprintf(text, sizeof(text), "%016llx", hash);
+    return text;
+  }
+  std::string local_path(const std::string& input)   {
+    return input.substr(0,5) == "file:" ? input.substr(5) : input;
+  }
+
+  /// Recorder of the <plugins> sections executed while a geometry is built for the cache
+  GeometryCache::PluginRecord* s_pluginRecord = nullptr;
+
+  /// DetElement extension written to the geometry snapshot
+  struct SnapshotExtension  {
+    std::string           path;
+    GeometryCache::hash_t hash;
+    TClass*               cls;
+    void*                 object;
+  };
+
+  /// Extension entry of an object restored from the geometry snapshot
+  class RestoredExtension : public ExtensionEntry  {
+    void*                 ptr;
+    TClass*               cls;
+    GeometryCache::hash_t key;
+  public:
+    /// Initializing constructor
+    RestoredExtension(void* p, TClass* c, GeometryCache::hash_t k) : ptr(p), cls(c), key(k)  {}
+    /// Virtual object accessor
+    virtual void* object()     const override  { return ptr;                    }
+    /// Virtual object copy operator
+    virtual void* copy(void*)  const override  { invalidCall("copy"); return 0; }
+    /// Virtual object destructor
+    virtual void  destruct()   const override  { cls->Destructor(ptr);          }
+    /// Virtual entry clone function
+    virtual ExtensionEntry* clone(void*)  const override  { invalidCall("clone"); return 0; }
+    /// Hash value
+    virtual unsigned long long int hash64()  const override  { return key;      }
+  };
+
+  /// Access the ROOT class of an extension object: the interface type is the first template argument of the entry
+  TClass* extension_class(const ExtensionEntry* entry, GeometryCache::hash_t hash)   {
+    std::string nam = typeName(typeid(*entry));
+    std::size_t beg = nam.find('<'), end = beg;
+    if ( beg == std::string::npos )
+      return nullptr;
+    for( int level = 0; ++end < nam.length(); )   {
+      char c = nam[end];
+      if ( c == '<' ) ++level;
+      else if ( c == '>' && level-- == 0 ) break;
+      else if ( c == ',' && level == 0 ) break;
+    }
+    std::string typ = nam.substr(beg+1, end-beg-1);
+    TClass* cls = TClass::GetClass(typ.c_str(), kTRUE, kTRUE);
+    if ( !cls || !cls->GetTypeInfo() || hash64(cls->GetTypeInfo()->name()) != hash )
+      return nullptr;
+    /// Objects of derived types would be sliced
+    return cls->GetActualClass(entry->object()) == cls ? cls : nullptr;
+  }
+
+  /// Collect the DetElement extensions, which are not recreated by the <plugins> sections
+  bool snapshot_extensions(DetElement de,
+                           const GeometryCache::ExtensionKeys& plugins,
+                           std::vector<SnapshotExtension>& extensions)
+  {
+    for( const auto& ext : de.ptr()->extensions )   {
+      if ( plugins.find(std::make_pair((const void*)de.ptr(), ext.first)) != plugins.end() )
+        continue;
+      TClass* cls = extension_class(ext.second, ext.first);
+      if ( !cls )   {
+        printout(INFO, "GeometryCache", "+++ Extension %s of %s has no ROOT dictionary. Geometry is not cached.",
+                 typeName(typeid(*ext.second)).c_str(), de.path().c_str());
+        return false;
+      }
+      extensions.emplace_back(SnapshotExtension { de.path(), ext.first, cls, ext.second->object() });
+    }
+    for( const auto& child : de.children() )
+      if ( !snapshot_extensions(child.second, plugins, extensions) ) return false;
+    return true;
+  }
+}
+
+/// Initializing constructor
+GeometryCache::PluginSection::PluginSection(Detector& desc, const xml::Handle_t& compact)
+  : description(desc)
+{
+  /// Compact files included from a <plugins> section are executed with the enclosing section
+  if ( (record = s_pluginRecord) && 0 == record->depth++ )   {
+    record->documents.emplace_back(xml::DocumentHandler::system_path(compact));
+    extension_keys(description.world(), before);
+  }
+}
+
+/// Default destructor. Records the extensions attached by the section
+GeometryCache::PluginSection::~PluginSection()   {
+  if ( record && 0 == --record->depth )   {
+    ExtensionKeys after;
+    extension_keys(description.world(), after);
+    for( const auto& key : after )
+      if ( before.find(key) == before.end() ) record->extensions.insert(key);
+  }
+}
+
+/// Initializing constructor
+GeometryCache::GeometryCache(const std::string& dir, const std::string& inp, DetectorBuildType typ)
+  : directory(dir), input(local_path(inp)), type(typ)
+{
+}
+
+/// Cache directory from the environment. Empty if the cache is disabled
+std::string GeometryCache::environment_directory()   {
+  const char* dir = ::getenv("DD4HEP_GEOMETRY_CACHE");
+  return dir ? std::string(dir) : std::string();
+}
+
+/// Check if the input may be cached: local files only
+bool GeometryCache::usable()  const   {
+  if ( directory.empty() || input.empty() || input.find("://") != std::string::npos )
+    return false;
+  return !gSystem->AccessPathName(input.c_str());
+}
+
+/// Name of the index file of the top level document
+std::string GeometryCache::index_name()  const   {
+  std::string path = gSystem->UnixPathName(input.c_str());
+  if ( !gSystem->IsAbsoluteFileName(path.c_str()) )
+    path = std::string(gSystem->WorkingDirectory()) + "/" + path;
+  return directory + "/index_" + to_hex(hash64(path + "|" + buildTypeName(type))) + ".txt";
+}
+
+/// Name of the snapshot file of a given key
+std::string GeometryCache::snapshot_name(hash_t key)  const   {
+  return directory + "/geometry_" + to_hex(key) + ".root";
+}
+
+/// Compute the snapshot key from the input documents and their hashes
+GeometryCache::hash_t
+GeometryCache::snapshot_key(const std::vector<std::pair<hash_t, std::string> >& documents)  const   {
+  hash_t key = hash64("DD4hep " + versionString());
+  key = update_hash64(key, std::string(gROOT->GetVersion()));
+  key = update_hash64(key, buildTypeName(type));
+  for( const auto& doc : documents )   {
+    key = update_hash64(key, doc.second);
+    key = update_hash64(key, &doc.first, sizeof(doc.first));
+  }
+  return key;
+}
+
+/// Hash the content of a file. Returns false if the file cannot be read
+bool GeometryCache::content_hash(const std::string& path, hash_t& hash)   {
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  if ( !in.good() )
+    return false;
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  hash = hash64(content.data(), content.length());
+  return true;
+}
+
+/// Collect the extension keys of a DetElement hierarchy
+void GeometryCache::extension_keys(DetElement de, ExtensionKeys& keys)   {
+  if ( !de.isValid() )
+    return;
+  for( const auto& ext : de.ptr()->extensions )
+    keys.emplace(de.ptr(), ext.first);
+  for( const auto& child : de.children() )
+    extension_keys(child.second, keys);
+}
+
+/// Install recorder of the executed <plugins> sections. Returns the previous recorder
+GeometryCache::PluginRecord* GeometryCache::setPluginRecorder(PluginRecord* record)   {
+  PluginRecord* tmp = s_pluginRecord;
+  s_pluginRecord = record;
+  return tmp;
+}
+
+/// Re-register the constants of a restored description to the expression evaluator
+void GeometryCache::register_constants(Detector& description)   {
+  const auto& defines = description.constants();
+  std::set<std::string> done;
+  /// Constants may refer to each other: register the dependencies first
+  std::function<void(const std::string&)> define = [&](const std::string& name)  {
+    auto iter = defines.find(name);
+    if ( iter == defines.end() || !done.insert(name).second )
+      return;
+    Constant c = iter->second;
+    std::string value = c->GetTitle(), typ = c.dataType();
+    if ( typ != "string" )   {
+      for( std::size_t i = 0; i < value.length(); )   {
+        if ( ::isalpha(value[i]) || value[i] == '_' )   {
+          std::size_t j = i;
+          while( j < value.length() && (::isalnum(value[j]) || value[j] == '_' || value[j] == ':') ) ++j;
+          define(value.substr(i, j-i));
+          i = j;
+          continue;
+        }
+        ++i;
+      }
+    }
+    _toDictionary(name, value, typ);
+  };
+  for( const auto& c : defines )
+    define(c.first);
+  printout(DEBUG, "GeometryCache", "+++ Registered %ld constants to the expression evaluator.", done.size());
+}
+
+/// Restore the detector description from the cache. Returns true on success
+bool GeometryCache::load(Detector& description)   {
+  std::vector<std::pair<hash_t, std::string> > documents;
+  std::vector<SnapshotExtension> extensions;
+  std::string   index = index_name(), line;
+  std::ifstream in(index);
+  hash_t        key = 0;
+
+  if ( !in.good() || !std::getline(in, line) )   {
+    printout(INFO, "GeometryCache", "+++ No cache entry for %s.", input.c_str());
+    return false;
+  }
+  try  {
+    key = std::stoull(line, nullptr, 16);
+    plugin_documents.clear();
+    while( std::getline(in, line) )   {
+      if ( line.substr(0,2) == "P " )   {
+        plugin_documents.emplace_back(line.substr(2));
+        continue;
+      }
+      else if ( line.substr(0,2) == "X " )   {
+        std::istringstream entry(line.substr(2));
+        std::string hash, path, cls;
+        entry >> hash >> path >> std::ws;
+        std::getline(entry, cls);
+        extensions.emplace_back(SnapshotExtension { path, std::stoull(hash, nullptr, 16), 0, 0 });
+        if ( !(extensions.back().cls = TClass::GetClass(cls.c_str())) )   {
+          printout(INFO, "GeometryCache", "+++ No ROOT dictionary for extension %s. Cache entry is not usable.", cls.c_str());
+          return false;
+        }
+        continue;
+      }
+      std::size_t idx = line.find(' ');
+      if ( idx == std::string::npos ) continue;
+      hash_t recorded = std::stoull(line.substr(0, idx), nullptr, 16), current = 0;
+      std::string path = line.substr(idx+1);
+      if ( !content_hash(path, current) || current != recorded )   {
+        printout(INFO, "GeometryCache", "+++ Input %s changed. Cache entry is outdated.", path.c_str());
+        return false;
+      }
+      documents.emplace_back(recorded, path);
+    }
+  }
+  catch(const std::exception& e)   {
+    printout(WARNING, "GeometryCache", "+++ Corrupted cache index %s: %s", index.c_str(), e.what());
+    return false;
+  }
+  if ( documents.empty() || snapshot_key(documents) != key )   {
+    printout(INFO, "GeometryCache", "+++ Cache entry of %s does not match this software version.", input.c_str());
+    return false;
+  }
+  std::string snapshot = snapshot_name(key);
+  if ( gSystem->AccessPathName(snapshot.c_str()) )   {
+    printout(INFO, "GeometryCache", "+++ Missing geometry snapshot %s.", snapshot.c_str());
+    return false;
+  }
+  if ( 1 != DD4hepRootPersistency::load(description, snapshot.c_str(), "Geometry") )   {
+    except("GeometryCache", "+++ Failed to restore the geometry snapshot %s.", snapshot.c_str());
+  }
+  register_constants(description);
+  if ( !extensions.empty() )   {
+    std::unique_ptr<TFile> file(TFile::Open(snapshot.c_str()));
+    for( std::size_t i = 0; i < extensions.size(); ++i )   {
+      const auto& ext = extensions[i];
+      std::string nam = "extension_" + std::to_string(i);
+      DetElement  de  = detail::tools::findElement(description, ext.path);
+      void*       obj = file && !file->IsZombie() ? file->GetObjectChecked(nam.c_str(), ext.cls) : nullptr;
+      if ( !de.isValid() || !obj )   {
+        except("GeometryCache", "+++ Failed to restore extension %s of %s from %s.",
+               ext.cls->GetName(), ext.path.c_str(), snapshot.c_str());
+      }
+      de.ptr()->addExtension(ext.hash, new RestoredExtension(obj, ext.cls, ext.hash));
+    }
+  }
+  printout(ALWAYS, "GeometryCache", "+++ Restored geometry of %s from %s [%ld inputs, %ld extensions]",
+           input.c_str(), snapshot.c_str(), documents.size(), extensions.size());
+  return true;
+}
+
+/// Execute the <plugins> sections of a restored detector description
+void GeometryCache::replay(Detector& description)  const   {
+  for( const auto& path : plugin_documents )   {
+    xml::DocumentHolder doc(xml::DocumentHandler().load(path));
+    xml::Handle_t handle = doc.root();
+    long result = PluginService::Create<long>("DD4hep_CompactPlugins", &description, &handle);
+    if ( 0 == result || 1 != *(long*)result )   {
+      except("GeometryCache", "+++ Failed to execute the <plugins> section of %s.", path.c_str());
+    }
+    printout(INFO, "GeometryCache", "+++ Executed the <plugins> section of %s.", path.c_str());
+  }
+}
+
+/// Save the detector description together with the index of the input documents
+bool GeometryCache::save(Detector& description,
+                         const std::vector<std::string>& documents,
+                         const PluginRecord& plugins)  const
+{
+  std::vector<std::pair<hash_t, std::string> > inputs;
+  std::vector<SnapshotExtension> extensions;
+  std::set<std::string> seen;
+  for( const auto& doc : documents )   {
+    hash_t hash = 0;
+    if ( !seen.insert(doc).second )
+      continue;
+    if ( !content_hash(doc, hash) )   {
+      printout(WARNING, "GeometryCache", "+++ Cannot hash input %s. Geometry is not cached.", doc.c_str());
+      return false;
+    }
+    inputs.emplace_back(hash, doc);
+  }
+  if ( inputs.empty() )
+    return false;
+  /// Extensions attached by the <plugins> sections are recreated when they are replayed
+  if ( !snapshot_extensions(description.world(), plugins.extensions, extensions) )
+    return false;
+
+  gSystem->mkdir(directory.c_str(), kTRUE);
+  hash_t      key      = snapshot_key(inputs);
+  std::string pid      = "." + std::to_string(gSystem->GetPid()) + ".tmp";
+  std::string snapshot = snapshot_name(key), index = index_name();
+
+  /// Many jobs may share the cache directory: write to temporaries and rename
+  bool written = DD4hepRootPersistency::save(description, (snapshot+pid).c_str(), "Geometry") > 1;
+  if ( written && !extensions.empty() )   {
+    std::unique_ptr<TFile> file(TFile::Open((snapshot+pid).c_str(), "UPDATE"));
+    written = file && !file->IsZombie();
+    for( std::size_t i = 0; written && i < extensions.size(); ++i )   {
+      std::string nam = "extension_" + std::to_string(i);
+      written = file->WriteObjectAny(extensions[i].object, extensions[i].cls, nam.c_str()) > 0;
+    }
+    if ( file ) file->Close();
+  }
+  if ( !written || 0 != gSystem->Rename((snapshot+pid).c_str(), snapshot.c_str()) )   {
+    gSystem->Unlink((snapshot+pid).c_str());
+    printout(WARNING, "GeometryCache", "+++ Failed to write geometry snapshot %s.", snapshot.c_str());
+    return false;
+  }
+  {
+    std::ofstream out(index+pid);
+    out << to_hex(key) << std::endl;
+    for( const auto& doc : inputs )
+      out << to_hex(doc.first) << " " << doc.second << std::endl;
+    for( const auto& doc : plugins.documents )
+      out << "P " << doc << std::endl;
+    for( const auto& ext : extensions )
+      out << "X " << to_hex(ext.hash) << " " << ext.path << " " << ext.cls->GetName() << std::endl;
+  }
+  if ( 0 != gSystem->Rename((index+pid).c_str(), index.c_str()) )   {
+    gSystem->Unlink((index+pid).c_str());
+    printout(WARNING, "GeometryCache", "+++ Failed to write cache index %s.", index.c_str());
+    return false;
+  }
+  printout(ALWAYS, "GeometryCache", "+++ Saved geometry of %s to %s [%ld inputs, %ld extensions]",
+           input.c_str(), snapshot.c_str(), inputs.size(), extensions.size());
+  return true;
+}
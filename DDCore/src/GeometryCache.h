@@ -0,0 +1,152 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDCORE_SRC_GEOMETRYCACHE_H
+#define DDCORE_SRC_GEOMETRYCACHE_H
+
+// Framework include files
+#include <DD4hep/Detector.h>
+#include <XML/XMLElements.h>
+
+// C/C++ include files
+#include <set>
+#include <string>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for implementation details of the AIDA detector description toolkit
+  namespace detail {
+
+    /// Content addressed cache of fully constructed detector descriptions
+    /**
+     *  The cache is enabled by the environment variable DD4HEP_GEOMETRY_CACHE
+     *  pointing to a (shared) directory. It is only used for the first XML
+     *  document loaded into an empty detector description.
+     *
+     *  For every top level compact file an index records all XML documents
+     *  loaded while the geometry was built together with the hash of their
+     *  content. If none of the inputs changed, the detector description
+     *  (volumes, DetElements, readouts, VolumeManager, constants) is restored
+     *  from the ROOT snapshot written by DD4hepRootPersistency. Otherwise
+     *  the geometry is built from XML and a new snapshot is written.
+     *
+     *  The <plugins> sections of the compact files are executed again after
+     *  the snapshot was restored, in the order they were executed when the
+     *  geometry was built. The DetElement extensions attached by these plugins
+     *  are hence recreated. All other DetElement extensions (e.g. DDRec data
+     *  structures attached by the detector constructors) are written to the
+     *  snapshot file using their ROOT dictionary and attached again on restore.
+     *
+     *  Limitations:
+     *  - Inputs not read as XML documents (e.g. GDML or field map files read
+     *    directly by detector constructors, the detector constructor libraries
+     *    themselves) are not part of the hash. Clear the cache after changes.
+     *  - Geometries with DetElement extensions, which are neither attached by
+     *    a <plugins> section nor have a ROOT dictionary, are not cached.
+     *  - User extensions of the Detector object are only recreated if they
+     *    are attached by a <plugins> section.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_CORE
+     */
+    class GeometryCache  {
+    public:
+      /// Hash type of the cache entries
+      using hash_t = unsigned long long int;
+      /// Keys of DetElement extensions: (DetElement object, extension type hash)
+      using ExtensionKeys = std::set<std::pair<const void*, hash_t> >;
+
+      /// Record of the <plugins> sections executed while a geometry is built
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_CORE
+       */
+      class PluginRecord  {
+      public:
+        /// System paths of the compact documents with <plugins> sections in order of execution
+        std::vector<std::string> documents;
+        /// DetElement extensions attached while the <plugins> sections were executed
+        ExtensionKeys            extensions;
+        /// Nesting level: compact files included from a <plugins> section are replayed with it
+        int                      depth = 0;
+      };
+
+      /// Scope of the execution of a <plugins> section of a compact document
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_CORE
+       */
+      class PluginSection  {
+        /// Reference to the detector description
+        Detector&     description;
+        /// Active record. Null if no geometry is built for the cache
+        PluginRecord* record = nullptr;
+        /// DetElement extensions before the section was executed
+        ExtensionKeys before;
+      public:
+        /// Initializing constructor
+        PluginSection(Detector& description, const xml::Handle_t& compact);
+        /// Default destructor. Records the extensions attached by the section
+        ~PluginSection();
+      };
+
+      /// Cache directory
+      std::string        directory;
+      /// File name of the top level XML document
+      std::string        input;
+      /// Build type of the detector description
+      DetectorBuildType  type;
+      /// Compact documents with <plugins> sections to be replayed after a restore
+      std::vector<std::string> plugin_documents;
+
+    protected:
+      /// Name of the index file of the top level document
+      std::string index_name()  const;
+      /// Name of the snapshot file of a given key
+      std::string snapshot_name(hash_t key)  const;
+      /// Compute the snapshot key from the input documents and their hashes
+      hash_t snapshot_key(const std::vector<std::pair<hash_t, std::string> >& documents)  const;
+      /// Hash the content of a file. Returns false if the file cannot be read
+      static bool content_hash(const std::string& path, hash_t& hash);
+      /// Collect the extension keys of a DetElement hierarchy
+      static void extension_keys(DetElement de, ExtensionKeys& keys);
+      /// Re-register the constants of a restored description to the expression evaluator
+      static void register_constants(Detector& description);
+
+    public:
+      /// Initializing constructor
+      GeometryCache(const std::string& dir, const std::string& input, DetectorBuildType type);
+      /// Default destructor
+      ~GeometryCache() = default;
+      /// Cache directory from the environment. Empty if the cache is disabled
+      static std::string environment_directory();
+      /// Install recorder of the executed <plugins> sections. Returns the previous recorder
+      static PluginRecord* setPluginRecorder(PluginRecord* record);
+      /// Check if the input may be cached: local files only
+      bool usable()  const;
+      /// Restore the detector description from the cache. Returns true on success
+      bool load(Detector& description);
+      /// Execute the <plugins> sections of a restored detector description
+      void replay(Detector& description)  const;
+      /// Save the detector description together with the index of the input documents
+      bool save(Detector& description,
+                const std::vector<std::string>& documents,
+                const PluginRecord& plugins)  const;
+    };
+  }    // End namespace detail
+}      // End namespace dd4hep
+#endif // DDCORE_SRC_GEOMETRYCACHE_H
@@ -17,6 +17,7 @@
 #include <XML/DocumentHandler.h>
 
 // C/C++ include files
+#include <mutex>
 #include <memory>
 #include <iostream>
 #include <sys/types.h>
@@ -29,15 +30,27 @@
 using namespace dd4hep::xml;
 
 namespace {
+  int s_minPrintLevel = dd4hep::INFO;
+  std::vector<std::string>* s_documentRecorder = nullptr;
+  /// Documents may be loaded concurrently (see the compact <geometry threads="N"/> option)
+  std::mutex s_documentLock;
+
   std::string undressed_file_name(const std::string& fn)   {
     if ( !fn.empty() )   {
+      std::lock_guard<std::mutex> lock(s_documentLock);
       TString tfn(fn);
       gSystem->ExpandPathName(tfn);
       return std::string(tfn.Data());
     }
     return fn;
   }
-  int s_minPrintLevel = dd4hep::INFO;
+
+  void record_document(const std::string& path)   {
+    if ( s_documentRecorder && !path.empty() )   {
+      std::lock_guard<std::mutex> lock(s_documentLock);
+      s_documentRecorder->emplace_back(path);
+    }
+  }
 
   std::string _clean_fname(const std::string& filepath) {
     // This function seems to resolve environment variables inside the filepath string and return resolved string
@@ -272,10 +285,18 @@ std::string DocumentHandler::system_path(Handle_t base, const std::string& fn)
   return path;
 }
 
+namespace  {
+  /// Base URI of an element. getBaseURI allocates from the memory pool of the parent document
+  std::string base_uri(const DOMElement* elt)   {
+    std::lock_guard<std::mutex> lock(s_documentLock);
+    return _toString(elt->getBaseURI());
+  }
+}
+
 /// System ID of a given XML entity
 std::string DocumentHandler::system_path(Handle_t base)   {
   DOMElement* elt = (DOMElement*)base.ptr();
-  std::string path = _toString(elt->getBaseURI());
+  std::string path = base_uri(elt);
   if ( path[0] == '/' )  {
     std::string tmp = "file:"+path;
     return tmp;
@@ -293,6 +314,8 @@ Document DocumentHandler::load(Handle_t base, const XMLCh* fname, UriReader* rea
     path      = _toString(fname);
     /// This is a bit complicated, but if the primary source is in-memory
     try  {
+      /// getBaseURI allocates from the memory pool of the parent document
+      std::lock_guard<std::mutex> lock(s_documentLock);
       XMLURL  ref_url(elt->getBaseURI(), p);
       path = _toString(ref_url.getURLText());
     }
@@ -301,12 +324,12 @@ Document DocumentHandler::load(Handle_t base, const XMLCh* fname, UriReader* rea
     return load(path, reader);
   }
   catch(const std::exception& exc)   {
-    std::string b = _toString(elt->getBaseURI());
+    std::string b = base_uri(elt);
     std::string e = _toString(fname);
     printout(DEBUG,"DocumentHandler","+++ URI exception: %s -> %s [%s]",b.c_str(),e.c_str(),exc.what());
   }
   catch(...)   {
-    std::string b = _toString(elt->getBaseURI());
+    std::string b = base_uri(elt);
     std::string e = _toString(fname);
     printout(DEBUG,"DocumentHandler","+++ URI exception: %s -> %s",b.c_str(),e.c_str());
   }
@@ -354,6 +377,7 @@ Document DocumentHandler::load(const std::string& fname, UriReader* reader) cons
   try {
     if ( !path.empty() )  {
       parser->parse(path.c_str());
+      record_document(path);
       if ( reader ) reader->parserLoaded(path);
     }
     else   {
@@ -369,6 +393,7 @@ Document DocumentHandler::load(const std::string& fname, UriReader* reader) cons
     printout(ERROR,"DocumentHandler","+++ Exception(XercesC): parse(path):%s",e.what());
     try {
       parser->parse(fname.c_str());
+      record_document(fname_clean);
       if ( reader ) reader->parserLoaded(path);
     }
     catch (const std::exception& ex) {
@@ -516,6 +541,7 @@ Document DocumentHandler::load(const std::string& fname, UriReader* reader) cons
       printout(INFO,"DocumentHandler","+++ Document %s succesfully parsed with TinyXML .....",
                fname.c_str());
     }
+    record_document(clean);
     return (XmlDocument*)doc;
   }
   delete doc;
@@ -625,6 +651,14 @@ int DocumentHandler::setMinimumPrintLevel(int level)    {
   return tmp;
 }
 
+/// Install recorder of the system paths of all loaded documents. Returns the previous recorder
+std::vector<std::string>* DocumentHandler::setDocumentRecorder(std::vector<std::string>* recorder)   {
+  std::lock_guard<std::mutex> lock(s_documentLock);
+  std::vector<std::string>* tmp = s_documentRecorder;
+  s_documentRecorder = recorder;
+  return tmp;
+}
+
 /// Default comment string
 std::string DocumentHandler::defaultComment()  {
   const char comment[] = "\n"
@@ -37,6 +37,7 @@
 
 #include <XML/DocumentHandler.h>
 #include <XML/Utilities.h>
+#include "../GeometryCache.h"
 
 // Root/TGeo include files
 #include <TGeoManager.h>
@@ -49,6 +50,10 @@
 #include <filesystem>
 #include <iostream>
 #include <climits>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <exception>
 #include <set>
 
 using namespace dd4hep;
@@ -259,6 +264,16 @@ static Ref_t create_MultipoleField(Detector& description, xml_h e) {
 }
 DECLARE_XMLELEMENT(MultipoleMagnet,create_MultipoleField)
 
+/// Execute the <plugins> section of a compact document
+static long load_CompactPlugins(Detector& description, xml_h element) {
+  xml_coll_t(element, _U(plugins)).for_each(_U(plugin),  Converter<Plugin>  (description));
+  xml_coll_t(element, _U(plugins)).for_each(_U(include), Converter<XMLFile> (description));
+  xml_coll_t(element, _U(plugins)).for_each(_U(xml),     Converter<XMLFile> (description));
+  return 1;
+}
+/// Used to replay the <plugins> sections after a geometry was restored from the cache
+DECLARE_XML_PLUGIN(DD4hep_CompactPlugins,load_CompactPlugins)
+
 static long load_Compact(Detector& description, xml_h element) {
   Converter<Compact>converter(description);
   converter(element);
@@ -1625,41 +1640,110 @@ template <> void Converter<Parallelworld_Volume>::operator()(xml_h element) cons
            vol.name(), anchor.path().c_str(), vis.name());
 }
 
+/// Convert the content of a xml document referenced by an include statement
+static void convert_include_document(Detector& description, const xml::Document& doc)  {
+  if ( s_debug.include_guard ) {
+    // Include guard, we check whether this file was already processed
+    if (check_process_file(description, doc.uri()))
+      return;
+  }
+  if ( s_debug.includes )   {
+    printout(ALWAYS, "Compact","++ Processing xml document %s.",doc.uri().c_str());
+  }
+  xml_h node = doc.root();
+  std::string tag = node.tag();
+  if ( tag == "lccdd" )
+    Converter<Compact>(description)(node);
+  else if ( tag == "define" )
+    xml_coll_t(node, _U(constant)).for_each(Converter<Constant>(description));
+  else if ( tag == "readout" )
+    Converter<Readout>(description)(node);
+  else if ( tag == "readouts" )
+    xml_coll_t(node, _U(readout)).for_each(Converter<Readout>(description));
+  else if ( tag == "region" )
+    Converter<Region>(description)(node);
+  else if ( tag == "regions" )
+    xml_coll_t(node, _U(region)).for_each(Converter<Region>(description));
+  else if ( tag == "limits" || tag == "limitsets" )
+    xml_coll_t(node, _U(limitset)).for_each(Converter<LimitSet>(description));
+  else if ( tag == "display" )
+    xml_coll_t(node,_U(vis)).for_each(Converter<VisAttr>(description));
+  else if ( tag == "detector" )
+    Converter<DetElement>(description)(node);
+  else if ( tag == "detectors" )
+    xml_coll_t(node,_U(detector)).for_each(Converter<DetElement>(description));
+}
+
+/// Process a set of include statements. The xml documents are loaded concurrently.
+/**
+ *  The detector construction itself stays sequential and in the order of the
+ *  include statements: the registries of the TGeoManager are not thread safe.
+ *  The references of the include statements must not depend on constants
+ *  defined by preceding include statements.
+ */
+static void convert_includes(Detector& description, const std::vector<xml_h>& includes, int num_threads)  {
+  using clock_t = std::chrono::steady_clock;
+  std::size_t num_docs = includes.size(), num_xml = 0;
+  std::vector<const XmlChar*>     refs(num_docs, nullptr);
+  std::vector<xml::Document>      docs(num_docs, xml::Document(0));
+  std::vector<std::exception_ptr> errors(num_docs);
+  std::atomic<std::size_t>        next { 0 };
+
+  for( std::size_t i = 0; i < num_docs; ++i )  {
+    xml_h inc = includes[i];
+    std::string type = inc.hasAttr(_U(type)) ? inc.attr<std::string>(_U(type)) : std::string("xml");
+    if ( type == "xml" )  {
+      refs[i] = inc.attr_value(_U(ref));
+      ++num_xml;
+    }
+  }
+  auto load_documents = [&]()  {
+    for( std::size_t i = next++; i < num_docs; i = next++ )  {
+      if ( refs[i] )  {
+        try  {
+          docs[i] = xml::DocumentHandler().load(includes[i], refs[i]);
+        }
+        catch(...)  {
+          errors[i] = std::current_exception();
+        }
+      }
+    }
+  };
+  auto start = clock_t::now();
+  std::vector<std::thread> workers;
+  for( std::size_t i = 1; i < std::size_t(num_threads) && i < num_xml; ++i )
+    workers.emplace_back(load_documents);
+  load_documents();
+  for( auto& w : workers )
+    w.join();
+  std::chrono::duration<double> secs = clock_t::now() - start;
+  if ( num_xml > 0 )  {
+    printout(INFO, "Compact", "++ Loaded %ld included xml documents with %ld threads in %.3f seconds. "
+             "Only the xml parsing is concurrent, the detectors are constructed sequentially.",
+             num_xml, workers.size()+1, secs.count());
+  }
+
+  /// Take ownership of all documents before any conversion may throw
+  std::vector<std::unique_ptr<xml::DocumentHolder> > holders(num_docs);
+  for( std::size_t i = 0; i < num_docs; ++i )  {
+    if ( docs[i].ptr() ) holders[i].reset(new xml::DocumentHolder(docs[i]));
+  }
+  for( std::size_t i = 0; i < num_docs; ++i )  {
+    if ( errors[i] )
+      std::rethrow_exception(errors[i]);
+    else if ( refs[i] )
+      convert_include_document(description, docs[i]);
+    else
+      Converter<DetElementInclude>(description)(includes[i]);
+  }
+}
+
 /// Process include statements in various sub-tags of compact
 template <> void Converter<DetElementInclude>::operator()(xml_h element) const {
   std::string type = element.hasAttr(_U(type)) ? element.attr<std::string>(_U(type)) : std::string("xml");
   if ( type == "xml" )  {
     xml::DocumentHolder doc(xml::DocumentHandler().load(element, element.attr_value(_U(ref))));
-    if ( s_debug.include_guard ) {
-      // Include guard, we check whether this file was already processed
-      if (check_process_file(description, doc.uri()))
-        return;
-    }
-    if ( s_debug.includes )   {
-      printout(ALWAYS, "Compact","++ Processing xml document %s.",doc.uri().c_str());
-    }
-    xml_h node = doc.root();
-    std::string tag = node.tag();
-    if ( tag == "lccdd" )
-      Converter<Compact>(this->description)(node);
-    else if ( tag == "define" )
-      xml_coll_t(node, _U(constant)).for_each(Converter<Constant>(this->description));
-    else if ( tag == "readout" )
-      Converter<Readout>(this->description)(node);
-    else if ( tag == "readouts" )
-      xml_coll_t(node, _U(readout)).for_each(Converter<Readout>(this->description));
-    else if ( tag == "region" )
-      Converter<Region>(this->description)(node);
-    else if ( tag == "regions" )
-      xml_coll_t(node, _U(region)).for_each(Converter<Region>(this->description));
-    else if ( tag == "limits" || tag == "limitsets" )
-      xml_coll_t(node, _U(limitset)).for_each(Converter<LimitSet>(this->description));
-    else if ( tag == "display" )
-      xml_coll_t(node,_U(vis)).for_each(Converter<VisAttr>(this->description));
-    else if ( tag == "detector" )
-      Converter<DetElement>(this->description)(node);
-    else if ( tag == "detectors" )
-      xml_coll_t(node,_U(detector)).for_each(Converter<DetElement>(this->description));
+    convert_include_document(this->description, doc);
   }
   else if ( type == "json" )  {
     Converter<JsonFile>(this->description)(element);
@@ -1681,8 +1765,19 @@ template <> void Converter<DetElementInclude>::operator()(xml_h element) const {
 /// Main compact conversion entry point
 template <> void Converter<Compact>::operator()(xml_h element) const {
   static int num_calls = 0;
+  /// Loader threads of the enclosing compact document. Only valid while it is converted.
+  static int enclosing_threads = 1;
+  /// Number of threads loading included xml documents. Steered by <geometry threads="N"/>
+  /// Nested compact documents inherit the setting of the enclosing document.
+  int  build_threads = num_calls > 0 ? enclosing_threads : 1;
   char text[32];
 
+  /// Restore the setting of the enclosing document, also if the conversion fails
+  struct ThreadsGuard  {
+    int saved;
+    ~ThreadsGuard()  { enclosing_threads = saved; }
+  } threads_guard { enclosing_threads };
+
   ++num_calls;
   xml_elt_t compact(element);
   bool steer_geometry = compact.hasChild(_U(geometry));
@@ -1704,6 +1799,8 @@ template <> void Converter<Compact>::operator()(xml_h element) const {
       close_document = steer.attr<bool>(_U(close));
     if ( steer.hasAttr(_U(reflect)) )
       build_reflections = steer.attr<bool>(_U(reflect));
+    if ( steer.hasAttr(_U(threads)) )
+      build_threads = steer.attr<int>(_U(threads));
     for (xml_coll_t clr(steer, _U(clear)); clr; ++clr) {
       std::string nam = clr.hasAttr(_U(name)) ? clr.attr<std::string>(_U(name)) : std::string();
       if ( nam.substr(0,6) == "elemen" )   {
@@ -1719,6 +1816,8 @@ template <> void Converter<Compact>::operator()(xml_h element) const {
     }
   }
 
+  enclosing_threads = build_threads;
+
   if ( s_debug.materials || s_debug.elements )   {
     printout(INFO,"Compact","+++ UNIT System:");
     printout(INFO,"Compact","+++ Density:    %8.3g  Units:%8.3g",
@@ -1775,10 +1874,25 @@ template <> void Converter<Compact>::operator()(xml_h element) const {
   xml_coll_t(compact, _U(readouts)).for_each(_U(readout), Converter<Readout>(description));
 
   printout(DEBUG, "Compact", "++ Converting included files with subdetector structures...");
-  xml_coll_t(compact, _U(detectors)).for_each(_U(include), Converter<DetElementInclude>(description));
+  if ( build_threads > 1 )  {
+    std::vector<xml_h> includes;
+    for( xml_coll_t dets(compact, _U(detectors)); dets; ++dets )
+      for( xml_coll_t inc(dets, _U(include)); inc; ++inc ) includes.emplace_back(inc);
+    convert_includes(description, includes, build_threads);
+  }
+  else  {
+    xml_coll_t(compact, _U(detectors)).for_each(_U(include), Converter<DetElementInclude>(description));
+  }
   printout(DEBUG, "Compact", "++ Converting detector structures...");
   xml_coll_t(compact, _U(detectors)).for_each(_U(detector), Converter<DetElement>(description));
-  xml_coll_t(compact, _U(include)).for_each(Converter<DetElementInclude>(this->description));
+  if ( build_threads > 1 )  {
+    std::vector<xml_h> includes;
+    for( xml_coll_t inc(compact, _U(include)); inc; ++inc ) includes.emplace_back(inc);
+    convert_includes(description, includes, build_threads);
+  }
+  else  {
+    xml_coll_t(compact, _U(include)).for_each(Converter<DetElementInclude>(this->description));
+  }
 
   xml_coll_t(compact, _U(includes)).for_each(_U(xml), Converter<XMLFile>(description));
   xml_coll_t(compact, _U(fields)).for_each(_U(field), Converter<CartesianField>(description));
@@ -1795,9 +1909,10 @@ template <> void Converter<Compact>::operator()(xml_h element) const {
     rb.execute();
   }
   /// Load plugin and process them as indicated
-  xml_coll_t(compact, _U(plugins)).for_each(_U(plugin),  Converter<Plugin>  (description));
-  xml_coll_t(compact, _U(plugins)).for_each(_U(include), Converter<XMLFile> (description));
-  xml_coll_t(compact, _U(plugins)).for_each(_U(xml),     Converter<XMLFile> (description));
+  if ( compact.hasChild(_U(plugins)) )   {
+    detail::GeometryCache::PluginSection section(description, compact);
+    load_CompactPlugins(description, compact);
+  }
 }
 
 #ifdef _WIN32
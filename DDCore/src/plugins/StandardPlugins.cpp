@@ -41,7 +41,9 @@
 
 // C/C++ include files
 #include <cerrno>
+#include <chrono>
 #include <cstdlib>
+#include <memory>
 #include <sstream>
 
 using namespace dd4hep;
@@ -720,6 +722,77 @@ static long load_compact(Detector& description, int argc, char** argv) {
 }
 DECLARE_APPLY(DD4hep_CompactLoader,load_compact)
 
+/// Benchmark the loading of compact files and the evaluation of their constants
+/**
+ *  Every repetition loads the compact files into a new detector description.
+ *  Afterwards all constants of the last description are evaluated 'evaluate'
+ *  times. Run the plugin once with and once without the environment variable
+ *  DD4HEP_EVALUATOR_NOCACHE to compare the timing with and without compiled
+ *  expressions (see the ClientTests_CompactLoadBenchmark tests).
+ *
+ *  Factory: DD4hep_CompactLoadBenchmark
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    01/04/2014
+ */
+static long benchmark_compact_load(Detector& /* description */, int argc, char** argv) {
+  using clock_t = std::chrono::steady_clock;
+  std::vector<std::string> inputs;
+  std::size_t repeat = 3, evaluate = 100;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      inputs.emplace_back(argv[++i]);
+    else if ( 0 == ::strncmp("-repeat",argv[i],4) )
+      repeat = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-evaluate",argv[i],4) )
+      evaluate = ::atol(argv[++i]);
+    else  {
+      std::cout <<
+        "Usage: -plugin DD4hep_CompactLoadBenchmark -arg [-arg]                   \n"
+        "     -input    <file>   Compact file to be loaded. Multiple are allowed  \n"
+        "     -repeat   <value>  Number of loads into new descriptions [3]        \n"
+        "     -evaluate <value>  Evaluations of all constants [100]               \n"
+        "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  if ( inputs.empty() )
+    except("CompactLoadBenchmark","+++ No compact input file given.");
+  const char* mode = ::getenv("DD4HEP_EVALUATOR_NOCACHE") ? "without" : "with";
+  std::unique_ptr<Detector> det;
+  double total = 0e0, first = 0e0;
+  for( std::size_t i = 0; i < repeat; ++i )  {
+    det = Detector::make_unique("CompactLoadBenchmark_"+std::to_string(i));
+    auto start = clock_t::now();
+    for( const auto& input : inputs )
+      det->fromCompact(input);
+    double secs = std::chrono::duration<double>(clock_t::now() - start).count();
+    printout(INFO,"CompactLoadBenchmark","+++ Load %3ld %s expression cache: %8.3f seconds",
+             long(i), mode, secs);
+    if ( i == 0 ) first = secs;
+    total += secs;
+  }
+  std::size_t count = 0;
+  auto start = clock_t::now();
+  for( std::size_t i = 0; det && i < evaluate; ++i )  {
+    for( const auto& c : det->constants() )   {
+      Constant constant(c.second);
+      if ( constant->dataType == "number" )  {
+        _toDouble(constant->GetTitle());
+        ++count;
+      }
+    }
+  }
+  double secs = std::chrono::duration<double>(clock_t::now() - start).count();
+  printout(ALWAYS,"CompactLoadBenchmark","+++ %s expression cache: first load %.3f s, "
+           "mean load %.3f s, %ld constant evaluations: %.3f us each",
+           mode, first, repeat ? total/double(repeat) : 0e0, long(count),
+           count ? 1e6*secs/double(count) : 0e0);
+  return 1;
+}
+DECLARE_APPLY(DD4hep_CompactLoadBenchmark,benchmark_compact_load)
+
 /// Basic entry point to process any XML document.
 /**
  *  - The file URI to be opened 
@@ -94,6 +94,54 @@ namespace dd4hep{
         throw std::runtime_error(" BitFieldElement: unknown name: " + name ) ;
     }
   
+    void BitFieldCoder::encode(const FieldID* values, size_t n, CellID* bitfields) const {
+
+      const size_t nf = _fields.size() ;
+      std::vector<BitFieldHandle> handles ;
+      handles.reserve( nf ) ;
+      for( const auto& f : _fields )
+        handles.emplace_back( f ) ;
+
+      // check all ranges first: no bit field is modified if a value is out of range
+      for( size_t j = 0 ; j < nf ; ++j ) {
+        const FieldID lo = _fields[j].minValue(), hi = _fields[j].maxValue() ;
+        int bad = 0 ;
+        for( size_t i = 0 ; i < n ; ++i ) {
+          const FieldID v = values[ i*nf + j ] ;
+          bad |= int( v < lo ) | int( v > hi ) ;
+        }
+        if( bad ) {
+          for( size_t i = 0 ; i < n ; ++i ) {
+            CellID dummy = 0 ;
+            handles[j].set( dummy, values[ i*nf + j ] ) ;
+          }
+        }
+      }
+      for( size_t i = 0 ; i < n ; ++i ) {
+        const FieldID* row = values + i*nf ;
+        CellID id = 0 ;
+        for( size_t j = 0 ; j < nf ; ++j )
+          id |= handles[j].bits( row[j] ) ;
+        bitfields[i] = id ;
+      }
+    }
+
+    void BitFieldCoder::decode(const CellID* bitfields, size_t n, FieldID* values) const {
+
+      const size_t nf = _fields.size() ;
+      std::vector<BitFieldHandle> handles ;
+      handles.reserve( nf ) ;
+      for( const auto& f : _fields )
+        handles.emplace_back( f ) ;
+
+      for( size_t i = 0 ; i < n ; ++i ) {
+        FieldID* row = values + i*nf ;
+        const CellID id = bitfields[i] ;
+        for( size_t j = 0 ; j < nf ; ++j )
+          row[j] = handles[j].value( id ) ;
+      }
+    }
+
     unsigned BitFieldCoder::highestBit() const {
     
       unsigned hb(0) ;
@@ -19,6 +19,26 @@ namespace dd4hep {
 
   namespace DDSegmentation {
 
+/// Cell ID identifier parameter resolving the field handles again when it is set
+/** The compact converter sets identifier_x and identifier_y through the
+ *  segmentation parameters after the segmentation was constructed.
+ */
+class CartesianGridXY::IdentifierParameter : public TypedSegmentationParameter<std::string> {
+	CartesianGridXY* _segmentation;
+public:
+	/// Initializing constructor
+	IdentifierParameter(CartesianGridXY* seg, const std::string& nam, const std::string& desc,
+	                    std::string& ident, const std::string& defaultVal) :
+		TypedSegmentationParameter<std::string>(nam, desc, ident, defaultVal, SegmentationParameter::NoUnit, true),
+		_segmentation(seg) {
+	}
+	/// Set the parameter value in string representation
+	virtual void setValue(const std::string& val) override {
+		this->TypedSegmentationParameter<std::string>::setValue(val);
+		_segmentation->updateFieldHandles();
+	}
+};
+
 /// default constructor using an encoding string
 CartesianGridXY::CartesianGridXY(const std::string& cellEncoding) :
 		CartesianGrid(cellEncoding) {
@@ -31,8 +51,9 @@ CartesianGridXY::CartesianGridXY(const std::string& cellEncoding) :
 	registerParameter("grid_size_y", "Cell size in Y",   _gridSizeY, 1., SegmentationParameter::LengthUnit);
 	registerParameter("offset_x",    "Cell offset in X", _offsetX,   0., SegmentationParameter::LengthUnit, true);
 	registerParameter("offset_y",    "Cell offset in Y", _offsetY,   0., SegmentationParameter::LengthUnit, true);
-	registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
-	registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
+	registerFieldIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
+	registerFieldIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
+	updateFieldHandles();
 }
 
 /// Default constructor used by derived classes passing an existing decoder
@@ -48,8 +69,9 @@ CartesianGridXY::CartesianGridXY(const BitFieldCoder* decode) :
 	registerParameter("grid_size_y", "Cell size in Y",   _gridSizeY, 1., SegmentationParameter::LengthUnit);
 	registerParameter("offset_x",    "Cell offset in X", _offsetX,   0., SegmentationParameter::LengthUnit, true);
 	registerParameter("offset_y",    "Cell offset in Y", _offsetY,   0., SegmentationParameter::LengthUnit, true);
-	registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
-	registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
+	registerFieldIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
+	registerFieldIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
+	updateFieldHandles();
 }
 
 /// destructor
@@ -57,9 +79,39 @@ CartesianGridXY::~CartesianGridXY() {
 
 }
 
+/// Set the underlying decoder and resolve the field handles of X and Y
+void CartesianGridXY::setDecoder(const BitFieldCoder* newDecoder) {
+	this->Segmentation::setDecoder(newDecoder);
+	updateFieldHandles();
+}
+
+/// Register a cell ID identifier, which resolves the field handles again when it is set
+void CartesianGridXY::registerFieldIdentifier(const std::string& nam, const std::string& desc,
+                                              std::string& ident, const std::string& defaultVal) {
+	StringParameter idParameter = new IdentifierParameter(this, nam, desc, ident, defaultVal);
+	_parameters[nam]       = idParameter;
+	_indexIdentifiers[nam] = idParameter;
+}
+
+/// Resolve the field handles of X and Y from the decoder
+void CartesianGridXY::updateFieldHandles() {
+	_fields = FieldHandles();
+	if ( _decoder ) {
+		for( const auto& f : _decoder->fields() ) {
+			if ( f.name() == _xId ) _fields.x = BitFieldHandle(f);
+			if ( f.name() == _yId ) _fields.y = BitFieldHandle(f);
+		}
+	}
+}
+
 /// determine the position based on the cell ID
 Vector3D CartesianGridXY::position(const CellID& cID) const {
 	Vector3D cellPosition;
+	if ( _fields.x.isValid() && _fields.y.isValid() ) {
+		cellPosition.X = binToPosition( _fields.x.value(cID), _gridSizeX, _offsetX);
+		cellPosition.Y = binToPosition( _fields.y.value(cID), _gridSizeY, _offsetY);
+		return cellPosition;
+	}
 	cellPosition.X = binToPosition( _decoder->get(cID,_xId ), _gridSizeX, _offsetX);
 	cellPosition.Y = binToPosition( _decoder->get(cID,_yId ), _gridSizeY, _offsetY);
 	return cellPosition;
@@ -70,6 +122,11 @@ CellID CartesianGridXY::cellID(const Vector3D& localPosition,
                                const Vector3D& /* globalPosition */,
                                const VolumeID& vID) const {
   CellID cID = vID;
+	if ( _fields.x.isValid() && _fields.y.isValid() ) {
+		_fields.x.set( cID, positionToBin(localPosition.X, _gridSizeX, _offsetX) );
+		_fields.y.set( cID, positionToBin(localPosition.Y, _gridSizeY, _offsetY) );
+		return cID;
+	}
 	_decoder->set( cID,_xId, positionToBin(localPosition.X, _gridSizeX, _offsetX) );
 	_decoder->set( cID,_yId, positionToBin(localPosition.Y, _gridSizeY, _offsetY) );
 	return cID;
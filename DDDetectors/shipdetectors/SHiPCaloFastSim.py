@@ -0,0 +1,364 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#
+import os
+import sys
+import math
+import time
+import logging
+import argparse
+#
+#
+"""
+
+   Fast shower parametrisation of the SHiP SplitCal (and HCAL) with the
+   Geant4SamplingCaloShowerModel or a frozen shower library (Geant4ShowerLibraryModel)
+   and its validation against full simulation.
+
+   Simulate (full simulation unless -fast or -library is given):
+     python SHiPCaloFastSim.py -batch -events 100 -particle e- -energy 30 -output full [-fast] [-hadronic]
+     python SHiPCaloFastSim.py -batch -events 100 -particle e- -energy 30 -output frozen -library SplitCal.lib
+
+   Generate a shower library for the SplitCal with full simulation (single threaded):
+     python SHiPCaloFastSim.py -batch -events 20000 -particle e- -generate SplitCal.lib
+
+   Fit the longitudinal profile parameters to a full simulation sample:
+     python SHiPCaloFastSim.py -fit full.root -particle e- -energy 30
+
+   Compare CPU per event, response and energy profiles:
+     python SHiPCaloFastSim.py -compare full.root fast.root
+
+   Model parameters may be overridden from the command line, e.g. -TmaxOffset=-0.5
+
+   @author  M.Frank
+   @version 1.0
+
+"""
+
+logger = logging.getLogger(__name__)
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+
+# Effective values for the SplitCal layer sequence (1 cm PVT bars + 2.8 mm lead)
+# Starting values: refine with -fit and -compare.
+EM_MODEL = {
+    'RadiationLength': 24.4,     # mm
+    'MoliereRadius': 46.5,       # mm
+    'CriticalEnergy': 11.1,      # MeV
+    'TmaxSlope': 1.0,
+    'TmaxOffset': -0.858,
+    'AlphaSlope': 0.492,
+    'AlphaOffset': 0.21,
+    'CoreRadius': 0.3,
+    'TailRadius': 1.5,
+    'CoreFraction': 0.85,
+    'NumberOfSpots': 200,
+    'VisibleEnergyScale': 1.0,
+}
+# Effective values for the HCAL layer sequence (1 cm PVT bars + 17 cm iron)
+HAD_MODEL = {
+    'InteractionLength': 175.0,  # mm
+    'TmaxSlope': 0.2,
+    'TmaxOffset': 0.7,
+    'AlphaSlope': 0.0,
+    'AlphaOffset': 2.0,
+    'CoreRadius': 0.1,
+    'TailRadius': 0.5,
+    'CoreFraction': 0.7,
+    'NumberOfSpots': 200,
+    'VisibleEnergyScale': 1.0,
+}
+# Binning of the SplitCal shower library: the depth is the position within a layer
+SHOWER_LIBRARY = {
+    'EnergyMin': 10.0,           # MeV
+    'EnergyMax': 2000.0,         # MeV
+    'EnergyBins': 12,
+    'ThetaMax': math.pi,
+    'ThetaBins': 6,
+    'DepthMin': 0.0,             # mm
+    'DepthMax': 12.8,            # mm
+    'DepthBins': 4,
+    'DepthPeriod': 12.8,         # mm: 1 cm PVT bars + 2.8 mm lead
+    'SpotSize': 1.0,             # mm
+}
+# z position of the front face of the SplitCal (gun at z=-110 cm, see README.ship)
+CALO_FRONT_Z = -850.0  # mm
+PROFILE_BIN = 25.0     # mm
+
+
+def cpu_file(output):
+  return output[:-5] + '.cpu' if output.endswith('.root') else output + '.cpu'
+
+
+def model_parameters(args, defaults):
+  params = dict(defaults)
+  for key in params.keys():
+    value = getattr(args, key, None)
+    if value is not None:
+      params[key] = type(params[key])(value)
+  return params
+
+
+def parse_arguments():
+  """
+  Options without value and unknown options are errors. Negative values are
+  accepted as -TmaxOffset -0.5 or -TmaxOffset=-0.5
+  """
+  parser = argparse.ArgumentParser(description='Fast shower parametrisation of the SHiP SplitCal and HCAL',
+                                   allow_abbrev=False)
+  parser.add_argument('-batch', action='store_true', help='Run without interactive UI')
+  parser.add_argument('-events', type=int, default=10, help='Number of events to simulate')
+  parser.add_argument('-particle', default='e-', help='Particle type of the gun')
+  parser.add_argument('-energy', type=float, default=30.0, help='Energy of the gun [GeV]')
+  parser.add_argument('-output', default=None, help='Output file name')
+  parser.add_argument('-fast', action='store_true', help='Use the parametrised shower model')
+  parser.add_argument('-hadronic', action='store_true', help='Use the parametrised shower model in the HCAL too')
+  parser.add_argument('-library', default=None, help='Use the frozen showers of this shower library')
+  parser.add_argument('-generate', default=None, help='Generate a shower library with this name')
+  parser.add_argument('-fit', default=None, metavar='FILE', help='Fit the profile of a full simulation sample')
+  parser.add_argument('-compare', nargs=2, default=None, metavar=('FULL', 'FAST'),
+                      help='Compare a full and a fast simulation sample')
+  for key in sorted(set(EM_MODEL) | set(HAD_MODEL)):
+    parser.add_argument('-' + key, type=float, default=None, help='Override the shower model parameter ' + key)
+  return parser.parse_args()
+
+
+def simulate(args):
+  import DDG4
+  from DDG4 import OutputLevel as Output
+  from g4units import GeV, MeV, mm, cm
+
+  kernel = DDG4.Kernel()
+  here = os.path.dirname(os.path.abspath(__file__))
+  kernel.loadGeometry(str('file:' + os.path.join(here, 'SHiPCalo.xml')))
+  DDG4.importConstants(kernel.detectorDescription(), debug=False)
+  geant4 = DDG4.Geant4(kernel, calo='Geant4ScintillatorCalorimeterAction')
+  # Without UI the kernel processes NumEvents events and exits
+  if not args.batch:
+    geant4.setupCshUI()
+  geant4.setupTrackingField(prt=False)
+
+  seq, act = geant4.addDetectorConstruction('Geant4DetectorGeometryConstruction/ConstructGeo')
+  sensitives = DDG4.DetectorConstruction(kernel, str('Geant4DetectorSensitivesConstruction/ConstructSD'))
+  seq.adopt(sensitives)
+
+  fast_particles = []
+  if args.library:
+    lib = DDG4.DetectorConstruction(kernel, str('Geant4ShowerLibraryModel/SplitCalShowerLibrary'))
+    lib.RegionName = 'SplitCalRegion'
+    lib.LibraryFile = args.library
+    lib.Etrigger = {p: SHOWER_LIBRARY['EnergyMin'] * MeV for p in ('e+', 'e-', 'gamma')}
+    lib.Enable = True
+    lib.enableUI()
+    seq.adopt(lib)
+    fast_particles += ['e+', 'e-', 'gamma']
+  elif args.fast:
+    em = DDG4.DetectorConstruction(kernel, str('Geant4SamplingCaloShowerModel/SplitCalEMShowerModel'))
+    em.RegionName = 'SplitCalRegion'
+    em.ApplicableParticles = ['e+', 'e-', 'gamma']
+    em.Etrigger = {'e+': 0.5 * GeV, 'e-': 0.5 * GeV, 'gamma': 0.5 * GeV}
+    em.Enable = True
+    for key, value in model_parameters(args, EM_MODEL).items():
+      scale = mm if key in ('RadiationLength', 'MoliereRadius') else MeV if key == 'CriticalEnergy' else 1
+      setattr(em, key, value * scale)
+    em.enableUI()
+    seq.adopt(em)
+    fast_particles += em.ApplicableParticles
+    if args.hadronic:
+      had = DDG4.DetectorConstruction(kernel, str('Geant4SamplingCaloShowerModel/HCALHadronShowerModel'))
+      had.RegionName = 'HCALRegion'
+      had.ApplicableParticles = ['pi+', 'pi-', 'kaon+', 'kaon-', 'proton', 'neutron']
+      had.Etrigger = {p: 2 * GeV for p in had.ApplicableParticles}
+      had.Hadronic = True
+      had.Enable = True
+      for key, value in model_parameters(args, HAD_MODEL).items():
+        setattr(had, key, value * (mm if key == 'InteractionLength' else 1))
+      had.enableUI()
+      seq.adopt(had)
+      fast_particles += had.ApplicableParticles
+
+  fast = args.fast or args.library
+  output = args.output or ('SHiPCalo_' + ('fast' if fast else 'full'))
+  if not output.endswith('.root'):
+    output = output + '.root'
+  geant4.setupROOTOutput('RootOutput', output, mc_truth=False)
+
+  if args.generate:
+    # Isotropic primaries of the library energy range, smeared over the first layers
+    gen = DDG4.GeneratorAction(kernel, str('Geant4GeneratorActionInit/GenerationInit'))
+    kernel.generatorAction().adopt(gen)
+    gen = DDG4.GeneratorAction(kernel, str('Geant4IsotropeGenerator/LibraryPrimaries'))
+    gen.Mask = 1
+    gen.Particle = args.particle
+    gen.MomentumMin = SHOWER_LIBRARY['EnergyMin'] * MeV
+    gen.MomentumMax = SHOWER_LIBRARY['EnergyMax'] * MeV
+    gen.ThetaMax = SHOWER_LIBRARY['ThetaMax']
+    gen.Position = (0.0, 0.0, CALO_FRONT_Z * mm + 20 * cm)
+    gen.Multiplicity = 1
+    kernel.generatorAction().adopt(gen)
+    gen = DDG4.GeneratorAction(kernel, str('Geant4InteractionVertexSmear/LibrarySmear'))
+    gen.Mask = 1
+    gen.Sigma = (5 * cm, 5 * cm, 5 * cm, 0.0)
+    kernel.generatorAction().adopt(gen)
+    gen = DDG4.GeneratorAction(kernel, str('Geant4InteractionMerger/InteractionMerger'))
+    kernel.generatorAction().adopt(gen)
+    gen = DDG4.GeneratorAction(kernel, str('Geant4PrimaryHandler/PrimaryHandler'))
+    kernel.generatorAction().adopt(gen)
+
+    writer = DDG4.SteppingAction(kernel, str('Geant4ShowerLibraryWriter/SplitCalLibraryWriter'))
+    writer.RegionName = 'SplitCalRegion'
+    writer.OutputFile = args.generate
+    for key, value in SHOWER_LIBRARY.items():
+      unit = MeV if key.startswith('Energy') and key != 'EnergyBins' else mm if key.startswith(('Depth', 'Spot')) else 1
+      setattr(writer, key, value if key.endswith('Bins') else value * unit)
+    writer.enableUI()
+    kernel.steppingAction().adopt(writer)
+  else:
+    gun = geant4.setupGun('Gun', particle=args.particle, energy=args.energy * GeV,
+                          isotrop=False, multiplicity=1, position=(0.0, 0.0, -110.0 * cm), direction=(0.0, 0.0, 1.0))
+    gun.OutputLevel = Output.WARNING
+
+  for det in ('SplitCalTest_SLayer_0', 'HCAL_module'):
+    if kernel.detectorDescription().sensitiveDetector(det).isValid():
+      geant4.setupCalorimeter(det)
+
+  phys = geant4.setupPhysics('FTFP_BERT')
+  if fast_particles:
+    ph = DDG4.PhysicsList(kernel, str('Geant4FastPhysics/FastPhysicsList'))
+    ph.EnabledParticles = fast_particles
+    ph.enableUI()
+    phys.adopt(ph)
+
+  num_events = args.events
+  kernel.NumEvents = num_events
+  kernel.configure()
+  kernel.initialize()
+  start = time.process_time()
+  kernel.run()
+  cpu = time.process_time() - start
+  kernel.terminate()
+  logger.info('+++ %s simulation: %d events  CPU per event: %.4f s', 'Fast' if fast else 'Full',
+              num_events, cpu / num_events)
+  with open(cpu_file(output), 'w') as f:
+    f.write('%d %f\n' % (num_events, cpu))
+
+
+def read_showers(file_name, collection='SplitCalHits'):
+  """
+  Energy sum, longitudinal (z from the calorimeter front) and radial profiles per event.
+  """
+  import ROOT
+  ROOT.gSystem.Load('libDDG4IO')
+  ROOT.gInterpreter.GenerateDictionary('vector<dd4hep::sim::Geant4Calorimeter::Hit*>',
+                                       'vector;DD4hep/Objects.h;DDG4/Geant4Data.h')
+  f = ROOT.TFile.Open(file_name)
+  if not f or f.IsZombie():
+    logger.error('+++ Cannot open file %s', file_name)
+    sys.exit(1)
+  tree = f.Get('EVENT')
+  showers = []
+  for event in tree:
+    hits = getattr(event, collection)
+    total = 0.0
+    longitudinal = {}
+    radial = {}
+    for hit in hits:
+      e = hit.energyDeposit
+      pos = hit.position
+      total += e
+      iz = int((pos.z() - CALO_FRONT_Z) // PROFILE_BIN)
+      ir = int(math.hypot(pos.x(), pos.y()) // PROFILE_BIN)
+      longitudinal[iz] = longitudinal.get(iz, 0.0) + e
+      radial[ir] = radial.get(ir, 0.0) + e
+    showers.append((total, longitudinal, radial))
+  f.Close()
+  return showers
+
+
+def summary(showers):
+  n = float(max(len(showers), 1))
+  energies = [s[0] for s in showers]
+  mean = sum(energies) / n
+  rms = math.sqrt(max(sum((e - mean)**2 for e in energies) / n, 0.0))
+  profiles = []
+  for idx in (1, 2):
+    prof = {}
+    for s in showers:
+      norm = s[0] if s[0] > 0.0 else 1.0
+      for b, e in s[idx].items():
+        prof[b] = prof.get(b, 0.0) + e / norm / n
+    profiles.append(prof)
+  return mean, rms, profiles[0], profiles[1]
+
+
+def fit(args):
+  """
+  Method of moments for the Gamma shaped longitudinal profile of the full simulation
+  """
+  import g4units
+  showers = read_showers(args.fit)
+  _, _, longitudinal, _ = summary(showers)
+  x0 = args.RadiationLength or EM_MODEL['RadiationLength']
+  ec = args.CriticalEnergy or EM_MODEL['CriticalEnergy']
+  t = [((b + 0.5) * PROFILE_BIN / x0, w) for b, w in longitudinal.items() if b >= 0]
+  norm = sum(w for _, w in t)
+  mean = sum(x * w for x, w in t) / norm
+  var = sum((x - mean)**2 * w for x, w in t) / norm
+  alpha = mean * mean / var
+  beta = mean / var
+  tmax = (alpha - 1.0) / beta
+  ln_y = math.log(args.energy * g4units.GeV / (ec * g4units.MeV))
+  logger.info('+++ Longitudinal profile: <t>=%.3f X0 alpha=%.3f beta=%.3f Tmax=%.3f X0', mean, alpha, beta, tmax)
+  logger.info('+++ Fitted offsets for the default slopes:  -TmaxOffset=%.4f -AlphaOffset=%.4f',
+              tmax - EM_MODEL['TmaxSlope'] * ln_y, alpha - EM_MODEL['AlphaSlope'] * ln_y)
+
+
+def compare(full_name, fast_name):
+  cpu = []
+  for name in (full_name, fast_name):
+    try:
+      with open(cpu_file(name)) as f:
+        n, t = f.read().split()
+        cpu.append(float(t) / float(n))
+    except (IOError, ValueError):
+      cpu.append(None)
+  full = summary(read_showers(full_name))
+  fast = summary(read_showers(fast_name))
+  if cpu[0] and cpu[1]:
+    logger.info('+++ CPU per event:   full %10.4f s   fast %10.4f s   speedup %8.1f', cpu[0], cpu[1], cpu[0] / cpu[1])
+  logger.info('+++ Visible energy:  full %10.2f +- %8.2f MeV   fast %10.2f +- %8.2f MeV',
+              full[0], full[1], fast[0], fast[1])
+  if fast[0] > 0.0:
+    logger.info('+++ Multiply VisibleEnergyScale by %.4f to match the full simulation response', full[0] / fast[0])
+  chi2 = 0.0
+  for title, idx in (('Longitudinal', 2), ('Radial', 3)):
+    bins = sorted(set(full[idx].keys()) | set(fast[idx].keys()))
+    logger.info('+++ %s profile [fraction of the visible energy per %.0f mm]:', title, PROFILE_BIN)
+    for b in bins:
+      f1, f2 = full[idx].get(b, 0.0), fast[idx].get(b, 0.0)
+      chi2 += (f1 - f2)**2
+      if f1 > 1e-3 or f2 > 1e-3:
+        logger.info('    %8.0f mm   full %8.4f   fast %8.4f', b * PROFILE_BIN, f1, f2)
+  logger.info('+++ Sum of squared profile differences: %.6f', chi2)
+
+
+def run():
+  args = parse_arguments()
+  if args.compare:
+    compare(args.compare[0], args.compare[1])
+  elif args.fit:
+    fit(args)
+  else:
+    simulate(args)
+
+
+if __name__ == "__main__":
+  run()
@@ -69,6 +69,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
   small_layer_vol.setVisAttributes(description.visAttributes("VisibleGray"));
   
   printout(INFO, "SHiP_HPL_Fibre_Trackers", "%s: Layer:   nx: %7d nz: %7d delta: %7.3f", nam.c_str(), num_x, num_z, delta);
+  DetElement   sdet  (nam, x_det.id());
  //Big layer creation
   Rotation3D rot(RotationZYX(0e0, 0e0, M_PI/2e0));
   for( int ix=0; ix < num_x; ++ix )  {
@@ -90,16 +91,20 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
     	double z = -box.z() + (double(iz)+0.5) * (2.0*tol + delta);
     	PlacedVolume pv = box_vol.placeVolume(big_layer_vol, Position(0e0, 0e0, z));
     	pv.addPhysVolID("big_layer", iz);
+    	// one detector element per fibre layer to carry the measurement surface
+    	DetElement layer(sdet, _toString(iz,"layer%d"), iz);
+    	layer.setPlacement(pv);
     }
     else{
     	double z = -box.z() + (double(iz)+0.5) * (2.0*tol + delta);
     	PlacedVolume pv = box_vol.placeVolume(small_layer_vol, Position(0e0, 0e0, z));
     	pv.addPhysVolID("small_layer", iz);
+    	DetElement layer(sdet, _toString(iz,"layer%d"), iz);
+    	layer.setPlacement(pv);
     }
   }
   printout(INFO, "SHiP_HPL_Fibre_Trackers", "%s: Created %d layers of %d fibres each.", nam.c_str(), num_z, num_x);
   
-  DetElement   sdet  (nam, x_det.id());
   Volume       mother(description.pickMotherVolume(sdet));
   Rotation3D   rot3D (RotationZYX(x_rot.z(0), x_rot.y(0), x_rot.x(0)));
   Transform3D  trafo (rot3D, Position(x_pos.x(0), x_pos.y(0), x_pos.z(0)));
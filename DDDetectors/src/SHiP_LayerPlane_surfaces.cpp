@@ -0,0 +1,144 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+//
+// Measurement surfaces for the layered SHiP bar and fibre detectors
+// (SplitCal, SHiP_HPL_Fibre_Tracker).
+//
+// Every layer detector element with sensitive bars or fibres gets one planar
+// surface in the local frame of the layer box: u across the bars/fibres,
+// n along the layer z-axis. The orientation of the individual layers is
+// taken from their placements. In addition a flat table of all planes in
+// world coordinates (LayerPlaneData) is attached to the subdetector.
+//
+//==========================================================================
+
+namespace {
+  struct UserData {
+    int dimension{1} ;
+    int samples{16} ;
+  };
+}
+
+// Framework include files
+#define SURFACEINSTALLER_DATA UserData
+#define DD4HEP_USE_SURFACEINSTALL_HELPER DD4hep_SHiP_LayerPlaneSurfacePlugin
+#include "DD4hep/Printout.h"
+#include "DD4hep/SurfaceInstaller.h"
+#include "DDRec/DetectorData.h"
+#include "DDRec/MaterialManager.h"
+
+#include <algorithm>
+
+namespace{
+
+  /// Check if the volume contains sensitive volumes up to the given depth
+  bool hasSensitive(dd4hep::Volume vol, int depth)  {
+    if ( vol.isSensitive() ) return true;
+    if ( depth <= 0 ) return false;
+    for( Int_t i = 0, n = vol->GetNdaughters(); i < n; ++i )  {
+      if ( hasSensitive(vol->GetNode(i)->GetVolume(), depth-1) ) return true;
+    }
+    return false;
+  }
+
+  template <> void Installer<UserData>::handle_arguments(int argc, char** argv)   {
+    for(int i=0; i<argc; ++i)  {
+      char* ptr = ::strchr(argv[i],'=');
+      if ( ptr )  {
+        std::string name( argv[i] , ptr ) ;
+        double value = dd4hep::_toDouble(++ptr);
+        printout(dd4hep::DEBUG,"DD4hep_SHiP_LayerPlaneSurfacePlugin", "argument[%d] = %s = %f" , i, name.c_str() , value  ) ;
+        if(      name=="dimension" ) data.dimension = value ;
+        else if( name=="samples"   ) data.samples   = value ;
+        else {
+          printout(dd4hep::WARNING,"DD4hep_SHiP_LayerPlaneSurfacePlugin", "unknown parameter:  %s ", name.c_str() ) ;
+        }
+      }
+    }
+  }
+
+  /// Install measurement surfaces
+  template <typename UserData>
+    void Installer<UserData>::install(dd4hep::DetElement component, dd4hep::PlacedVolume pv)   {
+    using namespace dd4hep::rec;
+    if ( component == m_det ) return;
+    dd4hep::Volume comp_vol = pv.volume();
+    /// Layer boxes hold the bars (depth 1) or the fibres with their sensitive core (depth 2)
+    if ( !hasSensitive(comp_vol, 2) ) return;
+
+    dd4hep::Box comp_shape(comp_vol.solid());
+    if ( !checkShape(comp_shape) ) return;
+
+    const double half_thickness = comp_shape->GetDZ();
+    if ( !handleUsingCache(component,comp_vol) )  {
+      //Surface is placed at the center of the layer box, u measures across the bars/fibres
+      Vector3D u(1.,0.,0.), v(0.,1.,0.), n(0.,0.,1.), o(0.,0.,0.);
+      Type type( Type::Sensitive ) ;
+      if( data.dimension == 1 ) {
+        type.setProperty( Type::Measurement1D , true ) ;
+      } else if( data.dimension != 2 ) {
+        throw std::runtime_error("**** DD4hep_SHiP_LayerPlaneSurfacePlugin: no or wrong "
+                                 "'dimension' argument given - has to be 1 or 2") ;
+      }
+      VolPlane surf(comp_vol, type, half_thickness, half_thickness, u, v, n, o);
+      addSurface(component,surf);
+    }
+
+    /// Fill the plane table of the subdetector in world coordinates
+    LayerPlaneData* table = m_det.extension<LayerPlaneData>(false);
+    if ( !table )  {
+      table = new LayerPlaneData();
+      m_det.addExtension<LayerPlaneData>(table);
+    }
+    const TGeoHMatrix& wm = component.nominal().worldTransformation();
+    const double* rot = wm.GetRotationMatrix();
+    const double* tr  = wm.GetTranslation();
+    LayerPlaneStruct::LayerPlane plane;
+    dd4hep::DetElement parent = component.parent();
+    plane.layerID   = component.id();
+    plane.parentID  = parent == m_det ? -1 : parent.id();
+    plane.thickness = 2e0 * half_thickness;
+    for( int i = 0; i < 3; ++i )  {
+      plane.origin[i] = tr[i];
+      plane.u[i]      = rot[3*i];
+      plane.v[i]      = rot[3*i+1];
+      plane.normal[i] = rot[3*i+2];
+    }
+    plane.zPosition = plane.origin[2];
+
+    /// Average X0 from straight traversals along the normal across the central part of the layer
+    MaterialManager matMgr( m_detDesc.worldVolume() ) ;
+    Vector3D org(plane.origin), nrm(plane.normal), du(plane.u);
+    const int    nsamples = std::max(1, data.samples);
+    const double width    = 0.8 * 2e0 * comp_shape->GetDX();
+    double       sum_x0   = 0e0;
+    for( int k = 0; k < nsamples; ++k )  {
+      Vector3D p = org + ( (double(k)+0.5)/double(nsamples) - 0.5 ) * width * du;
+      const MaterialVec& mats = matMgr.materialsBetween(p - half_thickness * nrm, p + half_thickness * nrm);
+      for( const auto& m : mats )
+        sum_x0 += m.second / m.first.radLength();
+    }
+    sum_x0 /= double(nsamples);
+    plane.radiationLength = sum_x0 > 0e0 ? plane.thickness / sum_x0 : 0e0;
+
+    auto& planes = table->planes;
+    auto  where  = std::upper_bound(planes.begin(), planes.end(), plane.zPosition,
+                                    [](double z, const LayerPlaneStruct::LayerPlane& p) { return z < p.zPosition; });
+    planes.insert(where, plane);
+    printout(dd4hep::DEBUG,"DD4hep_SHiP_LayerPlaneSurfacePlugin",
+             "+++ %s: layer %d [parent %d] at z=%g thickness=%g X0=%g",
+             component.path().c_str(), plane.layerID, plane.parentID,
+             plane.zPosition, plane.thickness, plane.radiationLength);
+  }
+
+}// namespace
@@ -14,6 +14,7 @@
 #include <DD4hep/DD4hepUnits.h>
 #include <DD4hep/Printout.h>
 #include <iostream>
+#include <vector>
 using namespace dd4hep;
 
 static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector sens)  {
@@ -28,6 +29,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
   xml_det_t    x_passive_layer = x_det.child(_Unicode(passive_layer));
   xml_det_t    x_split = x_det.child(_Unicode(split));
   std::string  nam     = x_det.nameStr();
+  DetElement   sdet  (nam, x_det.id());
   //vertical bars by default
 //  const double splitlayer   =  x_det.attr<int>("splitlayer");
   const double widebar_x_spacing   =  x_widebar.attr<double>("x_extra_spacing");
@@ -169,6 +171,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
 
 
   int hplvolumecode =0; 
+  std::vector<PlacedVolume> hpl_layers;
  //Build HPL layers
  
   Rotation3D hplrot(RotationZYX(0e0, 0e0, M_PI/2e0));
@@ -194,11 +197,13 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
         double z = -hplbox.z() + (double(iz)+0.5) * (2.0*tol + hpldelta);
         PlacedVolume hplpv = hplbox_vol.placeVolume(hplbig_layer_vol, Position(0e0, 0e0, z));
         hplpv.addPhysVolID("splitcal_hpl_layer", iz);
+        hpl_layers.push_back(hplpv);
     }
     else{
         double z = -hplbox.z() + (double(iz)+0.5) * (2.0*tol + hpldelta);
         PlacedVolume hplpv = hplbox_vol.placeVolume(hplsmall_layer_vol, Position(0e0, 0e0, z));
         hplpv.addPhysVolID("splitcal_hpl_layer", iz);
+        hpl_layers.push_back(hplpv);
     }
   }
 
@@ -208,6 +213,17 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
   double z_layer = -x_detbox.z()/2.;
   Rotation3D rot_layers;
 
+  // One detector element per active layer to carry the measurement surfaces.
+  // HPL modules get one child per fibre layer.
+  auto add_layer = [&sdet, &hpl_layers](PlacedVolume pv, int iz, bool hpl)  {
+    DetElement layer(sdet, _toString(iz,"layer%d"), iz);
+    layer.setPlacement(pv);
+    for( std::size_t k = 0; hpl && k < hpl_layers.size(); ++k )  {
+      DetElement fibre_layer(layer, _toString(int(k),"hpl_layer%d"), int(k));
+      fibre_layer.setPlacement(hpl_layers[k]);
+    }
+  };
+
 
   for( int iz=0; iz < num_z; ++iz )  {
     // leave 'tol' space between the layers
@@ -222,6 +238,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
 	    	rot_layers = RotationZYX(M_PI/2e0,0e0,0e0);
     	    	PlacedVolume pv_det = detbox_vol.placeVolume(det_wide_layerbox_vol, Transform3D(rot_layers,Position(0.,0. , z_layer)));
     	    	pv_det.addPhysVolID("splitcal_layer", iz);
+    	    	add_layer(pv_det, iz, false);
     		//z_layer += x_widebar.z()+x_passive_layer.z();
     		z_layer += x_widebar.z()/2.;
    		break;
@@ -232,6 +249,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
 		rot_layers = RotationZYX(0e0, 0e0, 0e0);
     		PlacedVolume pv_det = detbox_vol.placeVolume(det_wide_layerbox_vol, Transform3D(rot_layers,Position(0.,0., z_layer)));
         	pv_det.addPhysVolID("splitcal_layer", iz);
+        	add_layer(pv_det, iz, false);
     		//z_layer += x_widebar.z()+x_passive_layer.z();
     		z_layer += x_widebar.z()/2.;
 	  	break; 
@@ -242,6 +260,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
 	    	rot_layers = RotationZYX(M_PI/2e0,0e0,0e0);
     	    	PlacedVolume pv_det = detbox_vol.placeVolume(det_thin_layerbox_vol, Transform3D(rot_layers,Position(0.,0. , z_layer)));
     	    	pv_det.addPhysVolID("splitcal_layer", iz);
+    	    	add_layer(pv_det, iz, false);
     		z_layer += x_thinbar.z()/2.;
     		//z_layer += x_thinbar.z()+x_passive_layer.z();
    		break;
@@ -252,6 +271,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
 		rot_layers = RotationZYX(0e0, 0e0, 0e0);
     		PlacedVolume pv_det = detbox_vol.placeVolume(det_thin_layerbox_vol, Transform3D(rot_layers,Position(0.,0. , z_layer)));
         	pv_det.addPhysVolID("splitcal_layer", iz);
+        	add_layer(pv_det, iz, false);
     		z_layer += x_thinbar.z()/2.;
     		//z_layer += x_thinbar.z()+x_passive_layer.z();
 		break;
@@ -262,6 +282,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
 	    	rot_layers = RotationZYX(M_PI/2e0,0e0,0e0);
     		PlacedVolume pv_det = detbox_vol.placeVolume(hplbox_vol, Transform3D(rot_layers,Position(0.,0. , z_layer)));
         	pv_det.addPhysVolID("splitcal_layer", iz);
+        	add_layer(pv_det, iz, true);
     		z_layer += x_hplbox.z()/2.;
 		break;
 		   }
@@ -271,6 +292,7 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
 	    	rot_layers = RotationZYX(0e0,0e0,0e0);
     		PlacedVolume pv_det = detbox_vol.placeVolume(hplbox_vol, Transform3D(rot_layers,Position(0.,0., z_layer)));
         	pv_det.addPhysVolID("splitcal_layer",iz);
+        	add_layer(pv_det, iz, true);
     		z_layer += x_hplbox.z()/2.;
 		break;
 		   }
@@ -310,7 +332,6 @@ static Ref_t create_detector(Detector& description, xml_h e, SensitiveDetector s
   //PlacedVolume pv2 = detbox_vol.placeVolume(det_layerbox_vol, Transform3D(rot,Position(0e0, 0e0, 0e0)));
   //pv2.addPhysVolID("det_layerbox", 0e0);
   
-  DetElement   sdet  (nam, x_det.id());
   Volume       mother(description.pickMotherVolume(sdet));
   Rotation3D   rot3D (RotationZYX(x_rot.z(0), x_rot.y(0), x_rot.x(0)));
   Transform3D  trafo (rot3D, Position(x_pos.x(0), x_pos.y(0), x_pos.z(0)));
@@ -112,6 +112,8 @@ namespace dd4hep {
         const std::type_info& input_type()  const;
         /// String form of the input data type
         std::string input_type_name()  const;
+        /// Number of entries in the input container (0 if unknown)
+        std::size_t input_size()  const;
         /// Access input data by type
         template <typename DATA> DATA* get_input(bool exc=false);
         /// Access input data by type
@@ -32,6 +32,7 @@ namespace dd4hep {
 
     /// Forward declarations
     class DigiAction;
+    class DigiProfiler;
     class DigiActionSequence;
     
     /// Class, which allows all DigiAction derivatives to access the DDG4 kernel structures.
@@ -118,6 +119,8 @@ namespace dd4hep {
       std::size_t events_done()  const;
       /// Access current number of events processing (events in flight)
       std::size_t events_processing()  const;
+      /// Access to the action profiler. Returns NULL unless the property "profile" is set
+      DigiProfiler* profiler()  const;
 
       /// Register configure callback. Signature:   (function)()
       void register_configure(const std::function<void()>& callback)   const;
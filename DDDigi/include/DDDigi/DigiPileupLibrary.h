@@ -0,0 +1,113 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_DIGIPILEUPLIBRARY_H
+#define DDDIGI_DIGIPILEUPLIBRARY_H
+
+/// Framework include files
+#include <DDDigi/DigiEventAction.h>
+
+/// C/C++ include files
+#include <memory>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    // Forward declarations
+    class DigiInputAction;
+
+    /// Pre-sampled pile-up library to overlay background deposits
+    /**
+     *  Instead of re-reading background files for every signal event, a pool of
+     *  background events is loaded exactly once at initialization time using
+     *  any DigiInputAction (e.g. DigiDDG4ROOT) as a loader.
+     *  For every signal event a random subset of the pool is then copied into
+     *  the event with a common output mask:
+     *
+     *  - The number of overlaid interactions is either fixed or poisson distributed
+     *    around the mean multiplicity.
+     *  - Each overlaid interaction may be shifted in time by a random bunch crossing
+     *    and by a random interaction point (as done by DigiIPCreate/DigiIPMover).
+     *  - The history of the library deposits is dropped: it refers to records,
+     *    which are not part of the signal event.
+     *
+     *  The data are read-only once the library is loaded. Hence the action is
+     *  thread safe and the background I/O no longer scales with the number of
+     *  events times the pile-up multiplicity.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiPileupLibrary : public DigiEventAction   {
+    public:
+      class library_event_t;
+      using library_t = std::vector<std::unique_ptr<library_event_t> >;
+
+    protected:
+      /// Property: Type of the input action used to fill the library
+      std::string                m_loader_type      { "DigiDDG4ROOT" };
+      /// Property: Input data specification of the library
+      std::vector<std::string>   m_library_input    { };
+      /// Property: Container names to be loaded into the library
+      std::vector<std::string>   m_containers       { };
+      /// Property: Number of background events to be kept in the library
+      int                        m_library_size     { 100 };
+      /// Property: Output data segment name
+      std::string                m_output_segment   { "inputs" };
+      /// Property: Output mask of the overlaid containers
+      int                        m_output_mask      { 0x1 };
+      /// Property: Mean number of interactions overlaid per event
+      double                     m_multiplicity     { 1e0 };
+      /// Property: Draw the number of interactions from a poisson distribution
+      bool                       m_poisson          { true };
+      /// Property: Time spacing between two bunch crossings
+      double                     m_bunch_spacing    { 0e0 };
+      /// Property: Range of bunch crossings to sample from (inclusive)
+      std::vector<int>           m_bunch_range      { };
+      /// Property: Interaction point offset
+      Position                   m_offset_ip        { };
+      /// Property: Interaction point spread
+      Position                   m_sigma_ip         { };
+
+      /// The library of preloaded background events
+      library_t                  m_library          { };
+
+    protected:
+      /// Define standard assignments and constructors
+      DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiPileupLibrary);
+
+      /// Default destructor
+      virtual ~DigiPileupLibrary();
+
+      /// Initialization callback: load the background library
+      virtual void initialize();
+
+      /// Move the content of a loaded event to the library
+      std::size_t adopt_event(DigiEvent& event);
+
+    public:
+      /// Standard constructor
+      DigiPileupLibrary(const kernel_t& kernel, const std::string& name);
+      /// Access the number of background events in the library
+      std::size_t library_size()  const    {
+	return m_library.size();
+      }
+      /// Main functional callback
+      virtual void execute(context_t& context)  const override;
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_DIGIPILEUPLIBRARY_H
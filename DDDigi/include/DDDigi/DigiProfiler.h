@@ -0,0 +1,135 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_DIGIPROFILER_H
+#define DDDIGI_DIGIPROFILER_H
+
+/// C/C++ include files
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Forward declarations
+    class DigiAction;
+    class DigiKernel;
+
+    /// Per-action timing and throughput profiler of the digitization kernel
+    /**
+     *  The profiler is owned by the DigiKernel and only exists if the kernel
+     *  property "profile" is enabled. Execution times are recorded in
+     *  thread-local tables, which are merged when the summary is requested.
+     *  Latencies are histogrammed in logarithmic bins (4 bins per factor 2)
+     *  from which the percentiles are derived.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiProfiler   {
+    public:
+      /// Number of logarithmic latency bins: covers 1 nsec ... 2^40 nsec
+      enum { NUM_BINS = 160 };
+
+      /// Statistics record of one single action
+      class statistics_t   {
+      public:
+        /// Action name
+        std::string name                   { };
+        /// Number of calls
+        std::size_t calls                  { 0 };
+        /// Number of deposits handled by the action
+        std::size_t deposits               { 0 };
+        /// Total execution time in nanoseconds
+        std::uint64_t total                { 0 };
+        /// Minimal execution time in nanoseconds
+        std::uint64_t min                  { ~0UL };
+        /// Maximal execution time in nanoseconds
+        std::uint64_t max                  { 0 };
+        /// Latency histogram
+        std::array<std::uint32_t, NUM_BINS> bins { };
+
+      public:
+        /// Add single measurement
+        void add(std::uint64_t nanos, std::size_t num_deposits);
+        /// Merge statistics of another thread
+        void merge(const statistics_t& other);
+        /// Approximate latency percentile in nanoseconds (fraction in [0,1])
+        double percentile(double fraction)  const;
+      };
+
+      /// Helper to time a scoped action call
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_DIGITIZATION
+       */
+      class Scope   {
+        using clock_t = std::chrono::steady_clock;
+        DigiProfiler*         profiler  { nullptr };
+        const DigiAction*     action    { nullptr };
+        std::size_t           deposits  { 0 };
+        clock_t::time_point   start     { };
+      public:
+        /// Initializing constructor. No-op if the kernel has no profiler
+        Scope(const DigiKernel& kernel, const DigiAction* action, std::size_t num_deposits=0);
+        /// Inhibit copy constructor
+        Scope(const Scope& copy) = delete;
+        /// Inhibit copy assignment
+        Scope& operator=(const Scope& copy) = delete;
+        /// Default destructor: record the measurement
+        ~Scope();
+      };
+
+    private:
+      class thread_table_t;
+      /// Unique identifier of this profiler instance
+      std::uint64_t                                 m_id;
+      /// Lock protecting the table registry
+      mutable std::mutex                            m_lock;
+      /// Registry of all thread-local tables
+      std::vector<std::unique_ptr<thread_table_t> > m_tables;
+
+      /// Access the statistics table of the current thread
+      thread_table_t& table();
+
+    public:
+      /// Default constructor
+      DigiProfiler();
+      /// Inhibit copy constructor
+      DigiProfiler(const DigiProfiler& copy) = delete;
+      /// Inhibit copy assignment
+      DigiProfiler& operator=(const DigiProfiler& copy) = delete;
+      /// Default destructor
+      ~DigiProfiler();
+
+      /// Record one single action call
+      void record(const DigiAction* action, std::uint64_t nanos, std::size_t num_deposits);
+      /// Merge the statistics of all threads. Result is sorted by total time
+      std::vector<statistics_t> summary()  const;
+      /// Print the summary table using the output of the printing action
+      void print(const DigiAction& printer)  const;
+      /// Write the summary to file. Extension '.root' writes a TTree, otherwise JSON
+      bool write(const std::string& file_name)  const;
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_DIGIPROFILER_H
@@ -128,6 +128,8 @@ namespace dd4hep {
       bool                 m_parallel          { false };
       /// Property: Flag if processors should be shared
       bool                 m_share_processor   { true };
+      /// Property: Flag to only call the processors of segments with deposits
+      bool                 m_skip_empty        { false };
 
       /**  Member variables                           */
       /// Data keys from the readout collection names
@@ -73,6 +73,21 @@ namespace dd4hep {
       uint32_t split_id(uint64_t cell)  const  {
 	return uint32_t( (cell & this->split_mask) >> this->offset );
       }
+      /// Get the identifiers of n cells to be split (contiguous arrays, vectorizable)
+      void split_ids(const uint64_t* cells, std::size_t n, uint32_t* ids)  const  {
+	const uint64_t mask = this->split_mask;
+	const int32_t  off  = this->offset;
+	for( std::size_t i = 0; i < n; ++i )
+	  ids[i] = uint32_t( (cells[i] & mask) >> off );
+      }
+      /// Split a deposit container: deposit indices (in container order) per split identifier
+      void split(const DepositVector& deposits, std::map<uint32_t, std::vector<std::size_t> >& segments)  const;
+      /// Split a deposit container: deposit indices (in container order) per split identifier
+      void split(const DepositMapping& deposits, std::map<uint32_t, std::vector<std::size_t> >& segments)  const;
+      /// Collect the split identifiers present in a deposit container
+      void occupied(const DepositVector& deposits, std::set<uint32_t>& ids)  const;
+      /// Collect the split identifiers present in a deposit container
+      void occupied(const DepositMapping& deposits, std::set<uint32_t>& ids)  const;
       /// The CELL ID part of the identifier
       uint64_t cell_id(uint64_t cell)  const  {
 	return uint64_t( uint64_t(cell & this->cell_mask) >> (this->offset + width) );
@@ -16,6 +16,7 @@
 /// Framework include files
 #include <DDDigi/DigiAction.h>
 #include <DDDigi/DigiData.h>
+#include <DDDigi/DigiRandomGenerator.h>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -44,6 +45,27 @@ namespace dd4hep {
       ~DigiCellContext() = default;
     };
 
+    /// Batch of cells to be processed by a signal processor in one go
+    /**
+     *  Input:  the cell identifiers and the existing signals.
+     *  Output: one value per cell filled by the processor.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiCellBatch  final  {
+    public:
+      DigiContext&   context;
+      std::size_t    size     { 0 };
+      const CellID*  cells    { nullptr };
+      const double*  signals  { nullptr };
+      double*        values   { nullptr };
+      DigiCellBatch(DigiContext& c, std::size_t n, const CellID* ids, const double* sig, double* val)
+        : context(c), size(n), cells(ids), signals(sig), values(val) {}
+      ~DigiCellBatch() = default;
+    };
+
     /// Base class for signal processing actions to the digitization
     /**
      *
@@ -55,6 +77,8 @@ namespace dd4hep {
     protected:
       /// Flag to check if initialized was called
       bool  m_initialized = false;
+      /// Identifier of the random stream: hash of the processor name
+      std::uint32_t m_stream_id = 0;
 
       /// Define standard assignments and constructors
       DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiSignalProcessor);
@@ -68,6 +92,10 @@ namespace dd4hep {
       virtual void initialize();
       /// Callback to read event signalprocessor
       virtual double operator()(DigiCellContext& context)  const = 0;
+      /// Batch callback: fill one value per cell. Default calls operator() for each cell
+      virtual void process(DigiCellBatch& batch)  const;
+      /// Access the counter based random stream of this processor for the current event
+      DigiRandomStream random_stream(DigiContext& context)  const;
     };
   }    // End namespace digi
 }      // End namespace dd4hep
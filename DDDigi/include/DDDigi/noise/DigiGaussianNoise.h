@@ -51,6 +51,8 @@ namespace dd4hep {
       virtual ~DigiGaussianNoise();
       /// Callback to read event gaussiannoise
       virtual double operator()(DigiCellContext& context)  const  override;
+      /// Batch callback: one counter based random number per cell
+      virtual void process(DigiCellBatch& batch)  const  override;
     };
   }    // End namespace digi
 }      // End namespace dd4hep
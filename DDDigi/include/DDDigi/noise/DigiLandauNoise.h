@@ -51,6 +51,8 @@ namespace dd4hep {
       virtual ~DigiLandauNoise();
       /// Callback to read event landaunoise
       virtual double operator()(DigiCellContext& context)  const  override;
+      /// Batch callback: one counter based random number per cell
+      virtual void process(DigiCellBatch& batch)  const  override;
     };
   }    // End namespace digi
 }      // End namespace dd4hep
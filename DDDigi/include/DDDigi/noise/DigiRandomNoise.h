@@ -49,6 +49,8 @@ namespace dd4hep {
       double    m_variance = -1;
       /// Property: Number of IRR poles for the noise generator (5 should fit nearly everything)
       double    m_poles    = 5;
+      /// Property: Number of time samples (events) the batch filter runs over per cell
+      std::size_t m_history = 32;
 
       /// Noise generator
       detail::FalphaNoise  m_noise;
@@ -65,6 +67,13 @@ namespace dd4hep {
       virtual void initialize()  override;
       /// Callback to read event randomnoise
       virtual double operator()(DigiCellContext& context)  const  override;
+      /// Batch callback: filter the counter based white noise of each cell along time
+      /**  The white noise of a cell at event N is drawn from the stream of event N.
+       *   The value of event N is the filter output after the samples of the events
+       *   N-history+1 ... N. Consecutive events of a cell are hence correlated, and
+       *   the result neither depends on the other cells of the batch nor on their order.
+       */
+      virtual void process(DigiCellBatch& batch)  const  override;
     };
   }    // End namespace digi
 }      // End namespace dd4hep
@@ -66,6 +66,8 @@ namespace dd4hep {
       void adopt(DigiSignalProcessor* action);
       /// Begin-of-event callback
       virtual double operator()(DigiCellContext& context)  const override;
+      /// Batch callback: sum of the signals and the values of all actors
+      virtual void process(DigiCellBatch& batch)  const override;
     };
 
   }    // End namespace digi
@@ -159,6 +159,11 @@ namespace dd4hep {
       template <typename ENGINE> void normalize(ENGINE& engine, size_t shots=10000);
       /// Retrieve the next random number of the sequence
       template <typename ENGINE> double operator()(ENGINE& engine);
+      /// Filter the time ordered gaussian white noise samples of one single channel
+      /** The filter memory is reset first. The samples must have the variance variance().
+       *  Returns the 1/f**alpha noise value at the time of the last sample.
+       */
+      double filter(const double* white, size_t count);
     };
 
     /// Retrieve the next random number of the sequence
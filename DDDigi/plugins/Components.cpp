@@ -41,6 +41,21 @@ DECLARE_DIGIACTION_NS(dd4hep::digi,DigiLockedAction)
 //#include <DDDigi/DigiSignalProcessorSequence.h>
 // DECLARE_DIGISIGNALPROCESSOR_NS(dd4hep::digi,DigiSignalProcessorSequence)
 
+#include <DDDigi/noise/DigiGaussianNoise.h>
+DECLARE_DIGISIGNALPROCESSOR_NS(dd4hep::digi,DigiGaussianNoise)
+
+#include <DDDigi/noise/DigiUniformNoise.h>
+DECLARE_DIGISIGNALPROCESSOR_NS(dd4hep::digi,DigiUniformNoise)
+
+#include <DDDigi/noise/DigiPoissonNoise.h>
+DECLARE_DIGISIGNALPROCESSOR_NS(dd4hep::digi,DigiPoissonNoise)
+
+#include <DDDigi/noise/DigiLandauNoise.h>
+DECLARE_DIGISIGNALPROCESSOR_NS(dd4hep::digi,DigiLandauNoise)
+
+#include <DDDigi/noise/DigiExponentialNoise.h>
+DECLARE_DIGISIGNALPROCESSOR_NS(dd4hep::digi,DigiExponentialNoise)
+
 #include <DDDigi/DigiStoreDump.h>
 DECLARE_DIGIACTION_NS(dd4hep::digi,DigiStoreDump)
 
@@ -54,6 +69,9 @@ DECLARE_DIGIACTION_NS(dd4hep::digi,DigiContainerCombine)
 #include <DDDigi/DigiContainerDrop.h>
 DECLARE_DIGIACTION_NS(dd4hep::digi,DigiContainerDrop)
 
+#include <DDDigi/DigiPileupLibrary.h>
+DECLARE_DIGIACTION_NS(dd4hep::digi,DigiPileupLibrary)
+
 #include <DDDigi/DigiSegmentSplitter.h>
 DECLARE_DIGIACTION_NS(dd4hep::digi,DigiSegmentSplitter)
 
@@ -13,10 +13,16 @@
 
 // Framework include files
 #include <DDDigi/DigiContainerProcessor.h>
+#include <DDDigi/DigiSignalProcessor.h>
+#include <DDDigi/DigiKernel.h>
 #include <DD4hep/DD4hepUnits.h>
+#include <DD4hep/Plugins.h>
+#include <DD4hep/Primitives.h>
 
 /// C/C++ include files
+#include <map>
 #include <limits>
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -24,8 +30,14 @@ namespace dd4hep {
   /// Namespace for the Digitization part of the AIDA detector description toolkit
   namespace digi {
 
-    /// Actor to smear timing information of energy deposits
+    /// Actor to add noise to the energy of deposits
     /**
+     *  By default a gaussian noise with 'mean' and 'sigma' is added to each deposit.
+     *  If 'processor_type' names a signal processor factory (e.g. DigiGaussianNoise),
+     *  the noise of all selected cells of a container is generated in one batch by
+     *  this processor. Its properties are given as strings in 'processor_properties'.
+     *  The batch noise is drawn from counter based random streams: it is reproducible
+     *  and independent of the thread scheduling.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -37,11 +49,66 @@ namespace dd4hep {
       double m_mean                { 0e0 };
       /// Property: Sigma of the noise in absolute values
       double m_sigma               { 0e0 };
+      /// Property: Factory name of the signal processor to generate the noise in batches
+      std::string m_processor_type { };
+      /// Property: Properties of the signal processor
+      std::map<std::string, std::string> m_processor_properties { };
+      /// Signal processor generating the noise in batches
+      DigiSignalProcessor* m_processor { nullptr };
 
     public:
+      /// Create the signal processor
+      void initialize()   {
+        if ( m_processor_type.empty() )
+          return;
+        std::string nam = name() + "_noise";
+        m_processor = PluginService::Create<DigiSignalProcessor*>(m_processor_type, &m_kernel, nam);
+        if ( !m_processor )  {
+          except("+++ Failed to create signal processor: %s/%s", m_processor_type.c_str(), nam.c_str());
+        }
+        for( const auto& p : m_processor_properties )
+          m_processor->property(p.first) = p.second.c_str();
+        m_processor->initialize();
+        info("+++ Noise is generated in batches by %s/%s", m_processor_type.c_str(), nam.c_str());
+      }
+
+      /// Add noise to all selected deposits of a container in one batch
+      template <typename T> std::size_t
+      create_batch_noise(DigiContext& context, T& cont, const predicate_t& predicate)  const  {
+        std::vector<CellID> cells;
+        std::vector<double> signals;
+        cells.reserve(cont.size());
+        signals.reserve(cont.size());
+        for( const auto& dep : cont )  {
+          if ( predicate(dep) )  {
+            cells.emplace_back(dep.first);
+            signals.emplace_back(dep.second.deposit);
+          }
+        }
+        std::vector<double> values(cells.size(), 0e0);
+        DigiCellBatch batch(context, cells.size(), cells.data(), signals.data(), values.data());
+        m_processor->process(batch);
+        std::size_t updated = 0UL;
+        for( auto& dep : cont )  {
+          if ( predicate(dep) )  {
+            double delta_E = values[updated++];
+            if ( m_monitor ) m_monitor->energy_shift(dep, delta_E);
+            dep.second.deposit += delta_E;
+            dep.second.flag |= EnergyDeposit::DEPOSIT_NOISE;
+          }
+        }
+        return updated;
+      }
+
       /// Create deposit mapping with updates on same cellIDs
       template <typename T> void
       create_noise(DigiContext& context, T& cont, work_t& /* work */, const predicate_t& predicate)  const  {
+        if ( m_processor )  {
+          std::size_t updated = create_batch_noise(context, cont, predicate);
+          info("%s+++ %-32s Noise on signal: %6ld entries, updated %6ld entries in batch. mask: %04X",
+               context.event->id(), cont.name.c_str(), cont.size(), updated, cont.key.mask());
+          return;
+        }
         auto& random = context.randomGenerator();
         std::size_t updated = 0UL;
         for( auto& dep : cont )  {
@@ -64,7 +131,14 @@ namespace dd4hep {
       {
         declareProperty("mean",  m_mean);
         declareProperty("sigma", m_sigma);
+        declareProperty("processor_type",       m_processor_type);
+        declareProperty("processor_properties", m_processor_properties);
         DEPOSIT_PROCESSOR_BIND_HANDLERS(DigiDepositNoiseOnSignal::create_noise);
+        m_kernel.register_initialize(std::bind(&DigiDepositNoiseOnSignal::initialize,this));
+      }
+      /// Default destructor
+      virtual ~DigiDepositNoiseOnSignal()   {
+        detail::releasePtr(m_processor);
       }
     };
   }    // End namespace digi
@@ -0,0 +1,287 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DDDigi/DigiContainerProcessor.h>
+#include <DDDigi/DigiSegmentSplitter.h>
+#include <DD4hep/DD4hepUnits.h>
+
+/// C/C++ include files
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Waveform digitization of scintillator bars read out by SiPMs
+    /**
+     *  For every cell the deposits are converted to photo-electrons and
+     *  convoluted with the SiPM pulse template
+     *
+     *      p(t) = exp(-t/fall_time) - exp(-t/rise_time)   (normalized to 1 at the peak)
+     *
+     *  sampled in a window of num_samples bins starting at window_start.
+     *  Electronics noise is added per sample. From the resulting waveform
+     *  the amplitude (peak sample with parabolic interpolation) and the time
+     *  (constant fraction discrimination) are extracted and stored as
+     *  DetectorResponse containers with the postfixes '.adc' and '.tdc'.
+     *
+     *  Cells are processed in batches of BATCH_SIZE waveforms in one contiguous
+     *  buffer. The template is tabulated for 'oversampling' sub-sample phases,
+     *  so that the inner convolution loops run over contiguous memory
+     *  and are vectorized by the compiler.
+     *
+     *  The processor is stateless during event processing. Use it as a
+     *  segment processor of the DigiSegmentSplitter to process the segments
+     *  (e.g. layers) of a calorimeter in parallel.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiSiPMWaveform : public DigiDepositsProcessor  {
+    protected:
+      using segmentation_t = DigiSegmentProcessContext;
+      /// Number of waveforms processed together
+      enum { BATCH_SIZE = 16 };
+
+      /// Property: Postfix of the amplitude response container
+      std::string    m_adc_postfix        { ".adc" };
+      /// Property: Postfix of the timing response container
+      std::string    m_tdc_postfix        { ".tdc" };
+      /// Property: Number of photo-electrons per unit of deposited energy
+      double         m_light_yield        { 1e3 / dd4hep::MeV };
+      /// Property: Apply poisson fluctuations to the number of photo-electrons
+      bool           m_photo_statistics   { true };
+      /// Property: SiPM pulse rise time constant
+      double         m_rise_time          { 1e0 * dd4hep::ns };
+      /// Property: SiPM pulse fall time constant
+      double         m_fall_time          { 20e0 * dd4hep::ns };
+      /// Property: Time of the first waveform sample
+      double         m_window_start       { -10e0 * dd4hep::ns };
+      /// Property: Sampling period of the waveform
+      double         m_sampling_period    { 1e0 * dd4hep::ns };
+      /// Property: Number of samples of the waveform
+      int            m_num_samples        { 128 };
+      /// Property: Number of template phases per sample period
+      int            m_oversampling       { 8 };
+      /// Property: Electronics noise per sample in photo-electrons
+      double         m_noise_sigma        { 0e0 };
+      /// Property: Zero suppression threshold on the amplitude in photo-electrons
+      double         m_threshold          { 0.5 };
+      /// Property: Constant fraction used for the time extraction
+      double         m_cfd_fraction       { 0.5 };
+      /// Property: ADC counts per photo-electron
+      double         m_adc_gain           { 1e0 };
+      /// Property: ADC pedestal
+      double         m_adc_pedestal       { 0e0 };
+      /// Property: ADC saturation in counts
+      int            m_adc_saturation     { 4095 };
+      /// Property: TDC bin width
+      double         m_tdc_resolution     { 0.1 * dd4hep::ns };
+
+      /// Tabulated pulse template: m_oversampling phases of m_template_length samples
+      mutable std::vector<float> m_template    { };
+      /// Number of samples per template phase
+      mutable std::size_t        m_template_length { 0 };
+      /// Thread safe template creation
+      mutable std::once_flag     m_template_flag;
+
+    protected:
+      /// Pulse shape normalized to 1 at the maximum
+      double pulse(double t, double norm)  const   {
+        if ( t < 0e0 ) return 0e0;
+        return norm * (std::exp(-t/m_fall_time) - std::exp(-t/m_rise_time));
+      }
+
+      /// Tabulate the pulse template for all sub-sample phases
+      void build_template()  const   {
+        if ( m_rise_time <= 0e0 || m_fall_time <= m_rise_time )   {
+          except("+++ Invalid pulse shape: rise time %.3f ns must be positive and smaller than fall time %.3f ns",
+                 m_rise_time/dd4hep::ns, m_fall_time/dd4hep::ns);
+        }
+        if ( m_num_samples <= 1 || m_oversampling <= 0 || m_sampling_period <= 0e0 )   {
+          except("+++ Invalid sampling: %d samples, period %.3f ns, oversampling %d",
+                 m_num_samples, m_sampling_period/dd4hep::ns, m_oversampling);
+        }
+        double t_peak = m_rise_time*m_fall_time/(m_fall_time-m_rise_time) * std::log(m_fall_time/m_rise_time);
+        double norm   = 1e0 / (std::exp(-t_peak/m_fall_time) - std::exp(-t_peak/m_rise_time));
+        /// Tail is cut after 10 fall times or at the window length
+        double length = std::min(10e0 * m_fall_time, double(m_num_samples) * m_sampling_period);
+        m_template_length = std::size_t(std::ceil(length / m_sampling_period)) + 1;
+        m_template.resize(m_oversampling * m_template_length);
+        for( int phase = 0; phase < m_oversampling; ++phase )   {
+          float* tmpl = &m_template[phase * m_template_length];
+          double offset = double(phase) / double(m_oversampling);
+          for( std::size_t i = 0; i < m_template_length; ++i )
+            tmpl[i] = float(pulse((double(i) + offset) * m_sampling_period, norm));
+        }
+        info("+++ Pulse template: rise: %.2f ns fall: %.2f ns peak at %.2f ns. %d phases x %ld samples",
+             m_rise_time/dd4hep::ns, m_fall_time/dd4hep::ns, t_peak/dd4hep::ns,
+             m_oversampling, m_template_length);
+      }
+
+      /// Add the pulse of one single deposit to the waveform
+      void add_pulse(float* wave, double npe, double time)  const   {
+        const long   nsamp = m_num_samples;
+        const double rel   = (time - m_window_start) / m_sampling_period;
+        const long   k0    = long(std::ceil(rel));
+        if ( k0 >= nsamp ) return;
+        int phase = int((double(k0) - rel) * m_oversampling);
+        phase = std::min(std::max(phase, 0), m_oversampling-1);
+        const float* tmpl  = &m_template[phase * m_template_length];
+        const long   first = std::max(k0, 0L);
+        const long   last  = std::min(nsamp, k0 + long(m_template_length));
+        const float  amp   = float(npe);
+        if ( first >= last ) return;
+        tmpl += first - k0;
+        for( long k = first; k < last; ++k, ++tmpl )
+          wave[k] += amp * (*tmpl);
+      }
+
+      /// Peak finding with parabolic interpolation. Returns amplitude and fills peak position
+      float extract_amplitude(const float* wave, long& peak)  const   {
+        const long nsamp = m_num_samples;
+        float amp = wave[0];
+        peak = 0;
+        for( long k = 1; k < nsamp; ++k )   {
+          if ( wave[k] > amp )   {
+            amp  = wave[k];
+            peak = k;
+          }
+        }
+        if ( peak > 0 && peak < nsamp-1 )   {
+          float a = wave[peak-1], b = wave[peak], c = wave[peak+1];
+          float den = a - 2e0f*b + c;
+          if ( den < 0e0f )
+            amp = b - 0.125f * (a-c) * (a-c) / den;
+        }
+        return amp;
+      }
+
+      /// Constant fraction time extraction on the leading edge
+      double extract_time(const float* wave, long peak, float amplitude)  const   {
+        const float level = float(m_cfd_fraction) * amplitude;
+        for( long k = peak; k > 0; --k )   {
+          if ( wave[k-1] < level && wave[k] >= level )   {
+            double frac = double(level - wave[k-1]) / double(wave[k] - wave[k-1]);
+            return m_window_start + (double(k-1) + frac) * m_sampling_period;
+          }
+        }
+        return m_window_start + double(peak) * m_sampling_period;
+      }
+
+    public:
+      /// Standard constructor
+      DigiSiPMWaveform(const DigiKernel& krnl, const std::string& nam)
+        : DigiDepositsProcessor(krnl, nam)
+      {
+        declareProperty("adc_postfix",      m_adc_postfix);
+        declareProperty("tdc_postfix",      m_tdc_postfix);
+        declareProperty("light_yield",      m_light_yield);
+        declareProperty("photo_statistics", m_photo_statistics);
+        declareProperty("rise_time",        m_rise_time);
+        declareProperty("fall_time",        m_fall_time);
+        declareProperty("window_start",     m_window_start);
+        declareProperty("sampling_period",  m_sampling_period);
+        declareProperty("num_samples",      m_num_samples);
+        declareProperty("oversampling",     m_oversampling);
+        declareProperty("noise_sigma",      m_noise_sigma);
+        declareProperty("threshold",        m_threshold);
+        declareProperty("cfd_fraction",     m_cfd_fraction);
+        declareProperty("adc_gain",         m_adc_gain);
+        declareProperty("adc_pedestal",     m_adc_pedestal);
+        declareProperty("adc_saturation",   m_adc_saturation);
+        declareProperty("tdc_resolution",   m_tdc_resolution);
+        DEPOSIT_PROCESSOR_BIND_HANDLERS(DigiSiPMWaveform::digitize);
+      }
+
+      /// Create waveforms, extract amplitude and time and register the responses to the output segment
+      template <typename T>
+      void digitize(DigiContext& context, const T& input, work_t& work, const predicate_t& predicate)  const  {
+        using cell_deposit_t = std::pair<CellID, const EnergyDeposit*>;
+        std::call_once(m_template_flag, [this]() { this->build_template(); });
+
+        const char* tag = context.event->id();
+        auto& random = context.randomGenerator();
+        std::string postfix = predicate.segmentation ? "."+predicate.segmentation->identifier(predicate.id) : std::string();
+        DetectorResponse adc(input.name + postfix + m_adc_postfix, work.environ.output.mask);
+        DetectorResponse tdc(input.name + postfix + m_tdc_postfix, work.environ.output.mask);
+
+        /// Group the accepted deposits by cell
+        std::vector<cell_deposit_t> deposits;
+        deposits.reserve(input.size());
+        for( const auto& dep : input )   {
+          if ( predicate(dep) )
+            deposits.emplace_back(dep.first, &dep.second);
+        }
+        std::stable_sort(deposits.begin(), deposits.end(),
+                         [](const cell_deposit_t& a, const cell_deposit_t& b) { return a.first < b.first; });
+
+        const std::size_t nsamp = m_num_samples;
+        std::vector<float>  waves(BATCH_SIZE * nsamp);
+        std::vector<CellID> cells;
+        cells.reserve(BATCH_SIZE);
+        std::size_t num_cells = 0;
+        auto idep = deposits.begin();
+        while( idep != deposits.end() )   {
+          /// 1) Convolute the deposits of the next batch of cells with the pulse template
+          std::fill(waves.begin(), waves.end(), 0e0f);
+          cells.clear();
+          while( idep != deposits.end() && cells.size() < BATCH_SIZE )   {
+            CellID cell = idep->first;
+            float* wave = &waves[cells.size() * nsamp];
+            for( ; idep != deposits.end() && idep->first == cell; ++idep )   {
+              double npe = idep->second->deposit * m_light_yield;
+              if ( m_photo_statistics ) npe = random.poisson(npe);
+              if ( npe > 0e0 ) add_pulse(wave, npe, idep->second->time);
+            }
+            cells.emplace_back(cell);
+          }
+          num_cells += cells.size();
+          /// 2) Add electronics noise to the batch
+          if ( m_noise_sigma > 0e0 )   {
+            const std::size_t nvals = cells.size() * nsamp;
+            for( std::size_t i = 0; i < nvals; ++i )
+              waves[i] += float(random.gaussian(0e0, m_noise_sigma));
+          }
+          /// 3) Extract amplitude and time
+          for( std::size_t j = 0; j < cells.size(); ++j )   {
+            const float* wave = &waves[j * nsamp];
+            long  peak = 0;
+            float amp  = extract_amplitude(wave, peak);
+            if ( amp < m_threshold ) continue;
+            double time   = extract_time(wave, peak, amp);
+            double counts = std::round(double(amp) * m_adc_gain + m_adc_pedestal);
+            double ticks  = std::round((time - m_window_start) / m_tdc_resolution);
+            counts = std::min(std::max(counts, 0e0), double(m_adc_saturation));
+            ticks  = std::max(ticks, 0e0);
+            adc.emplace(cells[j], { ADCValue::value_t(counts), ADCValue::address_t(cells[j]) });
+            tdc.emplace(cells[j], { ADCValue::value_t(ticks),  ADCValue::address_t(cells[j]) });
+          }
+        }
+        info("%s+++ %-32s %6ld waveforms %6ld above threshold. Input: %-32s %6ld deposits", tag,
+             adc.name.c_str(), num_cells, adc.size(), input.name.c_str(), input.size());
+        work.environ.output.data.put(adc.key, std::move(adc));
+        work.environ.output.data.put(tdc.key, std::move(tdc));
+      }
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+//        Factory definition
+#include <DDDigi/DigiFactories.h>
+DECLARE_DIGIACTION_NS(dd4hep::digi,DigiSiPMWaveform)
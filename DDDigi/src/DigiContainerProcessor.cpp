@@ -16,6 +16,7 @@
 #include <DDDigi/DigiData.h>
 #include <DDDigi/DigiKernel.h>
 #include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiProfiler.h>
 #include <DDDigi/DigiContainerProcessor.h>
 #include <DDDigi/DigiSegmentSplitter.h>
 
@@ -83,6 +84,21 @@ std::string DigiContainerProcessor::work_t::input_type_name()  const   {
   return typeName(input.data->type());
 }
 
+/// Number of entries in the input container (0 if unknown)
+std::size_t DigiContainerProcessor::work_t::input_size()  const   {
+  if ( const auto* v = std::any_cast<DepositVector>(input.data) )
+    return v->size();
+  else if ( const auto* m = std::any_cast<DepositMapping>(input.data) )
+    return m->size();
+  else if ( const auto* r = std::any_cast<DetectorResponse>(input.data) )
+    return r->size();
+  else if ( const auto* h = std::any_cast<DetectorHistory>(input.data) )
+    return h->size();
+  else if ( const auto* p = std::any_cast<ParticleMapping>(input.data) )
+    return p->size();
+  return 0;
+}
+
 /// Access to default callback 
 const DigiContainerProcessor::predicate_t& DigiContainerProcessor::accept_all()  {
   static predicate_t s_pred { std::bind(predicate_t::always_true, std::placeholders::_1), 0, nullptr };
@@ -169,6 +185,7 @@ template <> void DigiParallelWorker<DigiContainerProcessor,
                                     std::size_t,
                                     DigiContainerSequence&>::execute(void* data) const  {
   calldata_t* arg  = reinterpret_cast<calldata_t*>(data);
+  DigiProfiler::Scope scope(arg->environ.context.kernel, action, arg->input_size());
   action->execute(arg->environ.context, *arg, predicate.m_worker_predicate);
 }
 
@@ -294,6 +311,7 @@ template <> void DigiParallelWorker<DigiContainerProcessor,
   auto* args = reinterpret_cast<calldata_t*>(data);
   auto& item = args->input_items[this->options];
   DigiContainerProcessor::work_t work { args->environ, item };
+  DigiProfiler::Scope scope(args->environ.context.kernel, action, work.input_size());
   action->execute(args->environ.context, work, predicate.m_worker_predicate);
 }
 
@@ -432,11 +450,13 @@ template <> void DigiParallelWorker<DigiContainerProcessor,
       tag = "mask accepted";
       if ( keys.empty() )  {
         DigiContainerProcessor::work_t  work { arg->environ, item };
+        DigiProfiler::Scope scope(work.environ.context.kernel, action, work.input_size());
         action->execute(work.environ.context, work, predicate.m_worker_predicate);
         continue;
       }
       else if ( std::find(keys.begin(), keys.end(), key) != keys.end() )    {
         DigiContainerProcessor::work_t work { arg->environ, item };
+        DigiProfiler::Scope scope(work.environ.context.kernel, action, work.input_size());
         action->execute(work.environ.context, work, predicate.m_worker_predicate);
         continue;
       }
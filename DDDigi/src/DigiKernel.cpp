@@ -21,11 +21,15 @@
 
 #include <DDDigi/DigiKernel.h>
 #include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiProfiler.h>
 #include <DDDigi/DigiActionSequence.h>
 #include <DDDigi/DigiMonitorHandler.h>
 
 #ifdef DD4HEP_USE_TBB
 #include <tbb/task_group.h>
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
 #include <tbb/global_control.h>
 #else
 namespace tbb {  struct global_control { enum { max_allowed_parallelism = -1 }; }; }
@@ -38,6 +42,7 @@ namespace tbb {  struct global_control { enum { max_allowed_parallelism = -1 };
 #include <algorithm>
 #include <memory>
 #include <chrono>
+#include <atomic>
 
 using namespace dd4hep::digi;
 
@@ -100,6 +105,20 @@ public:
   std::shared_ptr<DigiRandomGenerator> random  { };
   /// TBB initializer (If TBB is used)
   std::unique_ptr<tbb::global_control> tbb_init { };
+#ifdef DD4HEP_USE_TBB
+  /// TBB task arena shared by event- and container-level tasks
+  std::unique_ptr<tbb::task_arena>     tbb_arena { };
+#endif
+  /// Scheduler statistics: number of executed tasks
+  std::atomic<std::size_t>   num_tasks       { 0 };
+  /// Scheduler statistics: number of submitted task chunks
+  std::atomic<std::size_t>   num_chunks      { 0 };
+  /// Scheduler statistics: accumulated task execution time in nanoseconds
+  std::atomic<std::uint64_t> task_time       { 0 };
+  /// Scheduler statistics: accumulated event execution time in nanoseconds
+  std::atomic<std::uint64_t> event_time      { 0 };
+  /// Scheduler statistics: maximal event execution time in nanoseconds
+  std::atomic<std::uint64_t> max_event_time  { 0 };
   /// Property: Output level
   int                   outputLevel;
   /// Property: maximum number of events to be processed (if < 0: infinite)
@@ -110,6 +129,12 @@ public:
   int                   num_threads;
   /// Property: Allow to stop execution from interactive prompt
   bool                  stop = false;
+  /// Property: Enable per-action profiling
+  bool                  profile = false;
+  /// Property: Output file of the profile summary (.json or .root)
+  std::string           profile_output  { };
+  /// Per-action profiler (if enabled)
+  std::unique_ptr<DigiProfiler> profiler { };
 
 public:
   /// Default constructor
@@ -117,6 +142,21 @@ public:
   /// Default destructor
   ~Internals() = default;
 
+  /// Reset the scheduler statistics
+  void reset_statistics()   {
+    num_tasks = 0;
+    num_chunks = 0;
+    task_time = 0;
+    event_time = 0;
+    max_event_time = 0;
+  }
+  /// Account the execution time of one single event
+  void add_event_time(std::uint64_t nanos)   {
+    std::uint64_t prev = max_event_time;
+    event_time += nanos;
+    while( prev < nanos && !max_event_time.compare_exchange_weak(prev, nanos) ) {}
+  }
+
   static std::mutex kernel_mutex;  
 };
 
@@ -131,15 +171,20 @@ std::mutex DigiKernel::Internals::kernel_mutex {};
  */
 template<typename ACTION, typename ARG> class DigiKernel::Wrapper  {
 public:
+  Internals& internals;
   ACTION*  action = 0;
   ARG   context;
-  Wrapper(ACTION* a, ARG c) : action(a), context(c) {}
+  Wrapper(Internals& i, ACTION* a, ARG c) : internals(i), action(a), context(c) {}
   Wrapper(Wrapper&& copy) = default;
   Wrapper(const Wrapper& copy) = default;
   Wrapper& operator=(Wrapper&& copy) = delete;
   Wrapper& operator=(const Wrapper& copy) = delete;
   void operator()() const {
+    auto start = std::chrono::steady_clock::now();
     action->execute(context);
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    internals.task_time += nanos.count();
+    ++internals.num_tasks;
   }
 };
 
@@ -162,15 +207,20 @@ public:
       todo = -1;
       {
         std::lock_guard<std::mutex> lock(kernel.internals->counter_lock);
-        if( !kernel.internals->stop && kernel.internals->events_todo > 0)
+        if( !kernel.internals->stop && kernel.internals->events_todo > 0)   {
           todo = --kernel.internals->events_todo;
+	  ++kernel.internals->events_submitted;
+	}
       }
       if ( todo >= 0 )   {
         int ev_num = kernel.internals->numEvents - todo;
+	auto start = std::chrono::steady_clock::now();
 	std::unique_ptr<DigiContext> context = 
 	  std::make_unique<DigiContext>(this->kernel,std::make_unique<DigiEvent>(ev_num));
 	context->set_random_generator(this->kernel.internals->random);
         kernel.executeEvent(std::move(context));
+	auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+	kernel.internals->add_event_time(nanos.count());
       }
     }
   }
@@ -186,6 +236,8 @@ DigiKernel::DigiKernel(Detector& description_ref)
   declareProperty("numThreads",       internals->num_threads);
   declareProperty("numEvents",        internals->numEvents = 10);
   declareProperty("stop",             internals->stop = false);
+  declareProperty("profile",          internals->profile = false);
+  declareProperty("profileOutput",    internals->profile_output);
   declareProperty("OutputLevels",     internals->clientLevels);
   auto* h = new DigiMonitorHandler(*this, "MonitorData");
   properties().add("MonitorOutput", h->property("MonitorOutput"));
@@ -200,12 +252,16 @@ DigiKernel::DigiKernel(Detector& description_ref)
   internals->root_random = new TRandom();
   internals->random = std::make_shared<DigiRandomGenerator>();
   internals->random->engine = [this] {  return internals->root_random->Uniform(1.0);  };
+  declareProperty("streamSeed",       internals->random->seed);
   InstanceCount::increment(this);
 }
 
 /// Default destructor
 DigiKernel::~DigiKernel() {
   std::lock_guard<std::mutex> lock(Internals::kernel_mutex);
+#ifdef DD4HEP_USE_TBB
+  internals->tbb_arena.reset();
+#endif
   internals->tbb_init.reset();
   detail::releasePtr(internals->monitor_handler);
   detail::releasePtr(internals->output_action);
@@ -213,6 +269,7 @@ DigiKernel::~DigiKernel() {
   detail::releasePtr(internals->input_action);
   detail::deletePtr(internals->root_random);
   internals->random.reset();
+  internals->profiler.reset();
   detail::deletePtr(internals);
   InstanceCount::decrement(this);
 }
@@ -285,6 +342,11 @@ std::size_t DigiKernel::events_processing()  const   {
   return evts;
 }
 
+/// Access to the action profiler. Returns NULL unless the property "profile" is set
+DigiProfiler* DigiKernel::profiler()  const   {
+  return internals->profiler.get();
+}
+
 /// Construct detector geometry using description plugin
 void DigiKernel::loadGeometry(const std::string& compact_file) {
   char* arg = (char*) compact_file.c_str();
@@ -305,6 +367,11 @@ int DigiKernel::configure()   {
 
 /// Initialize the digitization: call all registered initializers
 int DigiKernel::initialize()   {
+  if ( internals->profile && !internals->profiler )   {
+    internals->profiler = std::make_unique<DigiProfiler>();
+    info("+++ Per-action profiling ENABLED. Summary output: %s",
+	 internals->profile_output.empty() ? "[printout only]" : internals->profile_output.c_str());
+  }
   for(auto& call : internals->initializers) call();
   return 1;
 }
@@ -368,15 +435,28 @@ void DigiKernel::register_monitor(DigiAction* action, TNamed* object)  const
 /// Submit a bunch of actions to be executed in parallel
 void DigiKernel::submit (DigiContext& context, ParallelCall*const algorithms[], std::size_t count, void* data, bool parallel)  const    {
   const char* tag = context.event->id();
+  ++internals->num_chunks;
 #ifdef DD4HEP_USE_TBB
-  bool para = parallel && (internals->tbb_init && internals->num_threads > 0);
+  bool para = parallel && count > 1 && (internals->tbb_arena && internals->num_threads > 0);
   if ( para )   {
-    tbb::task_group que;
     info("%s+++ Executing chunk of %3ld execution entries in parallel", tag, count);
     try   {
-      for( std::size_t i=0; i<count && !internals->stop; ++i)
-	que.run( Wrapper<ParallelCall,void*>(algorithms[i], data) );
-      que.wait();
+      /// Container tasks are scheduled in the same arena as the events: idle
+      /// threads of the arena help executing the tasks of this chunk.
+      /// The chunk is isolated: while waiting for the chunk to complete, this
+      /// thread only executes tasks of the chunk. It may not pick up another
+      /// event from the main task group, which would block this event until
+      /// the other event is finished.
+      Internals& intern = *internals;
+      intern.tbb_arena->execute([&intern, algorithms, count, data]()  {
+	tbb::this_task_arena::isolate([&intern, algorithms, count, data]()  {
+	  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, count, 1),
+			    [&intern, algorithms, data](const tbb::blocked_range<std::size_t>& r)  {
+			      for( std::size_t i=r.begin(); i != r.end() && !intern.stop; ++i )
+				Wrapper<ParallelCall,void*>(intern, algorithms[i], data)();
+			    });
+	});
+      });
     }
     catch(const std::exception& e)    {
       std::exception_ptr eptr = std::current_exception();
@@ -391,7 +471,7 @@ void DigiKernel::submit (DigiContext& context, ParallelCall*const algorithms[],
 #endif
   info("%s+++ Executing chunk of %3ld execution entries sequentially", tag, count);
   for( std::size_t i=0; i<count; ++i)
-    algorithms[i]->execute(data);
+    Wrapper<ParallelCall,void*>(*internals, algorithms[i], data)();
 }
 
 /// Submit a bunch of actions to be executed in parallel
@@ -408,9 +488,18 @@ void DigiKernel::executeEvent(std::unique_ptr<DigiContext>&& context)    {
   DigiContext& refContext = *context;
   try {
     for(auto& call : internals->start_event) call(refContext);
-    inputAction().execute(refContext);
-    eventAction().execute(refContext);
-    outputAction().execute(refContext);
+    {
+      DigiProfiler::Scope scope(*this, internals->input_action);
+      inputAction().execute(refContext);
+    }
+    {
+      DigiProfiler::Scope scope(*this, internals->event_action);
+      eventAction().execute(refContext);
+    }
+    {
+      DigiProfiler::Scope scope(*this, internals->output_action);
+      outputAction().execute(refContext);
+    }
     for(auto& call : internals->end_event) call(refContext);
     notify(std::move(context));
   }
@@ -444,6 +533,7 @@ int DigiKernel::run()   {
   internals->events_finished = 0;
   internals->events_submitted = 0;
   internals->events_todo = internals->numEvents;
+  internals->reset_statistics();
   info("+++ Total number of events:    %d",internals->numEvents);
 #ifdef DD4HEP_USE_TBB
   if ( !internals->tbb_init && internals->num_threads > 0 )   {
@@ -454,20 +544,23 @@ int DigiKernel::run()   {
       info("+++ Number of TBB threads:     %d",internals->num_threads);
       info("+++ Number of parallel events: %d",internals->maxEventsParallel);
       internals->tbb_init = std::make_unique<ctrl_t>(ctrl_t::max_allowed_parallelism,internals->num_threads+1);
+      internals->tbb_arena = std::make_unique<tbb::task_arena>(internals->num_threads+1);
       if ( internals->maxEventsParallel >= 0 )   {
 	int todo_evt = internals->events_todo;
 	int num_proc = std::min(todo_evt,internals->maxEventsParallel);
-	tbb::task_group main_group;
-	try  {
-	  for(int i=0; i < num_proc; ++i)
-	    main_group.run(Processor(*this));
-	  main_group.wait();
-	}
-	catch(const std::exception& e)    {
-	  internals->stop = true;
-	  error("run: +++ C++ exception. Event loop stop. [%s]", e.what());
-	  main_group.wait();
-	}
+	internals->tbb_arena->execute([this, num_proc]()  {
+	  tbb::task_group main_group;
+	  try  {
+	    for(int i=0; i < num_proc; ++i)
+	      main_group.run(Processor(*this));
+	    main_group.wait();
+	  }
+	  catch(const std::exception& e)    {
+	    internals->stop = true;
+	    error("run: +++ C++ exception. Event loop stop. [%s]", e.what());
+	    main_group.wait();
+	  }
+	});
       }
       debug("+++ All event processing threads Synchronized --- Done!");
   }
@@ -477,7 +570,6 @@ int DigiKernel::run()   {
       while ( internals->events_todo > 0 && !internals->stop )   {
 	Processor proc(*this);
 	proc();
-	++internals->events_submitted;
       }
     }
 
@@ -487,6 +579,15 @@ int DigiKernel::run()   {
        "Total: %7.1f seconds %7.3f seconds/event",
        internals->numEvents-int(internals->events_todo), internals->numEvents,
        sec, sec/double(std::max(1,internals->numEvents)));
+  std::size_t num_tasks  = internals->num_tasks;
+  std::size_t num_events = internals->events_finished;
+  info("+++ Scheduler: %ld tasks in %ld chunks. Task time: %9.3f ms mean %9.3f ms total",
+       num_tasks, std::size_t(internals->num_chunks),
+       double(internals->task_time)/1e6/double(std::max<std::size_t>(num_tasks,1)),
+       double(internals->task_time)/1e6);
+  info("+++ Scheduler: %ld events.        Event time: %9.3f ms mean %9.3f ms max",
+       num_events, double(internals->event_time)/1e6/double(std::max<std::size_t>(num_events,1)),
+       double(internals->max_event_time)/1e6);
   return 1;
 }
 
@@ -494,6 +595,15 @@ int DigiKernel::run()   {
 int DigiKernel::terminate() {
   info("++ Saving monitoring quantities.");
   internals->monitor_handler->save();
+  if ( internals->profiler )   {
+    internals->profiler->print(*this);
+    if ( !internals->profile_output.empty() )   {
+      if ( internals->profiler->write(internals->profile_output) )
+	info("++ Profile summary written to %s", internals->profile_output.c_str());
+      else
+	warning("++ FAILED to write profile summary to %s", internals->profile_output.c_str());
+    }
+  }
   info("++ Terminate Digi and delete associated actions.");
   for(auto& call : internals->terminators) call();
   m_detDesc->destroyInstance();
@@ -0,0 +1,190 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/DD4hepUnits.h>
+#include <DD4hep/InstanceCount.h>
+#include <DDDigi/DigiData.h>
+#include <DDDigi/DigiKernel.h>
+#include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiPlugins.h>
+#include <DDDigi/DigiInputAction.h>
+#include <DDDigi/DigiPileupLibrary.h>
+
+/// C/C++ include files
+#include <cmath>
+
+using namespace dd4hep::digi;
+
+/// One single background event of the pile-up library
+/**
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \ingroup DD4HEP_DIGITIZATION
+ */
+class DigiPileupLibrary::library_event_t   {
+public:
+  /// Deposit containers of this background event
+  std::vector<DepositVector> containers  { };
+  /// Total number of deposits in this background event
+  std::size_t                num_deposits  { 0 };
+};
+
+/// Standard constructor
+DigiPileupLibrary::DigiPileupLibrary(const DigiKernel& krnl, const std::string& nam)
+  : DigiEventAction(krnl, nam)
+{
+  declareProperty("loader_type",    m_loader_type);
+  declareProperty("input",          m_library_input);
+  declareProperty("containers",     m_containers);
+  declareProperty("library_size",   m_library_size);
+  declareProperty("output_segment", m_output_segment);
+  declareProperty("output_mask",    m_output_mask);
+  declareProperty("multiplicity",   m_multiplicity);
+  declareProperty("poisson",        m_poisson);
+  declareProperty("bunch_spacing",  m_bunch_spacing);
+  declareProperty("bunch_range",    m_bunch_range);
+  declareProperty("offset_ip",      m_offset_ip);
+  declareProperty("sigma_ip",       m_sigma_ip);
+  m_kernel.register_initialize(std::bind(&DigiPileupLibrary::initialize,this));
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+DigiPileupLibrary::~DigiPileupLibrary() {
+  m_library.clear();
+  InstanceCount::decrement(this);
+}
+
+/// Move the content of a loaded event to the library
+std::size_t DigiPileupLibrary::adopt_event(DigiEvent& event)   {
+  auto entry = std::make_unique<library_event_t>();
+  auto& inputs = event.get_segment("inputs");
+  for( auto& i : inputs )   {
+    if ( DepositVector* v = std::any_cast<DepositVector>(&i.second) )   {
+      DepositVector cont(v->name, m_output_mask, v->data_type);
+      cont.merge(std::move(*v));
+      entry->containers.emplace_back(std::move(cont));
+    }
+    else if ( DepositMapping* m = std::any_cast<DepositMapping>(&i.second) )   {
+      DepositVector cont(m->name, m_output_mask, m->data_type);
+      cont.merge(std::move(*m));
+      entry->containers.emplace_back(std::move(cont));
+    }
+  }
+  /// The history refers to records of the loader event, which will not survive
+  for( auto& cont : entry->containers )   {
+    for( auto& dep : cont )
+      dep.second.history.drop();
+    entry->num_deposits += cont.size();
+  }
+  std::size_t num_deposits = entry->num_deposits;
+  m_library.emplace_back(std::move(entry));
+  return num_deposits;
+}
+
+/// Initialization callback: load the background library
+void DigiPileupLibrary::initialize()   {
+  std::string nam = name() + ".Loader";
+  auto* loader = createAction<DigiInputAction>(m_loader_type, m_kernel, nam);
+  if ( !loader )   {
+    except("+++ Failed to create library loader: %s of type: %s",
+	   nam.c_str(), m_loader_type.c_str());
+  }
+  loader->property("input").set(m_library_input);
+  loader->property("segment").set(std::string("inputs"));
+  loader->property("keep_raw").set(false);
+  loader->property("OutputLevel").set(int(outputLevel()));
+  if ( !m_containers.empty() )   {
+    loader->property("objects_enabled").set(m_containers);
+  }
+  std::size_t num_deposits = 0;
+  try   {
+    for( int i=0; i < m_library_size; ++i )   {
+      DigiContext context(m_kernel, std::make_unique<DigiEvent>(i));
+      loader->execute(context);
+      num_deposits += adopt_event(*context.event);
+    }
+  }
+  catch(const std::exception& e)   {
+    if ( m_library.empty() )   {
+      loader->release();
+      except("+++ Failed to load any pile-up event: %s", e.what());
+    }
+    warning("+++ Input exhausted after %ld of %d requested library events.",
+	    m_library.size(), m_library_size);
+  }
+  loader->release();
+  info("+++ Pile-up library loaded with %ld events and %ld deposits. Mean multiplicity: %.2f",
+       m_library.size(), num_deposits, m_multiplicity);
+}
+
+/// Main functional callback
+void DigiPileupLibrary::execute(DigiContext& context)  const    {
+  auto& rndm   = context.randomGenerator();
+  auto& event  = *context.event;
+  auto& output = event.get_segment(m_output_segment);
+  std::size_t num_events = m_library.size();
+  std::size_t num_deposits = 0;
+  std::size_t num_interactions = m_poisson
+    ? std::size_t(rndm.poisson(m_multiplicity))
+    : std::size_t(m_multiplicity + 0.5);
+  std::map<Key::itemkey_type, DepositVector> outputs;
+
+  if ( 0 == num_events )   {
+    except("%s+++ The pile-up library is empty. Was the action properly initialized?", event.id());
+  }
+  for( std::size_t i=0; i < num_interactions; ++i )    {
+    std::size_t idx = std::min(num_events-1, std::size_t(rndm.uniform(double(num_events))));
+    const auto& entry = *m_library[idx];
+    /// Time offset from a random bunch crossing
+    double delta_t = 0e0;
+    if ( m_bunch_range.size() == 2 )   {
+      int first  = std::min(m_bunch_range[0], m_bunch_range[1]);
+      int last   = std::max(m_bunch_range[0], m_bunch_range[1]);
+      int bx     = first + std::min(last-first, int(rndm.uniform(double(last-first+1))));
+      delta_t    = double(bx) * m_bunch_spacing;
+    }
+    /// Interaction point of this background interaction
+    double theta  = rndm.uniform(0.0, M_PI);
+    double phi    = rndm.uniform(0.0, 2.0*M_PI);
+    double radius = std::sqrt( -std::log(rndm.uniform(0.0, 1.0)) );
+    double st     = std::sin(theta);
+    Position delta_ip(radius * st * std::cos(phi) * m_sigma_ip.X() + m_offset_ip.X(),
+		      radius * st * std::sin(phi) * m_sigma_ip.Y() + m_offset_ip.Y(),
+		      radius * std::cos(theta) * m_sigma_ip.Z() + m_offset_ip.Z());
+    for( const auto& cont : entry.containers )   {
+      auto iter = outputs.find(cont.key.item());
+      if ( iter == outputs.end() )   {
+	DepositVector out(cont.name, m_output_mask, cont.data_type);
+	iter = outputs.emplace(cont.key.item(), std::move(out)).first;
+      }
+      for( const auto& dep : cont )   {
+	EnergyDeposit depo(dep.second);
+	depo.time     += delta_t;
+	depo.position += delta_ip;
+	depo.mask      = m_output_mask;
+	iter->second.emplace(dep.first, std::move(depo));
+      }
+    }
+    num_deposits += entry.num_deposits;
+    debug("%s+++ Overlay library event %6ld  dt: %8.2f ns  IP: x:%7.3f y:%7.3f z:%7.3f",
+	  event.id(), idx, delta_t/dd4hep::ns, delta_ip.X(), delta_ip.Y(), delta_ip.Z());
+  }
+  for( auto& o : outputs )   {
+    Key key(o.second.name, m_output_mask);
+    output.emplace(std::move(key), std::move(o.second));
+  }
+  info("%s+++ Overlaid %3ld pile-up interactions with %7ld deposits in %ld containers [mask: %04X]",
+       event.id(), num_interactions, num_deposits, outputs.size(), m_output_mask);
+}
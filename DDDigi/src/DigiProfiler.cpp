@@ -0,0 +1,235 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DDDigi/DigiKernel.h>
+#include <DDDigi/DigiProfiler.h>
+
+/// ROOT include files
+#include <TFile.h>
+#include <TTree.h>
+
+/// C/C++ include files
+#include <unordered_map>
+#include <map>
+#include <algorithm>
+#include <fstream>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+
+using namespace dd4hep::digi;
+
+namespace  {
+  /// Unique identifiers of profiler instances to validate thread-local caches
+  std::atomic<std::uint64_t> s_profiler_id { 0 };
+
+  /// Logarithmic bin number of a latency value
+  inline std::size_t latency_bin(std::uint64_t nanos)   {
+    if ( nanos < 2 ) return 0;
+    std::size_t bin = std::size_t(4e0 * std::log2(double(nanos)));
+    return std::min(bin, std::size_t(DigiProfiler::NUM_BINS-1));
+  }
+}
+
+/// Thread-local statistics table
+/**
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \ingroup DD4HEP_DIGITIZATION
+ */
+class DigiProfiler::thread_table_t   {
+public:
+  std::unordered_map<const DigiAction*, statistics_t> actions;
+  /// Table access lock. Only contended while the summary is built
+  std::mutex lock;
+};
+
+/// Add single measurement
+void DigiProfiler::statistics_t::add(std::uint64_t nanos, std::size_t num_deposits)   {
+  ++calls;
+  deposits += num_deposits;
+  total    += nanos;
+  min = std::min(min, nanos);
+  max = std::max(max, nanos);
+  ++bins[latency_bin(nanos)];
+}
+
+/// Merge statistics of another thread
+void DigiProfiler::statistics_t::merge(const statistics_t& other)   {
+  if ( name.empty() ) name = other.name;
+  calls    += other.calls;
+  deposits += other.deposits;
+  total    += other.total;
+  min = std::min(min, other.min);
+  max = std::max(max, other.max);
+  for( std::size_t i=0; i < bins.size(); ++i )
+    bins[i] += other.bins[i];
+}
+
+/// Approximate latency percentile in nanoseconds (fraction in [0,1])
+double DigiProfiler::statistics_t::percentile(double fraction)  const   {
+  if ( 0 == calls ) return 0e0;
+  std::size_t limit = std::size_t(std::ceil(fraction * double(calls)));
+  std::size_t count = 0;
+  for( std::size_t i=0; i < bins.size(); ++i )   {
+    count += bins[i];
+    if ( count >= limit )   {
+      double upper = std::pow(2e0, double(i+1)/4e0);
+      return std::max(double(min), std::min(double(max), upper));
+    }
+  }
+  return double(max);
+}
+
+/// Initializing constructor. No-op if the kernel has no profiler
+DigiProfiler::Scope::Scope(const DigiKernel& kernel, const DigiAction* act, std::size_t num_deposits)
+  : profiler(kernel.profiler()), action(act), deposits(num_deposits)
+{
+  if ( profiler ) start = clock_t::now();
+}
+
+/// Default destructor: record the measurement
+DigiProfiler::Scope::~Scope()   {
+  if ( profiler )   {
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - start);
+    profiler->record(action, nanos.count(), deposits);
+  }
+}
+
+/// Default constructor
+DigiProfiler::DigiProfiler() : m_id(++s_profiler_id)  {
+}
+
+/// Default destructor
+DigiProfiler::~DigiProfiler()   {
+  m_tables.clear();
+}
+
+/// Access the statistics table of the current thread
+DigiProfiler::thread_table_t& DigiProfiler::table()   {
+  thread_local std::uint64_t   cache_id    { 0 };
+  thread_local thread_table_t* cache_table { nullptr };
+  if ( cache_id != m_id )   {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_tables.emplace_back(std::make_unique<thread_table_t>());
+    cache_table = m_tables.back().get();
+    cache_id    = m_id;
+  }
+  return *cache_table;
+}
+
+/// Record one single action call
+void DigiProfiler::record(const DigiAction* action, std::uint64_t nanos, std::size_t num_deposits)   {
+  auto& tab = this->table();
+  std::lock_guard<std::mutex> guard(tab.lock);
+  auto iter = tab.actions.find(action);
+  if ( iter == tab.actions.end() )   {
+    iter = tab.actions.emplace(action, statistics_t()).first;
+    iter->second.name = action ? action->name() : std::string("[Unknown]");
+  }
+  iter->second.add(nanos, num_deposits);
+}
+
+/// Merge the statistics of all threads. Result is sorted by total time
+std::vector<DigiProfiler::statistics_t> DigiProfiler::summary()  const   {
+  std::map<std::string, statistics_t> merged;
+  std::vector<statistics_t> result;
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    for( const auto& tab : m_tables )   {
+      std::lock_guard<std::mutex> table_guard(tab->lock);
+      for( const auto& a : tab->actions )
+        merged[a.second.name].merge(a.second);
+    }
+  }
+  result.reserve(merged.size());
+  for( auto& m : merged )
+    result.emplace_back(std::move(m.second));
+  std::sort(result.begin(), result.end(),
+            [](const statistics_t& a, const statistics_t& b) { return a.total > b.total; });
+  return result;
+}
+
+/// Print the summary table using the output of the printing action
+void DigiProfiler::print(const DigiAction& printer)  const   {
+  auto stats = this->summary();
+  printer.always("+++ Profile: %-32s %9s %11s %10s %10s %10s %10s %12s",
+                 "Action", "Calls", "Total[ms]", "Mean[us]", "P50[us]", "P90[us]", "P99[us]", "Deposits");
+  for( const auto& s : stats )   {
+    printer.always("+++ Profile: %-32s %9ld %11.3f %10.2f %10.2f %10.2f %10.2f %12ld",
+                   s.name.c_str(), s.calls, double(s.total)/1e6,
+                   double(s.total)/1e3/double(std::max<std::size_t>(s.calls,1)),
+                   s.percentile(0.50)/1e3, s.percentile(0.90)/1e3, s.percentile(0.99)/1e3,
+                   s.deposits);
+  }
+}
+
+/// Write the summary to file. Extension '.root' writes a TTree, otherwise JSON
+bool DigiProfiler::write(const std::string& file_name)  const   {
+  auto stats = this->summary();
+  std::size_t len = file_name.length();
+  if ( len > 5 && file_name.substr(len-5) == ".root" )   {
+    std::unique_ptr<TFile> file(TFile::Open(file_name.c_str(), "RECREATE"));
+    if ( !file || file->IsZombie() )
+      return false;
+    char     name[256];
+    ULong64_t calls, deposits, total, min, max;
+    Double_t p50, p90, p99;
+    TTree* tree = new TTree("DigiProfile", "DDDigi per-action profile");
+    tree->Branch("name",     name,      "name/C");
+    tree->Branch("calls",    &calls,    "calls/l");
+    tree->Branch("deposits", &deposits, "deposits/l");
+    tree->Branch("total",    &total,    "total/l");
+    tree->Branch("min",      &min,      "min/l");
+    tree->Branch("max",      &max,      "max/l");
+    tree->Branch("p50",      &p50,      "p50/D");
+    tree->Branch("p90",      &p90,      "p90/D");
+    tree->Branch("p99",      &p99,      "p99/D");
+    for( const auto& s : stats )   {
+      ::snprintf(name, sizeof(name), "%s", s.name.c_str());
+      calls = s.calls;
+      deposits = s.deposits;
+      total = s.total;
+      min = s.calls ? s.min : 0;
+      max = s.max;
+      p50 = s.percentile(0.50);
+      p90 = s.percentile(0.90);
+      p99 = s.percentile(0.99);
+      tree->Fill();
+    }
+    file->Write();
+    file->Close();
+    return true;
+  }
+  std::ofstream out(file_name);
+  if ( !out.good() )
+    return false;
+  out << "{\n  \"units\": \"ns\",\n  \"actions\": [";
+  for( std::size_t i=0; i < stats.size(); ++i )   {
+    const auto& s = stats[i];
+    out << (i==0 ? "\n" : ",\n")
+        << "    { \"name\": \""  << s.name << "\""
+        << ", \"calls\": "       << s.calls
+        << ", \"deposits\": "    << s.deposits
+        << ", \"total\": "       << s.total
+        << ", \"min\": "         << (s.calls ? s.min : 0)
+        << ", \"max\": "         << s.max
+        << ", \"p50\": "         << s.percentile(0.50)
+        << ", \"p90\": "         << s.percentile(0.90)
+        << ", \"p99\": "         << s.percentile(0.99)
+        << " }";
+  }
+  out << "\n  ]\n}\n";
+  return out.good();
+}
@@ -243,3 +243,124 @@ void   DigiRandomGenerator::circle(double &x, double &y, double r)   const  {
   x = r*std::cos(phi);
   y = r*std::sin(phi);
 }
+
+/// Access counter based random stream for a given event and stream identifier
+DigiRandomStream DigiRandomGenerator::stream(std::uint64_t event, std::uint32_t stream_id)  const   {
+  return DigiRandomStream(this->seed, event, stream_id);
+}
+
+/// Initializing constructor
+DigiRandomStream::DigiRandomStream(std::uint64_t seed, std::uint64_t event, std::uint32_t stream_id)
+  : m_stream(stream_id)
+{
+  /// Scramble seed and event number to the key: avoids trivial key collisions
+  counter_t k = philox({ std::uint32_t(seed), std::uint32_t(seed>>32),
+                         std::uint32_t(event), std::uint32_t(event>>32) },
+                       { 0xA4093822U, 0x299F31D0U });
+  m_key = { k[0], k[1] };
+}
+
+/// Philox4x32-10 bijection
+DigiRandomStream::counter_t DigiRandomStream::philox(counter_t c, key_t k)   {
+  for( int round = 0; round < 10; ++round )   {
+    std::uint64_t p0 = std::uint64_t(0xD2511F53U) * c[0];
+    std::uint64_t p1 = std::uint64_t(0xCD9E8D57U) * c[2];
+    c = { std::uint32_t(p1 >> 32) ^ c[1] ^ k[0], std::uint32_t(p1),
+          std::uint32_t(p0 >> 32) ^ c[3] ^ k[1], std::uint32_t(p0) };
+    k[0] += 0x9E3779B9U;
+    k[1] += 0xBB67AE85U;
+  }
+  return c;
+}
+
+/// Convert two 32 bit words to a double in the open interval (0, 1)
+double DigiRandomStream::to_uniform(std::uint32_t high, std::uint32_t low)   {
+  std::uint64_t bits = ((std::uint64_t(high) << 32) | low) >> 11;
+  return (double(bits) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+/// Raw random words for a given entry identifier and draw index
+DigiRandomStream::counter_t DigiRandomStream::raw(std::uint64_t identifier, std::uint32_t index)  const   {
+  return philox({ std::uint32_t(identifier), std::uint32_t(identifier>>32), index, m_stream }, m_key);
+}
+
+/// Next uniform random number in the open interval (0, 1)
+double DigiRandomStream::sequence_t::uniform()   {
+  if ( available == 0 )   {
+    buffer = stream.raw(identifier, index++);
+    available = 2;
+  }
+  --available;
+  return available ? to_uniform(buffer[0], buffer[1]) : to_uniform(buffer[2], buffer[3]);
+}
+
+/// Batch API: uniform distribution in [x1, x2]. One value per identifier
+void DigiRandomStream::uniform(const std::uint64_t* ids, std::size_t count, double* values, double x1, double x2)  const   {
+  const double width = x2 - x1;
+  for( std::size_t i = 0; i < count; ++i )   {
+    counter_t r = raw(ids[i], 0);
+    values[i] = x1 + width * to_uniform(r[0], r[1]);
+  }
+}
+
+/// Batch API: uniform distribution for the consecutive identifiers first, first+1, ...
+void DigiRandomStream::uniform(std::uint64_t first, std::size_t count, double* values, double x1, double x2)  const   {
+  const double width = x2 - x1;
+  for( std::size_t i = 0; i < count; ++i )   {
+    counter_t r = raw(first + i, 0);
+    values[i] = x1 + width * to_uniform(r[0], r[1]);
+  }
+}
+
+/// Batch API: gaussian distribution (Box-Muller). One value per identifier
+void DigiRandomStream::gaussian(const std::uint64_t* ids, std::size_t count, double* values, double mean, double sigma)  const   {
+  for( std::size_t i = 0; i < count; ++i )   {
+    counter_t r = raw(ids[i], 0);
+    double u1 = to_uniform(r[0], r[1]);
+    double u2 = to_uniform(r[2], r[3]);
+    values[i] = mean + sigma * std::sqrt(-2.0 * std::log(u1)) * std::cos(TWOPI * u2);
+  }
+}
+
+/// Batch API: gaussian distribution for the consecutive identifiers first, first+1, ...
+void DigiRandomStream::gaussian(std::uint64_t first, std::size_t count, double* values, double mean, double sigma)  const   {
+  for( std::size_t i = 0; i < count; ++i )   {
+    counter_t r = raw(first + i, 0);
+    double u1 = to_uniform(r[0], r[1]);
+    double u2 = to_uniform(r[2], r[3]);
+    values[i] = mean + sigma * std::sqrt(-2.0 * std::log(u1)) * std::cos(TWOPI * u2);
+  }
+}
+
+/// Batch API: exponential distribution. One value per identifier
+void DigiRandomStream::exponential(const std::uint64_t* ids, std::size_t count, double* values, double tau)  const   {
+  for( std::size_t i = 0; i < count; ++i )   {
+    counter_t r = raw(ids[i], 0);
+    values[i] = -tau * std::log(to_uniform(r[0], r[1]));
+  }
+}
+
+/// Batch API: landau distribution. One value per identifier
+void DigiRandomStream::landau(const std::uint64_t* ids, std::size_t count, double* values, double mean, double sigma)  const   {
+  for( std::size_t i = 0; i < count; ++i )   {
+    if ( sigma <= 0 )   {
+      values[i] = 0e0;
+      continue;
+    }
+    counter_t r = raw(ids[i], 0);
+    values[i] = mean + ROOT::Math::landau_quantile(to_uniform(r[0], r[1]), sigma);
+  }
+}
+
+/// Batch API: poisson distribution. One value per identifier
+void DigiRandomStream::poisson(const std::uint64_t* ids, std::size_t count, double* values, double mean)  const   {
+  /// Same algorithms as DigiRandomGenerator::poisson, fed by the per-identifier sequence
+  DigiRandomGenerator generator;
+  sequence_t* sequence = nullptr;
+  generator.engine = [&sequence]()  {  return sequence->uniform();  };
+  for( std::size_t i = 0; i < count; ++i )   {
+    sequence_t seq(*this, ids[i]);
+    sequence  = &seq;
+    values[i] = generator.poisson(mean);
+  }
+}
@@ -17,6 +17,7 @@
 #include <DDDigi/DigiKernel.h>
 #include <DDDigi/DigiContext.h>
 #include <DDDigi/DigiPlugins.h>
+#include <DDDigi/DigiProfiler.h>
 #include <DDDigi/DigiSegmentSplitter.h>
 
 using namespace dd4hep::digi;
@@ -50,6 +51,7 @@ template <> void DigiParallelWorker<DigiContainerProcessor,
 				    DigiContainerProcessor::work_t,
 				    DigiSegmentProcessContext>::execute(void* ptr) const  {
   calldata_t* args  = reinterpret_cast<calldata_t*>(ptr);
+  DigiProfiler::Scope scope(args->environ.context.kernel, action, args->input_size());
   action->execute(args->environ.context, *args, this->options.predicate);
 }
 
@@ -63,6 +65,7 @@ DigiSegmentSplitter::DigiSegmentSplitter(const kernel_t& kernel, const std::stri
   declareProperty("split_by",        m_split_by);
   declareProperty("processor_type",  m_processor_type);
   declareProperty("share_processor", m_share_processor = false);
+  declareProperty("skip_empty",      m_skip_empty = false);
   m_kernel.register_initialize(std::bind(&DigiSegmentSplitter::initialize,this));
   InstanceCount::increment(this);
 }
@@ -161,8 +164,31 @@ void DigiSegmentSplitter::execute(context_t& context, work_t& work, const predic
   unmasked_key.set_item(key.item());
   if ( std::find(m_keys.begin(), m_keys.end(), unmasked_key) != m_keys.end() )   {
     if ( work.has_input() )   {
+      std::set<uint32_t> occupied;
+      if ( m_skip_empty )   {
+	/// Decode the split identifiers once and only call the processors of occupied segments
+	if ( const auto* vec = work.get_input<DepositVector>() )
+	  m_split_context.occupied(*vec, occupied);
+	else if ( const auto* map = work.get_input<DepositMapping>() )
+	  m_split_context.occupied(*map, occupied);
+	else
+	  except("Request to handle unknown data type: %s", work.input_type_name().c_str());
+      }
       info("%s+++ Got hit collection %04X %08X. Prepare processors for %sparallel execution.",
 	   context.event->id(), key.mask(), key.item(), m_parallel ? "" : "NON-");
+      if ( m_skip_empty )   {
+	std::vector<ParallelCall*> calls;
+	auto group = m_workers.get_group();
+	for( auto* w : group.actors() )   {
+	  if ( occupied.find(w->options.predicate.id) != occupied.end() )
+	    calls.emplace_back(w);
+	}
+	debug("%s+++ %ld of %ld segments contain deposits.",
+	      context.event->id(), calls.size(), m_workers.size());
+	if ( !calls.empty() )
+	  m_kernel.submit(context, calls, &work, m_parallel);
+	return;
+      }
       m_kernel.submit(context, m_workers.get_group(), m_workers.size(), &work, m_parallel);
     }
   }
@@ -43,6 +43,52 @@ namespace  {
     for ( const auto& c : de.children() )
       scan_detector(tool, split_by, splits, c.second, new_vid, new_msk);
   }
+
+  /// Decode the split identifiers of a deposit container in blocks of contiguous cell identifiers
+  template <typename CONTAINER, typename HANDLER>
+  void scan_split_ids(const DigiSegmentContext& context, const CONTAINER& deposits, HANDLER handler)   {
+    constexpr std::size_t BLOCK = 256;
+    uint64_t    cells[BLOCK];
+    uint32_t    ids[BLOCK];
+    std::size_t index = 0, fill = 0;
+    for( const auto& dep : deposits )   {
+      cells[fill++] = dep.first;
+      if ( fill == BLOCK )   {
+        context.split_ids(cells, fill, ids);
+        for( std::size_t i = 0; i < fill; ++i ) handler(index++, ids[i]);
+        fill = 0;
+      }
+    }
+    context.split_ids(cells, fill, ids);
+    for( std::size_t i = 0; i < fill; ++i ) handler(index++, ids[i]);
+  }
+
+  template <typename CONTAINER>
+  void split_deposits(const DigiSegmentContext& context, const CONTAINER& deposits,
+                      std::map<uint32_t, std::vector<std::size_t> >& segments)   {
+    std::vector<std::size_t>* last = nullptr;
+    uint32_t last_id = 0;
+    scan_split_ids(context, deposits, [&](std::size_t index, uint32_t id)  {
+      if ( !last || id != last_id )   {
+        last    = &segments[id];
+        last_id = id;
+      }
+      last->emplace_back(index);
+    });
+  }
+
+  template <typename CONTAINER>
+  void occupied_segments(const DigiSegmentContext& context, const CONTAINER& deposits, std::set<uint32_t>& ids)   {
+    bool     have = false;
+    uint32_t last_id = 0;
+    scan_split_ids(context, deposits, [&](std::size_t, uint32_t id)  {
+      if ( !have || id != last_id )   {
+        ids.insert(id);
+        last_id = id;
+        have = true;
+      }
+    });
+  }
 }
 
 /// Split field name
@@ -67,6 +113,28 @@ std::string DigiSegmentContext::identifier(uint32_t id)  const   {
   return str.str();
 }
 
+/// Split a deposit container: deposit indices (in container order) per split identifier
+void DigiSegmentContext::split(const DepositVector& deposits,
+                               std::map<uint32_t, std::vector<std::size_t> >& segments)  const  {
+  split_deposits(*this, deposits, segments);
+}
+
+/// Split a deposit container: deposit indices (in container order) per split identifier
+void DigiSegmentContext::split(const DepositMapping& deposits,
+                               std::map<uint32_t, std::vector<std::size_t> >& segments)  const  {
+  split_deposits(*this, deposits, segments);
+}
+
+/// Collect the split identifiers present in a deposit container
+void DigiSegmentContext::occupied(const DepositVector& deposits, std::set<uint32_t>& ids)  const  {
+  occupied_segments(*this, deposits, ids);
+}
+
+/// Collect the split identifiers present in a deposit container
+void DigiSegmentContext::occupied(const DepositMapping& deposits, std::set<uint32_t>& ids)  const  {
+  occupied_segments(*this, deposits, ids);
+}
+
 /// Initializing constructor
 DigiSegmentationTool::DigiSegmentationTool(Detector& desc)
   : description(desc)
@@ -13,12 +13,19 @@
 
 // Framework include files
 #include <DD4hep/InstanceCount.h>
+#include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiSegmentation.h>
 #include <DDDigi/DigiSignalProcessor.h>
 
 /// Standard constructor
 dd4hep::digi::DigiSignalProcessor::DigiSignalProcessor(const DigiKernel& krnl, const std::string& nam)
   : DigiAction(krnl, nam)
 {
+  /// FNV-1a hash of the name: stable stream identifier independent of the creation order
+  std::uint32_t hash = 2166136261U;
+  for( unsigned char c : nam )
+    hash = (hash ^ c) * 16777619U;
+  m_stream_id = hash;
   InstanceCount::increment(this);
 }
 
@@ -32,3 +39,20 @@ void dd4hep::digi::DigiSignalProcessor::initialize()   {
   m_initialized = true;
 }
 
+
+/// Batch callback: fill one value per cell. Default calls operator() for each cell
+void dd4hep::digi::DigiSignalProcessor::process(DigiCellBatch& batch)  const   {
+  for( std::size_t i = 0; i < batch.size; ++i )   {
+    DigiCellData data;
+    data.signal = batch.signals[i];
+    DigiCellContext cell(batch.context, data);
+    double value = (*this)(cell);
+    batch.values[i] = data.kill ? 0e0 : value;
+  }
+}
+
+/// Access the counter based random stream of this processor for the current event
+dd4hep::digi::DigiRandomStream
+dd4hep::digi::DigiSignalProcessor::random_stream(DigiContext& context)  const   {
+  return context.randomGenerator().stream(context.event->eventNumber, m_stream_id);
+}
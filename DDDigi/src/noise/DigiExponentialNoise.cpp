@@ -36,3 +36,8 @@ DigiExponentialNoise::~DigiExponentialNoise() {
 double DigiExponentialNoise::operator()(DigiCellContext& context)  const  {
   return context.context.randomGenerator().exponential(m_tau);
 }
+
+/// Batch callback: one counter based random number per cell
+void DigiExponentialNoise::process(DigiCellBatch& batch)  const  {
+  random_stream(batch.context).exponential(batch.cells, batch.size, batch.values, m_tau);
+}
@@ -40,3 +40,11 @@ double DigiGaussianNoise::operator()(DigiCellContext& context)  const  {
     return 0;
   return context.context.randomGenerator().gaussian(m_mean,m_sigma);
 }
+
+/// Batch callback: one counter based random number per cell
+void DigiGaussianNoise::process(DigiCellBatch& batch)  const  {
+  random_stream(batch.context).gaussian(batch.cells, batch.size, batch.values, m_mean, m_sigma);
+  for( std::size_t i = 0; i < batch.size; ++i )   {
+    if ( batch.signals[i] < m_cutoff ) batch.values[i] = 0e0;
+  }
+}
@@ -40,3 +40,11 @@ double DigiLandauNoise::operator()(DigiCellContext& context)  const  {
     return 0;
   return context.context.randomGenerator().landau(m_mean,m_sigma);
 }
+
+/// Batch callback: one counter based random number per cell
+void DigiLandauNoise::process(DigiCellBatch& batch)  const  {
+  random_stream(batch.context).landau(batch.cells, batch.size, batch.values, m_mean, m_sigma);
+  for( std::size_t i = 0; i < batch.size; ++i )   {
+    if ( batch.signals[i] < m_cutoff ) batch.values[i] = 0e0;
+  }
+}
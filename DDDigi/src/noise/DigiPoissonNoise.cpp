@@ -39,3 +39,11 @@ double DigiPoissonNoise::operator()(DigiCellContext& context)  const  {
     return 0;
   return context.context.randomGenerator().poisson(m_mean);
 }
+
+/// Batch callback: one counter based random number per cell
+void DigiPoissonNoise::process(DigiCellBatch& batch)  const  {
+  random_stream(batch.context).poisson(batch.cells, batch.size, batch.values, m_mean);
+  for( std::size_t i = 0; i < batch.size; ++i )   {
+    if ( batch.signals[i] >= m_cutoff ) batch.values[i] = 0e0;
+  }
+}
@@ -13,14 +13,22 @@
 
 // Framework include files
 #include <DD4hep/InstanceCount.h>
+#include <DDDigi/DigiContext.h>
 #include <DDDigi/noise/DigiRandomNoise.h>
 
+/// C/C++ include files
+#include <algorithm>
+
 using namespace dd4hep::digi;
 
 /// Standard constructor
 DigiRandomNoise::DigiRandomNoise(const DigiKernel& krnl, const std::string& nam)
   : DigiSignalProcessor(krnl, nam)
 {
+  declareProperty("alpha",    m_alpha);
+  declareProperty("variance", m_variance);
+  declareProperty("poles",    m_poles);
+  declareProperty("history",  m_history);
   InstanceCount::increment(this);
 }
 
@@ -41,3 +49,22 @@ void DigiRandomNoise::initialize()   {
 double DigiRandomNoise::operator()(DigiCellContext& /* context */)  const {
   return 0.0;
 }
+
+/// Batch callback: filter the counter based white noise of each cell along time
+void DigiRandomNoise::process(DigiCellBatch& batch)  const {
+  const std::size_t history = std::max(m_history, std::size_t(1));
+  const auto& random = batch.context.randomGenerator();
+  const std::uint64_t event = batch.context.event->eventNumber;
+  /// The filter carries state: work on a private copy to stay thread safe and reproducible
+  detail::FalphaNoise noise(m_noise);
+  std::vector<DigiRandomStream> streams;
+  std::vector<double> white(history);
+  streams.reserve(history);
+  for( std::size_t k = 0; k < history; ++k )
+    streams.emplace_back(random.stream(event + k + 1 - history, m_stream_id));
+  for( std::size_t i = 0; i < batch.size; ++i )   {
+    for( std::size_t k = 0; k < history; ++k )
+      streams[k].gaussian(&batch.cells[i], 1, &white[k], 0e0, noise.variance());
+    batch.values[i] = noise.filter(white.data(), history);
+  }
+}
@@ -19,6 +19,8 @@
 
 // C/C++ include files
 #include <stdexcept>
+#include <algorithm>
+#include <vector>
 
 using namespace dd4hep::digi;
 
@@ -63,3 +65,16 @@ double DigiSignalProcessorSequence::operator()(DigiCellContext& context)  const
   }
   return context.data.kill ? 0e0 : result;
 }
+
+/// Batch callback: sum of the signals and the values of all actors
+void DigiSignalProcessorSequence::process(DigiCellBatch& batch)  const   {
+  std::vector<double> values(batch.size, 0e0);
+  DigiCellBatch actor_batch(batch.context, batch.size, batch.cells, batch.signals, values.data());
+  std::copy(batch.signals, batch.signals + batch.size, batch.values);
+  auto group = m_actors.get_group();
+  for ( const auto* p : group.actors() )  {
+    p->action->process(actor_batch);
+    for( std::size_t i = 0; i < batch.size; ++i )
+      batch.values[i] += values[i];
+  }
+}
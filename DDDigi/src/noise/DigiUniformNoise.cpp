@@ -36,3 +36,8 @@ DigiUniformNoise::~DigiUniformNoise() {
 double DigiUniformNoise::operator()(DigiCellContext& context)  const  {
   return context.context.randomGenerator().uniform(m_min,m_max);
 }
+
+/// Batch callback: one counter based random number per cell
+void DigiUniformNoise::process(DigiCellBatch& batch)  const  {
+  random_stream(batch.context).uniform(batch.cells, batch.size, batch.values, m_min, m_max);
+}
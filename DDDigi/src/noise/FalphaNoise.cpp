@@ -16,6 +16,7 @@
 
 /// C/C++ include files
 #include <cmath>
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
@@ -422,3 +423,12 @@ double FalphaNoise::compute(double rndm_value)   {
   return rndm_value;
 #endif
 }
+
+/// Filter the time ordered gaussian white noise samples of one single channel
+double FalphaNoise::filter(const double* white, size_t count)   {
+  double value = 0e0;
+  std::fill(m_values.begin(), m_values.end(), 0e0);
+  for ( size_t i=0; i < count; ++i )
+    value = compute(white[i]);
+  return value;
+}
@@ -17,6 +17,9 @@
 #include <DD4hep/Printout.h>
 #include <DDG4/Geant4Mapping.h>
 
+// Forward declarations
+class G4TessellatedSolid;
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -59,6 +62,17 @@ namespace dd4hep {
       bool       checkOverlaps = true;
       /// Property: Output level for debug printing
       PrintLevel outputLevel = INFO;
+      /// Property: Number of threads to close (voxelize) tessellated solids
+      int        numThreads  = 1;
+
+    protected:
+      /// Tessellated solids, which still have to be closed
+      mutable std::vector<G4TessellatedSolid*> m_openSolids;
+
+      /// Close all pending tessellated solids using the requested number of threads
+      void closeSolids()  const;
+
+    public:
 
       /// Initializing Constructor
       Geant4Converter(const Detector& description);
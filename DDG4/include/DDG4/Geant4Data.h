@@ -151,6 +151,8 @@ namespace dd4hep {
         float  x = 0.0, y = 0.0, z = 0.0;
         /// Proper particle momentum when generating the hit of the contributing particle
         float  px = 0.0, py = 0.0, pz = 0.0;
+        /// Statistical weight of the contributing track (event generator or biasing)
+        double weight = 1.0;
 
         /// Default constructor
         MonteCarloContrib() = default;
@@ -193,6 +195,7 @@ namespace dd4hep {
           x = y = z = 0.0;
           px = py = pz = 0.0;
           time  = deposit = length = 0.0;
+          weight = 1.0;
           pdgID = trackID = -1;
         }
 	/// Access position
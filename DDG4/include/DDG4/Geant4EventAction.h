@@ -129,6 +129,10 @@ namespace dd4hep {
       CallbackSequence m_end;
       /// Callback sequence for event finalization action
       CallbackSequence m_final;
+      /// Callback sequence for sub-event initialization action (sub-event parallel mode)
+      CallbackSequence m_beginSub;
+      /// Callback sequence for sub-event finalization action (sub-event parallel mode)
+      CallbackSequence m_endSub;
       /// The list of action objects to be called
       Actors<Geant4EventAction> m_actors;
       
@@ -162,12 +166,26 @@ namespace dd4hep {
       void callAtFinal(Q* p, void (T::*f)(const G4Event*)) {
         m_final.add(p, f);
       }
+      /// Register begin-of-sub-event callback (sub-event parallel mode)
+      template <typename Q, typename T>
+      void callAtSubEventBegin(Q* p, void (T::*f)(const G4Event*)) {
+        m_beginSub.add(p, f);
+      }
+      /// Register end-of-sub-event callback (sub-event parallel mode)
+      template <typename Q, typename T>
+      void callAtSubEventEnd(Q* p, void (T::*f)(const G4Event*)) {
+        m_endSub.add(p, f);
+      }
       /// Add an actor responding to all callbacks. Sequence takes ownership.
       void adopt(Geant4EventAction* action);
       /// Begin-of-event callback
       virtual void begin(const G4Event* event);
       /// End-of-event callback
       virtual void end(const G4Event* event);
+      /// Begin-of-sub-event callback. Only the registered callbacks are called.
+      virtual void beginSubEvent(const G4Event* event);
+      /// End-of-sub-event callback. Only the registered callbacks are called.
+      virtual void endSubEvent(const G4Event* event);
     };
 
   }    // End namespace sim
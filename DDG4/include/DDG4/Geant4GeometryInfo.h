@@ -25,6 +25,7 @@
 // C/C++ include files
 #include <map>
 #include <vector>
+#include <unordered_map>
 #include <cstdint>
 
 // Forward declarations (TGeo)
@@ -131,7 +132,7 @@ namespace dd4hep {
       std::map<Region,           G4Region*>                    g4Regions;
       std::map<VisAttr,          G4VisAttributes*>             g4Vis;
       std::map<LimitSet,         G4UserLimits*>                g4Limits;
-      std::map<uint64_t,         Placement>                    g4Paths;
+      std::unordered_map<uint64_t, Placement>                  g4Paths;
       std::map<SensitiveDetector,std::set<const TGeoVolume*> > sensitives;
       std::map<Region,           std::set<const TGeoVolume*> > regions;
       std::map<LimitSet,         std::set<const TGeoVolume*> > limits;
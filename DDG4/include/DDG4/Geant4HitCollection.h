@@ -381,6 +381,8 @@ namespace dd4hep {
       }
       /// Release all hits from the Geant4 container. Ownership stays with the container
       void getHitsUnchecked(std::vector<void*>& result);
+      /// Move all hits of a collection of the same type to this container. Ownership is transferred.
+      void merge(Geant4HitCollection& source, int track_offset = 0);
     };
 
 
@@ -134,6 +134,8 @@ namespace dd4hep {
       double time       { 0E0 };
       /// Proper time
       double properTime { 0E0 };
+      /// Statistical weight (event generator or biasing)
+      double weight     { 1E0 };
       /// The list of parents of this MC particle
       Particles parents;
       /// The list of daughters of this MC particle
@@ -357,6 +359,8 @@ namespace dd4hep {
       void clear();
       /// Adopt particle maps
       void adopt(ParticleMap& pm, TrackEquivalents& equiv);
+      /// Merge the particles of a sub-event. Ownership is transferred.
+      void merge(Geant4ParticleMap& sub, int track_offset);
       /// Access the particle map
       const ParticleMap& particles() const  {  return particleMap; }
       /// Access the map of track equivalents
@@ -29,6 +29,9 @@
 #include <DDG4/Geant4GeneratorAction.h>
 #include <DDG4/Geant4MonteCarloTruth.h>
 
+// C/C++ include files
+#include <set>
+
 // Forward declarations
 class G4Step;
 class G4Track;
@@ -124,6 +127,10 @@ namespace dd4hep {
       bool              m_haveSuspended = false;
       /// Map associating the G4Track identifiers with identifiers of existing MCParticles
       TrackEquivalents  m_equivalentTracks;
+      /// Sub-event parallel mode: flag if a sub-event is processed
+      bool              m_subEvent = false;
+      /// Sub-event parallel mode: tracks created, but not yet tracked in the current sub-event
+      std::set<const G4Track*> m_subEventSecondaries;
 
       /// Recombine particles and associate the to parents with cleanup
       int recombineParents();
@@ -155,6 +162,10 @@ namespace dd4hep {
       virtual void beginEvent(const G4Event* event);
       /// Post-event action callback
       virtual void endEvent(const G4Event* event);
+      /// Pre-sub-event action callback (sub-event parallel mode)
+      virtual void beginSubEvent(const G4Event* event);
+      /// Post-sub-event action callback (sub-event parallel mode)
+      virtual void endSubEvent(const G4Event* event);
       /// Pre-track action callback
       virtual void begin(const G4Track* track);
       /// Post-track action callback
@@ -0,0 +1,151 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDG4_GEANT4SHOWERLIBRARY_H
+#define DDG4_GEANT4SHOWERLIBRARY_H
+
+// C/C++ include files
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Library of pre-simulated (frozen) showers for the fast simulation
+    /**
+     *  Showers are indexed by the energy of the incident particle (logarithmic bins),
+     *  the angle of its direction to the z-axis of the envelope and the depth of the
+     *  starting point along this axis. If a depth period (e.g. the layer pitch) is
+     *  given, the depth is taken modulo the period, i.e. it is the position within
+     *  the layer.
+     *
+     *  Each shower is a list of energy spots in the shower frame: z along the
+     *  direction of the incident particle, x and y transverse, with the energy as
+     *  fraction of the incident energy.
+     *
+     *  The library file is mapped read-only into memory: all threads share the
+     *  same pages and opening is independent of the library size.
+     *  Libraries are filled in memory with add() and written with save().
+     *
+     *  File layout (native byte order):
+     *  Header | Bin[nEnergy*nTheta*nDepth] | Shower[numShowers] | Spot[numSpots]
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4ShowerLibrary  {
+    public:
+      /// Binning of the library
+      struct Binning  {
+        double        energyMin    { 0e0 };
+        double        energyMax    { 0e0 };
+        double        thetaMax     { 0e0 };
+        double        depthMin     { 0e0 };
+        double        depthMax     { 0e0 };
+        double        depthPeriod  { 0e0 };
+        std::uint32_t numEnergy    { 1 };
+        std::uint32_t numTheta     { 1 };
+        std::uint32_t numDepth     { 1 };
+      };
+      /// Energy spot in the shower frame
+      struct Spot  {
+        float x, y, z;
+        /// Fraction of the incident energy
+        float energy;
+      };
+      /// Shower entry: spots [first, first+count)
+      struct Shower  {
+        std::uint64_t first;
+        std::uint32_t count;
+        /// Energy of the incident particle
+        float         energy;
+      };
+      /// Bin entry: showers [first, first+count)
+      struct Bin  {
+        std::uint64_t first;
+        std::uint64_t count;
+      };
+
+    protected:
+      /// Library binning
+      Binning                 m_binning     { };
+      /// Start of the mapped file
+      void*                   m_map         { nullptr };
+      /// Size of the mapped file
+      std::size_t             m_mapSize     { 0 };
+      /// Mapped tables
+      const Bin*              m_bins        { nullptr };
+      const Shower*           m_showers     { nullptr };
+      const Spot*             m_spots       { nullptr };
+      std::uint64_t           m_numShowers  { 0 };
+      std::uint64_t           m_numSpots    { 0 };
+      /// Showers added in memory, per bin
+      std::vector<std::vector<std::pair<float, std::vector<Spot> > > > m_pending { };
+
+      /// Check and apply a binning
+      void setBinning(const Binning& binning);
+
+    public:
+      /// Default constructor
+      Geant4ShowerLibrary() = default;
+      /// Initializing constructor to fill a new library
+      Geant4ShowerLibrary(const Binning& binning);
+      /// No copy constructor
+      Geant4ShowerLibrary(const Geant4ShowerLibrary& copy) = delete;
+      /// No assignment
+      Geant4ShowerLibrary& operator=(const Geant4ShowerLibrary& copy) = delete;
+      /// Default destructor. Unmaps the library file
+      ~Geant4ShowerLibrary();
+
+      /// Map a library file read-only into memory
+      void open(const std::string& file_name);
+      /// Unmap the library file
+      void close();
+      /// Check if a library file is mapped
+      bool isOpen()  const                   {  return m_map != nullptr;  }
+      /// Access the binning
+      const Binning& binning()  const        {  return m_binning;         }
+      /// Total number of bins
+      std::size_t numBins()  const
+      {  return std::size_t(m_binning.numEnergy) * m_binning.numTheta * m_binning.numDepth;  }
+      /// Total number of mapped showers
+      std::uint64_t numShowers()  const      {  return m_numShowers;      }
+      /// Total number of mapped spots
+      std::uint64_t numSpots()  const        {  return m_numSpots;        }
+
+      /// Bin index of a shower. Returns -1 if outside the library range
+      long bin(double energy, double theta, double depth)  const;
+      /// Number of mapped showers in a bin
+      std::size_t numShowers(long bin)  const
+      {  return bin < 0 || !m_bins ? 0 : std::size_t(m_bins[bin].count);  }
+      /// Access mapped shower i of a bin
+      const Shower& shower(long bin, std::size_t i)  const
+      {  return m_showers[m_bins[bin].first + i];  }
+      /// Access the spots of a mapped shower
+      const Spot* spots(const Shower& s)  const
+      {  return m_spots + s.first;  }
+
+      /// Add a new shower to the library in memory. Returns false if outside the library range
+      bool add(double energy, double theta, double depth, std::vector<Spot>&& spots);
+      /// Number of showers added in memory
+      std::size_t numPending()  const;
+      /// Write the showers added in memory to file
+      void save(const std::string& file_name)  const;
+    };
+  }    // End namespace sim
+}      // End namespace dd4hep
+#endif // DDG4_GEANT4SHOWERLIBRARY_H
@@ -109,6 +109,10 @@ namespace dd4hep {
       const G4ThreeVector& vertex() const {
         return track->GetVertexPosition();
       }
+      /// Track statistical weight
+      double weight() const  {
+        return track->GetWeight();
+      }
       /// Track global time
       double globalTime() const  {
         return track->GetGlobalTime();
@@ -60,6 +60,8 @@ namespace dd4hep {
 
       /// Property: Printout level of info object
       int  m_geoInfoPrintLevel;
+      /// Property: Number of threads to close tessellated solids
+      int  m_numThreads             = 1;
       /// Property: G4 GDML dump file name (default: empty. If non empty, dump)
       std::string m_dumpGDML;
 
@@ -146,6 +148,7 @@ Geant4DetectorGeometryConstruction::Geant4DetectorGeometryConstruction(Geant4Con
   declareProperty("PrintPlacements",   m_printPlacements);
   declareProperty("PrintSensitives",   m_printSensitives);
   declareProperty("GeoInfoPrintLevel", m_geoInfoPrintLevel = DEBUG);
+  declareProperty("NumThreads",        m_numThreads);
 
   declareProperty("DumpHierarchy",     m_dumpHierarchy);
   declareProperty("DumpGDML",          m_dumpGDML="");
@@ -173,6 +176,7 @@ void Geant4DetectorGeometryConstruction::constructGeo(Geant4DetectorConstruction
   conv.debugLimits      = m_debugLimits;
   conv.printPlacements  = m_printPlacements;
   conv.printSensitives  = m_printSensitives;
+  conv.numThreads       = m_numThreads;
 
   ctxt->geometry = conv.create(world).detach();
   ctxt->geometry->printLevel = outputLevel();
@@ -0,0 +1,329 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDG4_GEANT4IMPORTANCEBIASING_H
+#define DDG4_GEANT4IMPORTANCEBIASING_H
+
+// Framework include files
+#include <DDG4/Geant4SteppingAction.h>
+#include <DDG4/Geant4StackingAction.h>
+
+// C/C++ include files
+#include <map>
+#include <set>
+#include <vector>
+
+// Forward declarations
+class G4Region;
+class G4ParticleDefinition;
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim   {
+
+    /// Base class to select the particles and regions of biasing actions
+    /**
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4BiasingSelection  {
+    protected:
+      /// Property: Names of the biased particles. Empty: all particles
+      std::vector<std::string>                   m_particleNames  { };
+      /// Resolved particle definitions
+      std::set<const G4ParticleDefinition*>      m_particles      { };
+      /// Flag to resolve names at the first call
+      bool                                       m_resolved       { false };
+
+      /// Resolve particle names to definitions
+      void resolveParticles(const Geant4Action* action);
+      /// Check if a particle is biased
+      bool applicable(const G4ParticleDefinition* def)  const  {
+        return m_particles.empty() || m_particles.find(def) != m_particles.end();
+      }
+      /// Access a region by name
+      static G4Region* region(const Geant4Action* action, const std::string& name);
+    };
+
+    /// Importance sampling by region: geometry splitting and Russian roulette
+    /**
+     *  Each region is assigned an importance (property 'Importance', regions
+     *  not listed have 'DefaultImportance'). When a track crosses from a region
+     *  of importance I1 into a region of importance I2:
+     *
+     *  - I2 > I1: the track is split into r = I2/I1 tracks (at most 'MaxSplit')
+     *    of weight w/r. Fractional ratios are sampled, so that the expected
+     *    number of tracks is r.
+     *  - I2 < I1: Russian roulette. The track survives with probability I2/I1
+     *    and its weight is increased to w*I1/I2. Otherwise it is killed.
+     *  - I2 = 0:  the track is killed.
+     *
+     *  The copies are handed to Geant4 as secondaries of the split track and
+     *  tracked once the track is finished. Weights are available from
+     *  Geant4Particle::weight and the hit contributions.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4ImportanceBiasing : public Geant4SteppingAction, public Geant4BiasingSelection  {
+    protected:
+      /// Property: Importance by region name
+      std::map<std::string, double>              m_importanceNames   { };
+      /// Property: Importance of regions not listed
+      double                                     m_defaultImportance { 1e0 };
+      /// Property: Maximal number of tracks one track is split into
+      int                                        m_maxSplit          { 100 };
+      /// Resolved importance by region
+      std::map<const G4Region*, double>          m_importance        { };
+      /// Statistics
+      std::size_t m_numSplit { 0 }, m_numCopies { 0 }, m_numSurvived { 0 }, m_numKilled { 0 };
+
+      /// Importance of a region
+      double importance(const G4Region* region)  const   {
+        auto i = m_importance.find(region);
+        return i == m_importance.end() ? m_defaultImportance : i->second;
+      }
+
+    public:
+      /// Standard constructor
+      Geant4ImportanceBiasing(Geant4Context* context, const std::string& name);
+      /// Default destructor
+      virtual ~Geant4ImportanceBiasing();
+      /// User stepping callback
+      virtual void operator()(const G4Step* step, G4SteppingManager* mgr)  override;
+    };
+
+    /// Russian roulette of low energy secondaries at stacking time
+    /**
+     *  New secondaries of the selected particles with a kinetic energy below
+     *  'EnergyThreshold' survive with probability 'SurvivalProbability'. The
+     *  weight of surviving tracks is divided by this probability. If 'Regions'
+     *  is not empty, only secondaries created in these regions are rouletted.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4RussianRouletteStacking : public Geant4StackingAction, public Geant4BiasingSelection  {
+    protected:
+      /// Property: Kinetic energy below which secondaries are rouletted
+      double                                     m_energyThreshold { 0e0 };
+      /// Property: Survival probability
+      double                                     m_survival        { 1e0 };
+      /// Property: Names of the regions. Empty: everywhere
+      std::vector<std::string>                   m_regionNames     { };
+      /// Resolved regions
+      std::set<const G4Region*>                  m_regions         { };
+      /// Statistics
+      std::size_t m_numSurvived { 0 }, m_numKilled { 0 };
+
+    public:
+      /// Standard constructor
+      Geant4RussianRouletteStacking(Geant4Context* context, const std::string& name);
+      /// Default destructor
+      virtual ~Geant4RussianRouletteStacking();
+      /// Return TrackClassification with enum G4ClassificationOfNewTrack or NoTrackClassification
+      virtual TrackClassification
+      classifyNewTrack(G4StackManager* stackManager, const G4Track* track)  override;
+    };
+  }
+}
+#endif // DDG4_GEANT4IMPORTANCEBIASING_H
+
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/InstanceCount.h>
+#include <DDG4/Geant4Random.h>
+#include <DDG4/Geant4Context.h>
+
+// Geant4 include files
+#include <G4Step.hh>
+#include <G4Track.hh>
+#include <G4Region.hh>
+#include <G4RegionStore.hh>
+#include <G4LogicalVolume.hh>
+#include <G4ParticleTable.hh>
+#include <G4DynamicParticle.hh>
+#include <G4SteppingManager.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4SystemOfUnits.hh>
+
+// C/C++ include files
+#include <algorithm>
+
+using namespace dd4hep::sim;
+
+#include <DDG4/Factories.h>
+DECLARE_GEANT4ACTION(Geant4ImportanceBiasing)
+DECLARE_GEANT4ACTION(Geant4RussianRouletteStacking)
+
+/// Resolve particle names to definitions
+void Geant4BiasingSelection::resolveParticles(const Geant4Action* action)   {
+  G4ParticleTable* table = G4ParticleTable::GetParticleTable();
+  for( const auto& nam : m_particleNames )   {
+    const G4ParticleDefinition* def = table->FindParticle(nam);
+    if ( !def )   {
+      action->except("+++ Unknown particle: %s", nam.c_str());
+    }
+    m_particles.insert(def);
+  }
+  m_resolved = true;
+}
+
+/// Access a region by name
+G4Region* Geant4BiasingSelection::region(const Geant4Action* action, const std::string& name)   {
+  G4Region* reg = G4RegionStore::GetInstance()->GetRegion(name, false);
+  if ( !reg )   {
+    action->except("+++ Unknown region: %s", name.c_str());
+  }
+  return reg;
+}
+
+/// Standard constructor
+Geant4ImportanceBiasing::Geant4ImportanceBiasing(Geant4Context* ctxt, const std::string& nam)
+  : Geant4SteppingAction(ctxt,nam)
+{
+  declareProperty("Importance",        m_importanceNames);
+  declareProperty("DefaultImportance", m_defaultImportance);
+  declareProperty("MaxSplit",          m_maxSplit);
+  declareProperty("Particles",         m_particleNames);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4ImportanceBiasing::~Geant4ImportanceBiasing() {
+  info("+++ Tracks split: %ld into %ld copies. Roulette: %ld survived, %ld killed.",
+       long(m_numSplit), long(m_numCopies), long(m_numSurvived), long(m_numKilled));
+  InstanceCount::decrement(this);
+}
+
+/// User stepping callback
+void Geant4ImportanceBiasing::operator()(const G4Step* step, G4SteppingManager* mgr) {
+  if ( !m_resolved )  {
+    for( const auto& imp : m_importanceNames )   {
+      if ( imp.second < 0e0 )
+        except("+++ Negative importance %g of region %s", imp.second, imp.first.c_str());
+      m_importance[region(this, imp.first)] = imp.second;
+    }
+    resolveParticles(this);
+  }
+  const G4StepPoint* post = step->GetPostStepPoint();
+  const G4VPhysicalVolume* pv = post->GetPhysicalVolume();
+  if ( post->GetStepStatus() != fGeomBoundary || !pv )
+    return;
+  G4Track* track = step->GetTrack();
+  if ( track->GetTrackStatus() != fAlive || !applicable(track->GetDefinition()) )
+    return;
+
+  const G4Region* pre_region  = step->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume()->GetRegion();
+  const G4Region* post_region = pv->GetLogicalVolume()->GetRegion();
+  if ( pre_region == post_region )
+    return;
+  double imp_pre  = importance(pre_region);
+  double imp_post = importance(post_region);
+  if ( imp_pre == imp_post || imp_pre <= 0e0 )
+    return;
+  Geant4Random& rndm   = context()->event().random();
+  double        ratio  = imp_post / imp_pre;
+  double        weight = track->GetWeight();
+  if ( ratio < 1e0 )   {
+    /// Russian roulette
+    if ( ratio > 0e0 && rndm.rndm() < ratio )   {
+      track->SetWeight(weight / ratio);
+      ++m_numSurvived;
+      return;
+    }
+    track->SetTrackStatus(fStopAndKill);
+    ++m_numKilled;
+    return;
+  }
+  /// Splitting: the expected number of tracks is the (limited) importance ratio
+  ratio = std::min(ratio, double(m_maxSplit));
+  int num = int(ratio);
+  if ( rndm.rndm() < ratio - double(num) ) ++num;
+  track->SetWeight(weight / ratio);
+  /// The copies are new secondaries: they must not carry the link to the primary particle
+  const G4DynamicParticle* dyn = track->GetDynamicParticle();
+  for( int i = 1; i < num; ++i )   {
+    G4Track* copy = new G4Track(new G4DynamicParticle(dyn->GetDefinition(), dyn->GetMomentum()),
+                                post->GetGlobalTime(), post->GetPosition());
+    copy->SetWeight(weight / ratio);
+    copy->SetParentID(track->GetTrackID());
+    copy->SetTouchableHandle(post->GetTouchableHandle());
+    mgr->GetfSecondary()->push_back(copy);
+  }
+  ++m_numSplit;
+  m_numCopies += num - 1;
+}
+
+/// Standard constructor
+Geant4RussianRouletteStacking::Geant4RussianRouletteStacking(Geant4Context* ctxt, const std::string& nam)
+  : Geant4StackingAction(ctxt,nam)
+{
+  declareProperty("EnergyThreshold",     m_energyThreshold);
+  declareProperty("SurvivalProbability", m_survival);
+  declareProperty("Regions",             m_regionNames);
+  declareProperty("Particles",           m_particleNames);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4RussianRouletteStacking::~Geant4RussianRouletteStacking() {
+  info("+++ Roulette below %g MeV: %ld survived, %ld killed.",
+       m_energyThreshold/CLHEP::MeV, long(m_numSurvived), long(m_numKilled));
+  InstanceCount::decrement(this);
+}
+
+/// Return TrackClassification with enum G4ClassificationOfNewTrack or NoTrackClassification
+TrackClassification
+Geant4RussianRouletteStacking::classifyNewTrack(G4StackManager* /* manager */, const G4Track* track)   {
+  if ( !m_resolved )  {
+    if ( !(m_survival > 0e0 && m_survival <= 1e0) )
+      except("+++ Invalid survival probability: %g", m_survival);
+    for( const auto& nam : m_regionNames )
+      m_regions.insert(region(this, nam));
+    resolveParticles(this);
+  }
+  if ( track->GetParentID() == 0 || track->GetKineticEnergy() >= m_energyThreshold )
+    return {};
+  if ( !applicable(track->GetDefinition()) )
+    return {};
+  if ( !m_regions.empty() )   {
+    const G4VPhysicalVolume* pv = track->GetVolume();
+    if ( !pv || m_regions.find(pv->GetLogicalVolume()->GetRegion()) == m_regions.end() )
+      return {};
+  }
+  if ( context()->event().random().rndm() < m_survival )   {
+    /// The weight is not part of the track classification: adjust it in place
+    const_cast<G4Track*>(track)->SetWeight(track->GetWeight() / m_survival);
+    ++m_numSurvived;
+    return {};
+  }
+  ++m_numKilled;
+  return { fKill };
+}
@@ -0,0 +1,302 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDG4_GEANT4REGIONSTACKINGACTION_H
+#define DDG4_GEANT4REGIONSTACKINGACTION_H
+
+// Framework include files
+#include <DDG4/Geant4StackingAction.h>
+
+// C/C++ include files
+#include <map>
+#include <set>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+// Forward declarations
+class G4Run;
+class G4Event;
+class G4Region;
+class G4Navigator;
+class G4ParticleDefinition;
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim   {
+
+    /// Stacking action to kill or postpone new tracks by region, energy, particle type and time
+    /**
+     *  New tracks are classified by the region of their starting point:
+     *
+     *  - 'KillParticles': tracks of these particle types are killed everywhere.
+     *  - 'TimeCut':       tracks created later than this global time are killed (0: no cut).
+     *  - 'KillEnergy':    tracks with kinetic energy below the threshold of their region are killed.
+     *  - 'StackLevel':    tracks of a region are pushed to the stack of the given level:
+     *                     0 is the urgent stack, 1 the waiting stack, 2..11 the additional
+     *                     waiting stacks. Higher levels are tracked later.
+     *
+     *  Primary particles are never killed. The names of regions are those of the
+     *  compact description, e.g. 'Downstream' of SHiPCalo.xml. The Geant4 world
+     *  region is 'DefaultRegionForTheWorld'.
+     *
+     *  At the end of the run the counters per region are printed together with
+     *  the CPU time estimated to be saved: number of killed tracks times the
+     *  average CPU time per tracked track.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4RegionStackingAction : public Geant4StackingAction  {
+    protected:
+      /// Counters of one region
+      struct Counters  {
+        std::size_t tracks         { 0 };
+        std::size_t killedParticle { 0 };
+        std::size_t killedTime     { 0 };
+        std::size_t killedEnergy   { 0 };
+        std::size_t postponed      { 0 };
+        double      energyKilled   { 0e0 };
+      };
+      /// Property: Particles to be killed everywhere
+      std::vector<std::string>               m_killParticleNames { };
+      /// Property: Kinetic energy threshold by region
+      std::map<std::string, double>          m_killEnergyNames   { };
+      /// Property: Stack level by region
+      std::map<std::string, int>             m_stackLevelNames   { };
+      /// Property: Global time after which new tracks are killed
+      double                                 m_timeCut           { 0e0 };
+
+      /// Resolved configuration
+      std::set<const G4ParticleDefinition*>  m_killParticles     { };
+      std::map<const G4Region*, double>      m_killEnergy        { };
+      std::map<const G4Region*, int>         m_stackLevel        { };
+      bool                                   m_resolved          { false };
+      /// Navigator to locate primary tracks, which have no touchable yet
+      std::unique_ptr<G4Navigator>           m_navigator         { };
+
+      /// Statistics by region
+      std::map<const G4Region*, Counters>    m_counters          { };
+      /// Number of tracked tracks and CPU time of all events [nanoseconds]
+      std::size_t                            m_numTracked        { 0 };
+      std::uint64_t                          m_cpuEvents         { 0 };
+      std::uint64_t                          m_cpuStart          { 0 };
+
+      /// Resolve names to Geant4 objects
+      void resolve(G4StackManager* stack_manager);
+      /// Region of the starting point of a new track
+      const G4Region* region(const G4Track* track);
+
+    public:
+      /// Standard constructor
+      Geant4RegionStackingAction(Geant4Context* context, const std::string& name);
+      /// Default destructor
+      virtual ~Geant4RegionStackingAction();
+      /// Preparation callback
+      virtual void prepare(G4StackManager* stackManager)  override;
+      /// Return TrackClassification with enum G4ClassificationOfNewTrack or NoTrackClassification
+      virtual TrackClassification
+      classifyNewTrack(G4StackManager* stackManager, const G4Track* track)  override;
+      /// Registered callback on Begin-event: start the CPU clock
+      void beginEvent(const G4Event* event);
+      /// Registered callback on End-event: stop the CPU clock
+      void endEvent(const G4Event* event);
+      /// Registered callback on End-run: print the statistics
+      void endRun(const G4Run* run);
+    };
+  }
+}
+#endif // DDG4_GEANT4REGIONSTACKINGACTION_H
+
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/InstanceCount.h>
+#include <DDG4/Geant4RunAction.h>
+#include <DDG4/Geant4EventAction.h>
+
+// Geant4 include files
+#include <G4Track.hh>
+#include <G4Region.hh>
+#include <G4Navigator.hh>
+#include <G4RegionStore.hh>
+#include <G4StackManager.hh>
+#include <G4LogicalVolume.hh>
+#include <G4ParticleTable.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4TransportationManager.hh>
+
+// C/C++ include files
+#include <ctime>
+#include <algorithm>
+
+using namespace dd4hep::sim;
+
+#include <DDG4/Factories.h>
+DECLARE_GEANT4ACTION(Geant4RegionStackingAction)
+
+namespace  {
+  /// CPU time of the calling thread in nanoseconds
+  std::uint64_t thread_cpu_time()   {
+    struct timespec ts;
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::uint64_t(ts.tv_sec) * 1000000000ULL + std::uint64_t(ts.tv_nsec);
+  }
+  /// Highest stack level: urgent, waiting and 10 additional waiting stacks
+  constexpr int MAX_STACK_LEVEL = 11;
+}
+
+/// Standard constructor
+Geant4RegionStackingAction::Geant4RegionStackingAction(Geant4Context* ctxt, const std::string& nam)
+  : Geant4StackingAction(ctxt,nam)
+{
+  declareProperty("KillParticles", m_killParticleNames);
+  declareProperty("KillEnergy",    m_killEnergyNames);
+  declareProperty("StackLevel",    m_stackLevelNames);
+  declareProperty("TimeCut",       m_timeCut);
+  eventAction().callAtBegin(this,&Geant4RegionStackingAction::beginEvent);
+  eventAction().callAtEnd(this,&Geant4RegionStackingAction::endEvent);
+  runAction().callAtEnd(this,&Geant4RegionStackingAction::endRun);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4RegionStackingAction::~Geant4RegionStackingAction() {
+  InstanceCount::decrement(this);
+}
+
+/// Resolve names to Geant4 objects
+void Geant4RegionStackingAction::resolve(G4StackManager* stack_manager)   {
+  G4RegionStore*   regions = G4RegionStore::GetInstance();
+  G4ParticleTable* table   = G4ParticleTable::GetParticleTable();
+  auto get_region = [this, regions](const std::string& nam)  {
+    const G4Region* reg = regions->GetRegion(nam, false);
+    if ( !reg ) except("+++ Unknown region: %s", nam.c_str());
+    return reg;
+  };
+  for( const auto& nam : m_killParticleNames )   {
+    const G4ParticleDefinition* def = table->FindParticle(nam);
+    if ( !def ) except("+++ Unknown particle: %s", nam.c_str());
+    m_killParticles.insert(def);
+  }
+  for( const auto& e : m_killEnergyNames )
+    m_killEnergy[get_region(e.first)] = e.second;
+  int max_level = 0;
+  for( const auto& l : m_stackLevelNames )   {
+    if ( l.second < 0 || l.second > MAX_STACK_LEVEL )
+      except("+++ Invalid stack level %d of region %s [0..%d]", l.second, l.first.c_str(), MAX_STACK_LEVEL);
+    m_stackLevel[get_region(l.first)] = l.second;
+    max_level = std::max(max_level, l.second);
+  }
+  if ( max_level > 1 && stack_manager )   {
+    stack_manager->SetNumberOfAdditionalWaitingStacks(max_level - 1);
+  }
+  m_resolved = true;
+}
+
+/// Region of the starting point of a new track
+const G4Region* Geant4RegionStackingAction::region(const G4Track* track)   {
+  const G4VPhysicalVolume* pv = track->GetVolume();
+  if ( !pv )   {
+    if ( !m_navigator )   {
+      G4Navigator* nav = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+      m_navigator = std::make_unique<G4Navigator>();
+      m_navigator->SetWorldVolume(nav->GetWorldVolume());
+    }
+    pv = m_navigator->LocateGlobalPointAndSetup(track->GetPosition(), nullptr, false, true);
+  }
+  return pv ? pv->GetLogicalVolume()->GetRegion() : nullptr;
+}
+
+/// Preparation callback
+void Geant4RegionStackingAction::prepare(G4StackManager* stack_manager)   {
+  if ( !m_resolved ) resolve(stack_manager);
+}
+
+/// Return TrackClassification with enum G4ClassificationOfNewTrack or NoTrackClassification
+TrackClassification
+Geant4RegionStackingAction::classifyNewTrack(G4StackManager* stack_manager, const G4Track* track)   {
+  if ( !m_resolved ) resolve(stack_manager);
+  const G4Region* reg = region(track);
+  Counters& cnt = m_counters[reg];
+  ++cnt.tracks;
+  if ( track->GetParentID() > 0 )   {
+    if ( m_killParticles.find(track->GetDefinition()) != m_killParticles.end() )   {
+      ++cnt.killedParticle;
+      cnt.energyKilled += track->GetKineticEnergy();
+      return { fKill };
+    }
+    if ( m_timeCut > 0e0 && track->GetGlobalTime() > m_timeCut )   {
+      ++cnt.killedTime;
+      cnt.energyKilled += track->GetKineticEnergy();
+      return { fKill };
+    }
+    auto ie = m_killEnergy.find(reg);
+    if ( ie != m_killEnergy.end() && track->GetKineticEnergy() < ie->second )   {
+      ++cnt.killedEnergy;
+      cnt.energyKilled += track->GetKineticEnergy();
+      return { fKill };
+    }
+  }
+  ++m_numTracked;
+  auto il = m_stackLevel.find(reg);
+  if ( il == m_stackLevel.end() || il->second == 0 )
+    return {};
+  ++cnt.postponed;
+  if ( il->second == 1 )
+    return { fWaiting };
+  return { G4ClassificationOfNewTrack(fWaiting_1 + il->second - 2) };
+}
+
+/// Registered callback on Begin-event: start the CPU clock
+void Geant4RegionStackingAction::beginEvent(const G4Event*)  {
+  m_cpuStart = thread_cpu_time();
+}
+
+/// Registered callback on End-event: stop the CPU clock
+void Geant4RegionStackingAction::endEvent(const G4Event*)  {
+  m_cpuEvents += thread_cpu_time() - m_cpuStart;
+}
+
+/// Registered callback on End-run: print the statistics
+void Geant4RegionStackingAction::endRun(const G4Run*)  {
+  std::size_t killed = 0;
+  always("+++ %-32s %10s %10s %10s %10s %10s %12s",
+         "Region", "Tracks", "Particle", "Time", "Energy", "Postponed", "E-kill[GeV]");
+  for( const auto& c : m_counters )   {
+    const Counters& n = c.second;
+    killed += n.killedParticle + n.killedTime + n.killedEnergy;
+    always("+++ %-32s %10ld %10ld %10ld %10ld %10ld %12.3f",
+           c.first ? c.first->GetName().c_str() : "(outside world)",
+           long(n.tracks), long(n.killedParticle), long(n.killedTime),
+           long(n.killedEnergy), long(n.postponed), n.energyKilled/GeV);
+  }
+  double per_track = m_numTracked > 0 ? double(m_cpuEvents) / double(m_numTracked) : 0e0;
+  always("+++ Tracked: %ld tracks in %.3f sec CPU (%.1f usec/track). Killed: %ld tracks "
+         "saving about %.3f sec CPU.", long(m_numTracked), double(m_cpuEvents)/1e9,
+         per_track/1e3, long(killed), double(killed)*per_track/1e9);
+}
@@ -17,6 +17,7 @@
 #include <DDG4/Geant4Action.h>
 
 /// Geant4 include files
+#include <G4Version.hh>
 #include <G4RunManager.hh>
 
 /// Namespace for the AIDA detector description toolkit
@@ -35,6 +36,7 @@ namespace dd4hep {
      *  Current specializations are:
      *  - G4RunManager for single threaded applications
      *  - G4MTRunManager for multi threaded applications
+     *  - G4SubEvtRunManager for the sub-event parallel mode (Geant4 >= 11.2)
      *
      *  For convenience we name the factory instances according to the G4 classes.
      *
@@ -92,6 +94,65 @@ namespace dd4hep {
   }
 }
 DD4HEP_PLUGINSVC_FACTORY(Geant4MTRunManager,G4MTRunManager,dd4hep::sim::Geant4Action*(_ns::CT*,std::string),__LINE__)
-#endif
 
+#if G4VERSION_NUMBER >= 1120
+#include <G4SubEvtRunManager.hh>
 
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+    template <> void Geant4RunManager<G4SubEvtRunManager>::enableUI()  {
+      Geant4Action::enableUI();
+      this->G4SubEvtRunManager::SetNumberOfThreads(m_numThreads);
+      printout(WARNING,"Geant4RunManager","+++ Configured run manager of type: %s with %d threads.",
+               typeName(typeid(G4SubEvtRunManager)).c_str(), m_numThreads);
+    }
+
+    /// Geant4 run manager plugin for the sub-event parallel mode
+    /**
+     *  Tracks classified by the stacking action as fSubEvent_N (see Geant4SubEventStackingAction)
+     *  are bundled into sub-events of at most 'SubEventSize' tracks, which are processed
+     *  by the worker threads. The results are merged back into the master event.
+     *
+     *  The sub-event type is registered before the first run is started. Both properties
+     *  may be changed using the UI: /ddg4/Geant4RunManager/SubEventSize 200
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4SubEvtRunManager : public Geant4RunManager<G4SubEvtRunManager>   {
+    protected:
+      /// Property: Sub-event type handled by this run manager
+      int  m_subEventType   { 0 };
+      /// Property: Maximum number of tracks bundled into one sub-event
+      int  m_subEventSize   { 100 };
+      /// Flag to register the sub-event type only once
+      bool m_registered     { false };
+    public:
+      /// Standard constructor
+      Geant4SubEvtRunManager(Geant4Context* ctxt, const std::string& nam)
+        : Geant4RunManager<G4SubEvtRunManager>(ctxt, nam)
+      {
+        declareProperty("SubEventType", m_subEventType);
+        declareProperty("SubEventSize", m_subEventSize);
+      }
+      /// Default destructor
+      virtual ~Geant4SubEvtRunManager()   { }
+      /// Register the sub-event type before the event loop is started
+      virtual void RunInitialization()  override   {
+        if ( !m_registered )  {
+          this->RegisterSubEventType(m_subEventType, m_subEventSize);
+          printout(INFO,"Geant4RunManager","+++ Registered sub-event type %d with at most %d tracks.",
+                   m_subEventType, m_subEventSize);
+          m_registered = true;
+        }
+        this->G4SubEvtRunManager::RunInitialization();
+      }
+    };
+  }
+}
+DD4HEP_PLUGINSVC_FACTORY(Geant4SubEvtRunManager,G4SubEvtRunManager,dd4hep::sim::Geant4Action*(_ns::CT*,std::string),__LINE__)
+#endif
+#endif
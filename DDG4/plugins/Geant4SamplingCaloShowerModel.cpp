@@ -0,0 +1,213 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+//
+// Please note:
+//
+// Parametrized showers for layered sampling calorimeters (SHiP SplitCal and HCAL).
+//
+// The mean longitudinal profile follows a Gamma distribution in units of the
+// radiation length (EM) or the interaction length (hadronic showers)
+// as in the Grindhammer parametrisation:
+//
+//    dE/dt = E * beta^alpha * t^(alpha-1) * exp(-beta*t) / Gamma(alpha)
+//    T_max = TmaxSlope  * ln(E/E_ref) + TmaxOffset
+//    alpha = AlphaSlope * ln(E/E_ref) + AlphaOffset,   beta = (alpha-1)/T_max
+//
+// The transverse profile is the sum of a core and a tail component,
+// each f(r) ~ 2 r R^2 / (r^2 + R^2)^2, with radii given in units of the
+// Moliere radius (EM) or the interaction length (hadronic showers).
+//
+// The energy is split into spots, which are handed to the sensitive detector
+// of the volume they fall into. Spots in passive absorber layers are lost,
+// hence the sampling structure of the bars and layers is reproduced by the
+// geometry itself. The remaining free parameter 'VisibleEnergyScale' and
+// the profile parameters are fitted to full simulation samples.
+//
+//==========================================================================
+
+// Framework include files
+#include <DDG4/Geant4FastSimShowerModel.inl.h>
+#include <DDG4/Geant4FastSimSpot.h>
+#include <DDG4/Geant4Random.h>
+
+// Geant4 include files
+#include <G4SystemOfUnits.hh>
+#include <G4FastStep.hh>
+
+// C/C++ include files
+#include <cmath>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep  {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim  {
+
+    ///===================================================================================================
+    ///
+    ///  Sampling calorimeter shower model (e+, e-, gamma or hadrons)
+    ///
+    ///===================================================================================================
+
+    /// Configuration structure for the fast simulation shower model Geant4FSShowerModel<sampling_calo_model>
+    class sampling_calo_model  {
+    public:
+      G4FastSimHitMaker hitMaker          { };
+      /// Effective material of the calorimeter to derive default length scales
+      std::string       materialName      { };
+      /// Hadronic shower: longitudinal and radial scales in interaction lengths
+      bool              hadronic          { false };
+      /// Length scales. Derived from the material if not set
+      double            radiationLength   { -1e0 };
+      double            interactionLength { -1e0 };
+      double            moliereRadius     { -1e0 };
+      double            criticalEnergy    { -1e0 };
+      /// Reference energy of the logarithmic profile parameters. Default: critical energy or 1 GeV
+      double            referenceEnergy   { -1e0 };
+      /// Longitudinal profile: position of the maximum
+      double            tmaxSlope         { 1e0 };
+      double            tmaxOffset        { -0.858 };
+      /// Longitudinal profile: shape
+      double            alphaSlope        { 0.492 };
+      double            alphaOffset       { 0.21 };
+      /// Transverse profile
+      double            coreRadius        { 0.3 };
+      double            tailRadius        { 1.5 };
+      double            coreFraction      { 0.85 };
+      /// Energy split and response
+      int               numberOfSpots     { 200 };
+      double            visibleEnergyScale { 1e0 };
+      double            stochasticResolution { -1e0 };
+      double            constantResolution   { -1e0 };
+
+      /// Longitudinal and transverse length scales
+      double            longitudinalScale { 0e0 };
+      double            radialScale       { 0e0 };
+
+      /// Fluctuate the total energy according to the fitted resolution
+      double smearEnergy(double energy)   const  {
+        double mom = energy/CLHEP::GeV, res2 = 0e0;
+        if ( this->stochasticResolution > 0e0 )
+          res2 += std::pow(this->stochasticResolution, 2) / mom;
+        if ( this->constantResolution > 0e0 )
+          res2 += std::pow(this->constantResolution, 2);
+        if ( res2 <= 0e0 )
+          return energy;
+        double smeared = -1e0;
+        while ( smeared < 0e0 )    // Ensure that the resulting value is not negative
+          smeared = energy * Geant4Random::instance()->gauss(1e0, std::sqrt(res2));
+        return smeared;
+      }
+    };
+
+    /// Declare optional properties from embedded structure
+    template <>
+    void Geant4FSShowerModel<sampling_calo_model>::initialize()     {
+      declareProperty("Material",             locals.materialName);
+      declareProperty("Hadronic",             locals.hadronic);
+      declareProperty("RadiationLength",      locals.radiationLength);
+      declareProperty("InteractionLength",    locals.interactionLength);
+      declareProperty("MoliereRadius",        locals.moliereRadius);
+      declareProperty("CriticalEnergy",       locals.criticalEnergy);
+      declareProperty("ReferenceEnergy",      locals.referenceEnergy);
+      declareProperty("TmaxSlope",            locals.tmaxSlope);
+      declareProperty("TmaxOffset",           locals.tmaxOffset);
+      declareProperty("AlphaSlope",           locals.alphaSlope);
+      declareProperty("AlphaOffset",          locals.alphaOffset);
+      declareProperty("CoreRadius",           locals.coreRadius);
+      declareProperty("TailRadius",           locals.tailRadius);
+      declareProperty("CoreFraction",         locals.coreFraction);
+      declareProperty("NumberOfSpots",        locals.numberOfSpots);
+      declareProperty("VisibleEnergyScale",   locals.visibleEnergyScale);
+      declareProperty("StocasticResolution",  locals.stochasticResolution);
+      declareProperty("ConstantResolution",   locals.constantResolution);
+    }
+
+    /// Sensitive detector construction callback. Called at "ConstructSDandField()"
+    template <>
+    void Geant4FSShowerModel<sampling_calo_model>::constructSensitives(Geant4DetectorConstructionContext* ctxt)   {
+      auto& l = this->locals;
+      if ( !l.materialName.empty() )   {
+        G4Material* mat = this->getMaterial(l.materialName);
+        // Effective Z of mixtures from the electron and atom densities
+        double z_eff = mat->GetTotNbOfElectPerVolume() / mat->GetTotNbOfAtomsPerVolume();
+        if ( l.radiationLength   <= 0e0 ) l.radiationLength   = mat->GetRadlen();
+        if ( l.interactionLength <= 0e0 ) l.interactionLength = mat->GetNuclearInterLength();
+        if ( l.criticalEnergy    <= 0e0 ) l.criticalEnergy    = 610*MeV / (z_eff + 1.24);
+        if ( l.moliereRadius     <= 0e0 ) l.moliereRadius     = 21.2052*MeV * l.radiationLength / l.criticalEnergy;
+      }
+      if ( l.referenceEnergy <= 0e0 )
+        l.referenceEnergy = l.hadronic ? 1*GeV : l.criticalEnergy;
+      l.longitudinalScale = l.hadronic ? l.interactionLength : l.radiationLength;
+      l.radialScale       = l.hadronic ? l.interactionLength : l.moliereRadius;
+      if ( l.longitudinalScale <= 0e0 || l.radialScale <= 0e0 || l.referenceEnergy <= 0e0 )   {
+        except("+++ Incomplete parametrisation: Set 'Material' or the length scales and the reference energy.");
+      }
+      if ( l.numberOfSpots < 1 )   {
+        except("+++ Invalid number of spots: %d", l.numberOfSpots);
+      }
+      info("+++ Longitudinal scale: %7.2f mm Radial scale: %7.2f mm Reference energy: %7.2f MeV Spots: %d",
+           l.longitudinalScale/mm, l.radialScale/mm, l.referenceEnergy/MeV, l.numberOfSpots);
+      this->Geant4FastSimShowerModel::constructSensitives(ctxt);
+    }
+
+    /// User callback to model the particle/energy shower
+    template <>
+    void Geant4FSShowerModel<sampling_calo_model>::modelShower(const G4FastTrack& track, G4FastStep& step)   {
+      auto* primary = track.GetPrimaryTrack();
+      // Kill the parameterised particle:
+      this->killParticle(step, primary->GetKineticEnergy(), 0e0);
+      //-----------------------------------------------------
+      G4FastHit         hit;
+      Geant4FastSimSpot spot(&hit, &track);
+      Geant4Random*     rndm    = Geant4Random::instance();
+      const auto&       l       = this->locals;
+      double            energy  = spot.kineticEnergy();
+      double            ln_y    = std::log(std::max(energy / l.referenceEnergy, 1.0001));
+      double            tmax    = std::max(l.tmaxSlope  * ln_y + l.tmaxOffset,  0.1);
+      double            alpha   = std::max(l.alphaSlope * ln_y + l.alphaOffset, 1.1);
+      double            beta    = (alpha - 1e0) / tmax;
+
+      // Consider only primary tracks for the fluctuation of the total response
+      if ( !spot.primary->GetParentID() )   {
+        energy = l.smearEnergy(energy);
+      }
+      double deposit = l.visibleEnergyScale * energy / double(l.numberOfSpots);
+
+      // axis of the shower, in global reference frame:
+      G4ThreeVector zShower = primary->GetMomentumDirection();
+      G4ThreeVector xShower = zShower.orthogonal().unit();
+      G4ThreeVector yShower = zShower.cross(xShower);
+      G4ThreeVector sShower = spot.trackPosition();
+      for ( int i = 0; i < l.numberOfSpots; ++i )    {
+        // Longitudinal profile: shoot t according to the Gamma distribution
+        double z   = rndm->gamma(alpha, beta) * l.longitudinalScale;
+        // Transverse profile: core or tail component
+        double R   = (rndm->uniform(0e0, 1e0) < l.coreFraction ? l.coreRadius : l.tailRadius) * l.radialScale;
+        double u   = rndm->uniform(0e0, 0.99);
+        double r   = R * std::sqrt(u / (1e0 - u));
+        double phi = rndm->uniform(0e0, twopi);
+        G4ThreeVector position = sShower + z*zShower + r*std::cos(phi)*xShower + r*std::sin(phi)*yShower;
+        /// Process spot and call sensitive detector (if any) of the volume at the spot position
+        hit.SetPosition(position);
+        hit.SetEnergy(deposit);
+        this->locals.hitMaker.make(hit, track);
+      }
+    }
+
+    typedef Geant4FSShowerModel<sampling_calo_model> Geant4SamplingCaloShowerModel;
+  }
+}
+
+#include <DDG4/Factories.h>
+DECLARE_GEANT4ACTION_NS(dd4hep::sim,Geant4SamplingCaloShowerModel)
@@ -0,0 +1,134 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+//
+// Please note:
+//
+// Frozen shower fast simulation: electromagnetic (sub-)showers inside the
+// envelope of the region are replaced by pre-simulated showers of a
+// Geant4ShowerLibrary. The library is filled from full simulation runs
+// with the Geant4ShowerLibraryWriter stepping action.
+//
+// The model triggers for particles within the energy, angle and depth range
+// of the library if the corresponding bin is not empty. Above the upper
+// energy of the library the particle is tracked in full simulation, until
+// its secondaries fall below the library threshold.
+//
+//==========================================================================
+
+// Framework include files
+#include <DDG4/Geant4FastSimShowerModel.inl.h>
+#include <DDG4/Geant4FastSimSpot.h>
+#include <DDG4/Geant4ShowerLibrary.h>
+#include <DDG4/Geant4Random.h>
+
+// Geant4 include files
+#include <G4SystemOfUnits.hh>
+#include <G4FastStep.hh>
+
+// C/C++ include files
+#include <memory>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep  {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim  {
+
+    ///===================================================================================================
+    ///
+    ///  Shower library model (e+, e-, gamma)
+    ///
+    ///===================================================================================================
+
+    /// Configuration structure for the fast simulation shower model Geant4FSShowerModel<shower_library_model>
+    class shower_library_model  {
+    public:
+      G4FastSimHitMaker                    hitMaker    { };
+      /// Name of the library file
+      std::string                          libraryFile { };
+      /// The memory mapped shower library
+      std::unique_ptr<Geant4ShowerLibrary> library     { };
+
+      /// Library bin of the track: energy, angle to the envelope axis and depth along it
+      long bin(const G4FastTrack& track)  const   {
+        return library->bin(track.GetPrimaryTrack()->GetKineticEnergy(),
+                            track.GetPrimaryTrackLocalDirection().theta(),
+                            track.GetPrimaryTrackLocalPosition().z());
+      }
+    };
+
+    /// Declare optional properties from embedded structure
+    template <>
+    void Geant4FSShowerModel<shower_library_model>::initialize()     {
+      declareProperty("LibraryFile", locals.libraryFile);
+      this->m_applicablePartNames.emplace_back("e+");
+      this->m_applicablePartNames.emplace_back("e-");
+      this->m_applicablePartNames.emplace_back("gamma");
+    }
+
+    /// Sensitive detector construction callback. Called at "ConstructSDandField()"
+    template <>
+    void Geant4FSShowerModel<shower_library_model>::constructSensitives(Geant4DetectorConstructionContext* ctxt)   {
+      locals.library = std::make_unique<Geant4ShowerLibrary>();
+      locals.library->open(locals.libraryFile);
+      const auto& b = locals.library->binning();
+      info("+++ Library: E:[%7.3f,%7.3f] GeV x %u  theta:[0,%5.3f] x %u  depth:[%7.2f,%7.2f] mm x %u period: %7.2f mm",
+           b.energyMin/GeV, b.energyMax/GeV, b.numEnergy, b.thetaMax, b.numTheta,
+           b.depthMin/mm, b.depthMax/mm, b.numDepth, b.depthPeriod/mm);
+      this->Geant4FastSimShowerModel::constructSensitives(ctxt);
+    }
+
+    /// User callback to determine if the shower creation should be triggered
+    template <>
+    bool Geant4FSShowerModel<shower_library_model>::check_trigger(const G4FastTrack& track)   {
+      return locals.library->numShowers(locals.bin(track)) > 0;
+    }
+
+    /// User callback to model the particle/energy shower
+    template <>
+    void Geant4FSShowerModel<shower_library_model>::modelShower(const G4FastTrack& track, G4FastStep& step)   {
+      auto* primary = track.GetPrimaryTrack();
+      // Kill the parameterised particle:
+      this->killParticle(step, primary->GetKineticEnergy(), 0e0);
+      //-----------------------------------------------------
+      const Geant4ShowerLibrary& lib = *locals.library;
+      long        ibin   = locals.bin(track);
+      std::size_t num    = lib.numShowers(ibin);
+      std::size_t which  = std::min(std::size_t(Geant4Random::instance()->uniform(0e0, double(num))), num - 1);
+      const auto& shower = lib.shower(ibin, which);
+      const auto* spots  = lib.spots(shower);
+
+      // Shower frame in the local frame of the envelope: must match Geant4ShowerLibraryWriter
+      G4ThreeVector zShower = track.GetPrimaryTrackLocalDirection();
+      G4ThreeVector xShower = zShower.orthogonal().unit();
+      G4ThreeVector yShower = zShower.cross(xShower);
+      G4ThreeVector sShower = track.GetPrimaryTrackLocalPosition();
+      const auto*   toGlobal = track.GetInverseAffineTransformation();
+      double        energy   = primary->GetKineticEnergy();
+      G4FastHit     hit;
+      for ( std::uint32_t i = 0; i < shower.count; ++i )    {
+        const auto& s = spots[i];
+        G4ThreeVector position = sShower + s.x*xShower + s.y*yShower + s.z*zShower;
+        /// Process spot and call sensitive detector (if any) of the volume at the spot position
+        hit.SetPosition(toGlobal->TransformPoint(position));
+        hit.SetEnergy(energy * s.energy);
+        this->locals.hitMaker.make(hit, track);
+      }
+    }
+
+    typedef Geant4FSShowerModel<shower_library_model> Geant4ShowerLibraryModel;
+  }
+}
+
+#include <DDG4/Factories.h>
+DECLARE_GEANT4ACTION_NS(dd4hep::sim,Geant4ShowerLibraryModel)
@@ -0,0 +1,255 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDG4_GEANT4SHOWERLIBRARYWRITER_H
+#define DDG4_GEANT4SHOWERLIBRARYWRITER_H
+
+// Framework include files
+#include <DDG4/Geant4SteppingAction.h>
+#include <DDG4/Geant4ShowerLibrary.h>
+
+// Geant4 include files
+#include <G4AffineTransform.hh>
+#include <G4ThreeVector.hh>
+
+// C/C++ include files
+#include <memory>
+#include <unordered_map>
+
+// Forward declarations
+class G4Run;
+class G4Event;
+class G4Region;
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim   {
+
+    /// Stepping action to fill a shower library from full simulation
+    /**
+     *  The primary particle of each event is followed until it is inside the
+     *  region. From there all energy deposits in sensitive volumes are collected
+     *  in the shower frame (see Geant4ShowerLibraryModel) and merged into spots
+     *  of size 'SpotSize'. At the end of the event the shower is added to the
+     *  library bin of the primary's energy, angle and depth in the local frame
+     *  of the region's envelope. The library is written at the end of the run.
+     *
+     *  Generation runs must be single threaded.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4ShowerLibraryWriter : public Geant4SteppingAction  {
+    protected:
+      /// Energy deposit merged into one spot
+      struct Deposit  {
+        double        energy   { 0e0 };
+        G4ThreeVector position { };
+      };
+      /// Property: Region name of the envelope
+      std::string       m_regionName    { };
+      /// Property: Output file name
+      std::string       m_output        { "ShowerLibrary.bin" };
+      /// Property: Library binning
+      double            m_energyMin     { 10e0 * CLHEP::MeV };
+      double            m_energyMax     { 1e0 * CLHEP::GeV };
+      int               m_energyBins    { 10 };
+      double            m_thetaMax      { M_PI };
+      int               m_thetaBins     { 6 };
+      double            m_depthMin      { 0e0 };
+      double            m_depthMax      { 1e0 * CLHEP::cm };
+      int               m_depthBins     { 1 };
+      double            m_depthPeriod   { 0e0 };
+      /// Property: Size of the voxels deposits are merged into
+      double            m_spotSize      { 1e0 * CLHEP::mm };
+
+      /// The library filled in memory
+      std::unique_ptr<Geant4ShowerLibrary> m_library  { };
+      /// Reference to the region of the envelope
+      G4Region*         m_region        { nullptr };
+      /// Shower of the current event
+      bool              m_started       { false };
+      double            m_energy        { 0e0 };
+      G4ThreeVector     m_start         { };
+      G4ThreeVector     m_axis[3]       { };
+      G4AffineTransform m_toLocal       { };
+      std::unordered_map<std::uint64_t, Deposit> m_deposits { };
+      /// Statistics
+      std::size_t       m_numRejected   { 0 };
+
+    public:
+      /// Standard constructor
+      Geant4ShowerLibraryWriter(Geant4Context* context, const std::string& name);
+      /// Default destructor
+      virtual ~Geant4ShowerLibraryWriter();
+      /// User stepping callback
+      virtual void operator()(const G4Step* step, G4SteppingManager* mgr)  override;
+      /// Registered callback on Begin-event: reset the shower
+      void beginEvent(const G4Event* event);
+      /// Registered callback on End-event: add the shower to the library
+      void endEvent(const G4Event* event);
+      /// Registered callback on End-run: write the library
+      void endRun(const G4Run* run);
+    };
+  }
+}
+#endif // DDG4_GEANT4SHOWERLIBRARYWRITER_H
+
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/InstanceCount.h>
+#include <DDG4/Geant4RunAction.h>
+#include <DDG4/Geant4EventAction.h>
+#include <DDG4/Geant4StepHandler.h>
+
+// Geant4 include files
+#include <G4RegionStore.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4NavigationHistory.hh>
+
+// C/C++ include files
+#include <cmath>
+
+using namespace dd4hep::sim;
+
+#include <DDG4/Factories.h>
+DECLARE_GEANT4ACTION(Geant4ShowerLibraryWriter)
+
+/// Standard constructor
+Geant4ShowerLibraryWriter::Geant4ShowerLibraryWriter(Geant4Context* ctxt, const std::string& nam)
+  : Geant4SteppingAction(ctxt,nam)
+{
+  declareProperty("RegionName",  m_regionName);
+  declareProperty("OutputFile",  m_output);
+  declareProperty("EnergyMin",   m_energyMin);
+  declareProperty("EnergyMax",   m_energyMax);
+  declareProperty("EnergyBins",  m_energyBins);
+  declareProperty("ThetaMax",    m_thetaMax);
+  declareProperty("ThetaBins",   m_thetaBins);
+  declareProperty("DepthMin",    m_depthMin);
+  declareProperty("DepthMax",    m_depthMax);
+  declareProperty("DepthBins",   m_depthBins);
+  declareProperty("DepthPeriod", m_depthPeriod);
+  declareProperty("SpotSize",    m_spotSize);
+  eventAction().callAtBegin(this,&Geant4ShowerLibraryWriter::beginEvent);
+  eventAction().callAtEnd(this,&Geant4ShowerLibraryWriter::endEvent);
+  runAction().callAtEnd(this,&Geant4ShowerLibraryWriter::endRun);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4ShowerLibraryWriter::~Geant4ShowerLibraryWriter() {
+  InstanceCount::decrement(this);
+}
+
+/// Registered callback on Begin-event: reset the shower
+void Geant4ShowerLibraryWriter::beginEvent(const G4Event*)  {
+  if ( !m_library )  {
+    Geant4ShowerLibrary::Binning b;
+    b.energyMin   = m_energyMin;
+    b.energyMax   = m_energyMax;
+    b.numEnergy   = std::uint32_t(m_energyBins);
+    b.thetaMax    = m_thetaMax;
+    b.numTheta    = std::uint32_t(m_thetaBins);
+    b.depthMin    = m_depthMin;
+    b.depthMax    = m_depthMax;
+    b.numDepth    = std::uint32_t(m_depthBins);
+    b.depthPeriod = m_depthPeriod;
+    m_library = std::make_unique<Geant4ShowerLibrary>(b);
+    m_region  = G4RegionStore::GetInstance()->GetRegion(m_regionName, false);
+    if ( !m_region )  {
+      except("+++ Unknown region: %s", m_regionName.c_str());
+    }
+  }
+  m_started = false;
+  m_energy  = 0e0;
+  m_deposits.clear();
+}
+
+/// User stepping callback
+void Geant4ShowerLibraryWriter::operator()(const G4Step* step, G4SteppingManager*) {
+  Geant4StepHandler h(step);
+  if ( !m_started )  {
+    if ( h.track->GetParentID() != 0 )
+      return;
+    const G4VTouchable* t = h.preTouchable();
+    int depth = t->GetHistoryDepth();
+    /// The envelope is the outermost root volume of the region
+    for( int i = depth; i >= 0; --i )  {
+      G4LogicalVolume* lv = t->GetVolume(i)->GetLogicalVolume();
+      if ( lv->IsRootRegion() && lv->GetRegion() == m_region )  {
+        m_toLocal  = t->GetHistory()->GetTransform(depth - i);
+        m_start    = m_toLocal.TransformPoint(h.prePosG4());
+        m_axis[2]  = m_toLocal.TransformAxis(h.pre->GetMomentumDirection()).unit();
+        m_axis[0]  = m_axis[2].orthogonal().unit();
+        m_axis[1]  = m_axis[2].cross(m_axis[0]);
+        m_energy   = h.pre->GetKineticEnergy();
+        m_started  = true;
+        break;
+      }
+    }
+    if ( !m_started )
+      return;
+  }
+  double edep = h.deposit();
+  if ( edep <= 0e0 || !h.isSensitive(h.pre) )
+    return;
+  /// Deposit in the shower frame, merged into voxels of size m_spotSize
+  G4ThreeVector d = m_toLocal.TransformPoint(h.avgPositionG4()) - m_start;
+  G4ThreeVector p(d.dot(m_axis[0]), d.dot(m_axis[1]), d.dot(m_axis[2]));
+  std::uint64_t key = 0;
+  for( int i = 0; i < 3; ++i )
+    key = (key << 21) | (std::uint64_t(std::int64_t(std::floor(p[i] / m_spotSize)) + (1<<20)) & 0x1FFFFF);
+  Deposit& dep = m_deposits[key];
+  dep.energy   += edep;
+  dep.position += edep * p;
+}
+
+/// Registered callback on End-event: add the shower to the library
+void Geant4ShowerLibraryWriter::endEvent(const G4Event*)  {
+  if ( !m_started || m_energy <= 0e0 )
+    return;
+  std::vector<Geant4ShowerLibrary::Spot> spots;
+  spots.reserve(m_deposits.size());
+  for( const auto& d : m_deposits )  {
+    G4ThreeVector p = d.second.position / d.second.energy;
+    spots.emplace_back(Geant4ShowerLibrary::Spot { float(p.x()), float(p.y()), float(p.z()),
+                                                   float(d.second.energy / m_energy) });
+  }
+  if ( !m_library->add(m_energy, m_axis[2].theta(), m_start.z(), std::move(spots)) )
+    ++m_numRejected;
+}
+
+/// Registered callback on End-run: write the library
+void Geant4ShowerLibraryWriter::endRun(const G4Run*)  {
+  if ( m_library )  {
+    m_library->save(m_output);
+    always("+++ Shower library %s: %ld showers added, %ld outside the library range.",
+           m_output.c_str(), long(m_library->numPending()), long(m_numRejected));
+  }
+}
@@ -0,0 +1,325 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDG4_GEANT4SIMULATIONPROFILER_H
+#define DDG4_GEANT4SIMULATIONPROFILER_H
+
+// Framework include files
+#include <DDG4/Geant4SteppingAction.h>
+
+// C/C++ include files
+#include <map>
+#include <cstdint>
+#include <unordered_map>
+
+// Forward declarations
+class G4Run;
+class G4Track;
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim   {
+
+    /// Stepping action to profile where the simulation time goes
+    /**
+     *  Steps, tracks and wall time are accumulated per logical volume, region,
+     *  particle type and process. The time between two consecutive steps of a
+     *  track is attributed to the volume of the pre-step point, its region, the
+     *  particle and the process limiting the step. Tracks are counted in the
+     *  volume and region they start in.
+     *
+     *  Each thread accumulates into its own instance keyed by Geant4 object
+     *  pointers. At the end of the run the counters are merged by name. When
+     *  the last instance is deleted, the summary table with the 'TopN' entries
+     *  of each category is printed and the full report is written to
+     *  'OutputFile' (ROOT if the name ends with ".root", otherwise JSON).
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4SimulationProfiler : public Geant4SteppingAction  {
+    public:
+      /// Accumulated counters of one entry
+      struct Entry  {
+        std::uint64_t steps  { 0 };
+        std::uint64_t tracks { 0 };
+        /// Wall time [nanoseconds]
+        std::uint64_t time   { 0 };
+      };
+      /// Categories of the profile
+      enum Category { VOLUME = 0, REGION, PARTICLE, PROCESS, NUM_CATEGORIES };
+      /// Counters by object pointer
+      typedef std::unordered_map<const void*, Entry> Counters;
+      /// Counters by name
+      typedef std::map<std::string, Entry>           Table;
+
+    protected:
+      /// Property: Output file for the report. Empty: no file
+      std::string   m_output  { "SimulationProfile.json" };
+      /// Property: Number of entries per category in the summary table
+      int           m_topN    { 20 };
+
+      /// Counters of this instance
+      Counters      m_counters[NUM_CATEGORIES];
+      /// Time stamp of the last step of the current track
+      std::uint64_t m_last    { 0 };
+
+      /// Print summary and write the report
+      void report(const Table* tables)  const;
+
+    public:
+      /// Standard constructor
+      Geant4SimulationProfiler(Geant4Context* context, const std::string& name);
+      /// Default destructor
+      virtual ~Geant4SimulationProfiler();
+      /// User stepping callback
+      virtual void operator()(const G4Step* step, G4SteppingManager* mgr)  override;
+      /// Registered callback on Begin-track
+      void beginTrack(const G4Track* track);
+      /// Registered callback on End-track
+      void endTrack(const G4Track* track);
+      /// Registered callback on End-run: merge the counters
+      void endRun(const G4Run* run);
+    };
+  }
+}
+#endif // DDG4_GEANT4SIMULATIONPROFILER_H
+
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/InstanceCount.h>
+#include <DDG4/Geant4RunAction.h>
+#include <DDG4/Geant4TrackingAction.h>
+
+// Geant4 include files
+#include <G4Step.hh>
+#include <G4Track.hh>
+#include <G4Region.hh>
+#include <G4VProcess.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4ParticleDefinition.hh>
+
+// ROOT include files
+#include <TFile.h>
+#include <TTree.h>
+
+// C/C++ include files
+#include <mutex>
+#include <memory>
+#include <chrono>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+
+using namespace dd4hep::sim;
+
+#include <DDG4/Factories.h>
+DECLARE_GEANT4ACTION(Geant4SimulationProfiler)
+
+namespace  {
+  /// Names of the categories
+  const char* s_category[Geant4SimulationProfiler::NUM_CATEGORIES] = { "volume", "region", "particle", "process" };
+  /// Counters merged from all threads
+  std::mutex                       s_lock;
+  Geant4SimulationProfiler::Table  s_tables[Geant4SimulationProfiler::NUM_CATEGORIES];
+  std::size_t                      s_instances = 0;
+
+  /// Wall clock [nanoseconds]
+  inline std::uint64_t now_ns()   {
+    return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>
+                         (std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+  inline void add(Geant4SimulationProfiler::Entry& to, const Geant4SimulationProfiler::Entry& from)  {
+    to.steps  += from.steps;
+    to.tracks += from.tracks;
+    to.time   += from.time;
+  }
+  /// Escape names for the JSON report
+  std::string json_str(const std::string& s)   {
+    std::string r = "\"";
+    for( char c : s )   {
+      if ( c == '"' || c == '\\' ) r += '\\';
+      r += c;
+    }
+    return r + "\"";
+  }
+}
+
+/// Standard constructor
+Geant4SimulationProfiler::Geant4SimulationProfiler(Geant4Context* ctxt, const std::string& nam)
+  : Geant4SteppingAction(ctxt,nam)
+{
+  declareProperty("OutputFile", m_output);
+  declareProperty("TopN",       m_topN);
+  trackingAction().callAtBegin(this,&Geant4SimulationProfiler::beginTrack);
+  trackingAction().callAtEnd(this,&Geant4SimulationProfiler::endTrack);
+  runAction().callAtEnd(this,&Geant4SimulationProfiler::endRun);
+  std::lock_guard<std::mutex> lock(s_lock);
+  ++s_instances;
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4SimulationProfiler::~Geant4SimulationProfiler() {
+  std::lock_guard<std::mutex> lock(s_lock);
+  if ( --s_instances == 0 && !s_tables[PARTICLE].empty() )   {
+    report(s_tables);
+    for( auto& t : s_tables ) t.clear();
+  }
+  InstanceCount::decrement(this);
+}
+
+/// Registered callback on Begin-track
+void Geant4SimulationProfiler::beginTrack(const G4Track* track)  {
+  const G4VPhysicalVolume* pv = track->GetVolume();
+  ++m_counters[PARTICLE][track->GetDefinition()].tracks;
+  if ( pv )   {
+    const G4LogicalVolume* lv = pv->GetLogicalVolume();
+    ++m_counters[VOLUME][lv].tracks;
+    ++m_counters[REGION][lv->GetRegion()].tracks;
+  }
+  m_last = now_ns();
+}
+
+/// Registered callback on End-track: tracking overhead after the last step
+void Geant4SimulationProfiler::endTrack(const G4Track* track)  {
+  m_counters[PARTICLE][track->GetDefinition()].time += now_ns() - m_last;
+}
+
+/// User stepping callback
+void Geant4SimulationProfiler::operator()(const G4Step* step, G4SteppingManager*) {
+  std::uint64_t now = now_ns();
+  std::uint64_t dt  = now - m_last;
+  const G4StepPoint*       pre  = step->GetPreStepPoint();
+  const G4VPhysicalVolume* pv   = pre->GetPhysicalVolume();
+  const G4VProcess*        proc = step->GetPostStepPoint()->GetProcessDefinedStep();
+  Entry& part = m_counters[PARTICLE][step->GetTrack()->GetDefinition()];
+  Entry& prc  = m_counters[PROCESS][proc];
+  ++part.steps;
+  part.time += dt;
+  ++prc.steps;
+  prc.time += dt;
+  if ( pv )   {
+    const G4LogicalVolume* lv = pv->GetLogicalVolume();
+    Entry& vol = m_counters[VOLUME][lv];
+    Entry& reg = m_counters[REGION][lv->GetRegion()];
+    ++vol.steps;
+    vol.time += dt;
+    ++reg.steps;
+    reg.time += dt;
+  }
+  m_last = now;
+}
+
+/// Registered callback on End-run: merge the counters
+void Geant4SimulationProfiler::endRun(const G4Run*)  {
+  std::lock_guard<std::mutex> lock(s_lock);
+  for( const auto& c : m_counters[VOLUME] )
+    add(s_tables[VOLUME][((const G4LogicalVolume*)c.first)->GetName()], c.second);
+  for( const auto& c : m_counters[REGION] )
+    add(s_tables[REGION][c.first ? ((const G4Region*)c.first)->GetName() : "(none)"], c.second);
+  for( const auto& c : m_counters[PARTICLE] )
+    add(s_tables[PARTICLE][((const G4ParticleDefinition*)c.first)->GetParticleName()], c.second);
+  for( const auto& c : m_counters[PROCESS] )
+    add(s_tables[PROCESS][c.first ? ((const G4VProcess*)c.first)->GetProcessName() : "(none)"], c.second);
+  for( auto& c : m_counters ) c.clear();
+}
+
+/// Print summary and write the report
+void Geant4SimulationProfiler::report(const Table* tables)  const   {
+  for( int cat = 0; cat < NUM_CATEGORIES; ++cat )   {
+    const Table& t = tables[cat];
+    std::vector<const Table::value_type*> entries;
+    std::uint64_t total = 0;
+    for( const auto& e : t )   {
+      entries.emplace_back(&e);
+      total += e.second.time;
+    }
+    std::sort(entries.begin(), entries.end(), [](const Table::value_type* a, const Table::value_type* b)
+              {  return a->second.time > b->second.time;  });
+    always("+++ Profile by %-8s %-40s %12s %10s %12s %7s %10s", s_category[cat], "",
+           "Steps", "Tracks", "Time[sec]", "[%]", "usec/step");
+    for( std::size_t i = 0; i < entries.size() && int(i) < m_topN; ++i )   {
+      const Entry& e = entries[i]->second;
+      always("+++    %-50s %12ld %10ld %12.3f %7.2f %10.3f", entries[i]->first.c_str(),
+             long(e.steps), long(e.tracks), double(e.time)/1e9,
+             total > 0 ? 100e0*double(e.time)/double(total) : 0e0,
+             e.steps > 0 ? double(e.time)/double(e.steps)/1e3 : 0e0);
+    }
+  }
+  if ( m_output.empty() )
+    return;
+  if ( m_output.size() > 5 && m_output.substr(m_output.size()-5) == ".root" )   {
+    std::unique_ptr<TFile> file(TFile::Open(m_output.c_str(), "RECREATE", "DDG4 simulation profile"));
+    if ( !file || file->IsZombie() )   {
+      error("+++ Cannot open profile output file %s", m_output.c_str());
+      return;
+    }
+    for( int cat = 0; cat < NUM_CATEGORIES; ++cat )   {
+      std::string name;
+      Long64_t steps = 0, tracks = 0;
+      Double_t time = 0e0;
+      TTree* tree = new TTree(s_category[cat], ("Simulation profile by " + std::string(s_category[cat])).c_str());
+      tree->Branch("name",   &name);
+      tree->Branch("steps",  &steps,  "steps/L");
+      tree->Branch("tracks", &tracks, "tracks/L");
+      tree->Branch("time",   &time,   "time/D");
+      for( const auto& e : tables[cat] )   {
+        name   = e.first;
+        steps  = Long64_t(e.second.steps);
+        tracks = Long64_t(e.second.tracks);
+        time   = double(e.second.time)/1e9;
+        tree->Fill();
+      }
+      tree->Write();
+    }
+    file->Close();
+  }
+  else   {
+    std::ofstream os(m_output);
+    if ( !os.good() )   {
+      error("+++ Cannot open profile output file %s", m_output.c_str());
+      return;
+    }
+    os << "{";
+    for( int cat = 0; cat < NUM_CATEGORIES; ++cat )   {
+      os << (cat ? ",\n" : "\n") << " " << json_str(s_category[cat]) << ": [";
+      bool first = true;
+      for( const auto& e : tables[cat] )   {
+        os << (first ? "\n" : ",\n") << "  {\"name\": " << json_str(e.first)
+           << ", \"steps\": "  << e.second.steps
+           << ", \"tracks\": " << e.second.tracks
+           << ", \"time\": "   << double(e.second.time)/1e9 << "}";
+        first = false;
+      }
+      os << "\n ]";
+    }
+    os << "\n}\n";
+  }
+  always("+++ Simulation profile written to %s", m_output.c_str());
+}
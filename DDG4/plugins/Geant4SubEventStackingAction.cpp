@@ -0,0 +1,164 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDG4_GEANT4SUBEVENTSTACKINGACTION_H
+#define DDG4_GEANT4SUBEVENTSTACKINGACTION_H
+
+// Framework include files
+#include <DDG4/Geant4StackingAction.h>
+
+// Geant4 include files
+#include <G4Version.hh>
+
+// C/C++ include files
+#include <unordered_map>
+
+// Forward declarations
+class G4Run;
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim   {
+
+    /// Stacking action to ship sub-trees of huge events to other worker threads
+    /**
+     *  Sub-event parallel mode (Geant4 >= 11.2, RunManagerType 'G4SubEvtRunManager'):
+     *  the master thread tracks the primaries and the first generations of secondaries.
+     *  New tracks of generation 'Generation' or higher (primaries have generation 0)
+     *  with a kinetic energy above 'MinimumEnergy' are classified as fSubEvent_N,
+     *  where N is 'SubEventType'. The run manager bundles them to sub-events, which
+     *  are processed by the worker threads. The hits and the MC truth of the sub-events are
+     *  merged into the master event after the particle handler finished the master event
+     *  and before the output actions are called.
+     *
+     *  Tracks created while processing a sub-event are never shipped again.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4SubEventStackingAction : public Geant4StackingAction  {
+    protected:
+      /// Property: First generation of secondaries to be shipped
+      int                          m_generation    { 2 };
+      /// Property: Minimal kinetic energy of shipped tracks
+      double                       m_minEnergy     { 0e0 };
+      /// Property: Sub-event type as registered with the run manager
+      int                          m_subEventType  { 0 };
+
+      /// Generation of the tracks of the current event by track identifier
+      std::unordered_map<int, int> m_generations   { };
+      /// Statistics
+      std::size_t                  m_numEvents     { 0 };
+      std::size_t                  m_numTracks     { 0 };
+      std::size_t                  m_numShipped    { 0 };
+
+    public:
+      /// Standard constructor
+      Geant4SubEventStackingAction(Geant4Context* context, const std::string& name);
+      /// Default destructor
+      virtual ~Geant4SubEventStackingAction();
+      /// Preparation callback
+      virtual void prepare(G4StackManager* stackManager)  override;
+      /// Return TrackClassification with enum G4ClassificationOfNewTrack or NoTrackClassification
+      virtual TrackClassification
+      classifyNewTrack(G4StackManager* stackManager, const G4Track* track)  override;
+      /// Registered callback on End-run: print the statistics
+      void endRun(const G4Run* run);
+    };
+  }
+}
+#endif // DDG4_GEANT4SUBEVENTSTACKINGACTION_H
+
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/InstanceCount.h>
+#include <DDG4/Geant4RunAction.h>
+
+// Geant4 include files
+#include <G4Track.hh>
+#include <G4Threading.hh>
+
+using namespace dd4hep::sim;
+
+#include <DDG4/Factories.h>
+DECLARE_GEANT4ACTION(Geant4SubEventStackingAction)
+
+/// Standard constructor
+Geant4SubEventStackingAction::Geant4SubEventStackingAction(Geant4Context* ctxt, const std::string& nam)
+  : Geant4StackingAction(ctxt,nam)
+{
+  declareProperty("Generation",    m_generation);
+  declareProperty("MinimumEnergy", m_minEnergy);
+  declareProperty("SubEventType",  m_subEventType);
+  runAction().callAtEnd(this,&Geant4SubEventStackingAction::endRun);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4SubEventStackingAction::~Geant4SubEventStackingAction() {
+  InstanceCount::decrement(this);
+}
+
+/// Preparation callback
+void Geant4SubEventStackingAction::prepare(G4StackManager*)   {
+#if G4VERSION_NUMBER < 1120
+  except("+++ The sub-event parallel mode requires Geant4 version 11.2 or later.");
+#endif
+  m_generations.clear();
+  ++m_numEvents;
+}
+
+/// Return TrackClassification with enum G4ClassificationOfNewTrack or NoTrackClassification
+TrackClassification
+Geant4SubEventStackingAction::classifyNewTrack(G4StackManager*, const G4Track* track)   {
+  int parent = track->GetParentID();
+  int gen    = 0;
+  if ( parent != 0 )  {
+    auto i = m_generations.find(parent);
+    gen = (i == m_generations.end() ? 0 : (*i).second) + 1;
+  }
+  m_generations[track->GetTrackID()] = gen;
+  ++m_numTracks;
+#if G4VERSION_NUMBER >= 1120
+  /// Only the master event is split. Sub-events are tracked completely by the worker.
+  if ( G4Threading::IsMasterThread() && gen >= m_generation &&
+       track->GetKineticEnergy() > m_minEnergy )  {
+    ++m_numShipped;
+    return G4ClassificationOfNewTrack(fSubEvent_0 + m_subEventType);
+  }
+#endif
+  return {};
+}
+
+/// Registered callback on End-run: print the statistics
+void Geant4SubEventStackingAction::endRun(const G4Run*)   {
+  if ( m_numTracks > 0 )  {
+    always("+++ %ld events: %ld of %ld new tracks (%.1f %%) shipped to sub-events of type %d.",
+           long(m_numEvents), long(m_numShipped), long(m_numTracks),
+           100e0 * double(m_numShipped) / double(m_numTracks), m_subEventType);
+  }
+}
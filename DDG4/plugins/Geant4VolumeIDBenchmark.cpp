@@ -0,0 +1,149 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDG4_GEANT4VOLUMEIDBENCHMARK_H
+#define DDG4_GEANT4VOLUMEIDBENCHMARK_H
+
+// Framework include files
+#include <DDG4/Geant4SteppingAction.h>
+
+// C/C++ include files
+#include <cstdint>
+
+// Forward declarations
+class G4Run;
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim   {
+
+    /// Stepping action to benchmark the volume identifier lookup of the Geant4VolumeManager
+    /**
+     *  For every step in a sensitive volume the volume identifier is resolved
+     *  twice: once by the Geant4VolumeManager and once by building the full
+     *  placement path vector and looking up its hash (the original algorithm).
+     *  Both results must agree. The timing summary is printed at the end of run.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4VolumeIDBenchmark : public Geant4SteppingAction  {
+    protected:
+      /// Number of resolved sensitive steps
+      std::size_t   m_numSteps      { 0 };
+      /// Number of steps where the two lookups disagree
+      std::size_t   m_numMismatches { 0 };
+      /// Total time spent in the volume manager lookup [nanoseconds]
+      std::uint64_t m_timeManager   { 0 };
+      /// Total time spent in the placement path lookup [nanoseconds]
+      std::uint64_t m_timePath      { 0 };
+
+    public:
+      /// Standard constructor
+      Geant4VolumeIDBenchmark(Geant4Context* context, const std::string& name);
+      /// Default destructor
+      virtual ~Geant4VolumeIDBenchmark();
+      /// User stepping callback
+      virtual void operator()(const G4Step* step, G4SteppingManager* mgr)  override;
+      /// Registered callback on End-run: print the summary
+      void endRun(const G4Run* run);
+    };
+  }
+}
+#endif // DDG4_GEANT4VOLUMEIDBENCHMARK_H
+
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/InstanceCount.h>
+#include <DD4hep/Primitives.h>
+#include <DDG4/Geant4Mapping.h>
+#include <DDG4/Geant4RunAction.h>
+#include <DDG4/Geant4StepHandler.h>
+#include <DDG4/Geant4TouchableHandler.h>
+
+// C/C++ include files
+#include <chrono>
+#include <algorithm>
+
+using namespace dd4hep::sim;
+
+#include <DDG4/Factories.h>
+DECLARE_GEANT4ACTION(Geant4VolumeIDBenchmark)
+
+/// Standard constructor
+Geant4VolumeIDBenchmark::Geant4VolumeIDBenchmark(Geant4Context* ctxt, const std::string& nam)
+  : Geant4SteppingAction(ctxt,nam)
+{
+  runAction().callAtEnd(this,&Geant4VolumeIDBenchmark::endRun);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4VolumeIDBenchmark::~Geant4VolumeIDBenchmark() {
+  InstanceCount::decrement(this);
+}
+
+/// User stepping callback
+void Geant4VolumeIDBenchmark::operator()(const G4Step* step, G4SteppingManager*) {
+  typedef std::chrono::steady_clock clock_t;
+  Geant4StepHandler h(step);
+  if ( !h.isSensitive(h.pre) )
+    return;
+
+  Geant4VolumeManager  volMgr    = Geant4Mapping::instance().volumeManager();
+  const G4VTouchable*  touchable = h.preTouchable();
+  const auto&          paths     = volMgr.ptr()->g4Paths;
+
+  auto             start  = clock_t::now();
+  dd4hep::VolumeID vid    = volMgr.volumeID(touchable);
+  auto             middle = clock_t::now();
+  dd4hep::VolumeID ref    = Geant4VolumeManager::NonExisting;
+  Geant4TouchableHandler::Geant4PlacementPath path = Geant4TouchableHandler(touchable).placementPath();
+  if ( !path.empty() )  {
+    auto i = paths.find(dd4hep::detail::hash64(&path[0], sizeof(path[0])*path.size()));
+    if ( i != paths.end() ) ref = i->second.volumeID;
+  }
+  auto             stop   = clock_t::now();
+
+  ++m_numSteps;
+  m_timeManager += std::chrono::duration_cast<std::chrono::nanoseconds>(middle-start).count();
+  m_timePath    += std::chrono::duration_cast<std::chrono::nanoseconds>(stop-middle).count();
+  /// Parametrised volumes carry the copy numbers in addition: compare the common bits only
+  if ( ref != Geant4VolumeManager::NonExisting && (vid & ref) != ref )  {
+    ++m_numMismatches;
+    error("+++ VolumeID mismatch: %016llX <> %016llX Path: %s", vid, ref,
+          Geant4TouchableHandler::placementPath(path).c_str());
+  }
+}
+
+/// Registered callback on End-run: print the summary
+void Geant4VolumeIDBenchmark::endRun(const G4Run*)  {
+  double steps = double(std::max<std::size_t>(m_numSteps, 1));
+  always("+++ VolumeID lookups: %ld sensitive steps  %ld mismatches", m_numSteps, m_numMismatches);
+  always("+++ VolumeID lookups: volume manager %9.1f nsec/step   placement path %9.1f nsec/step",
+         double(m_timeManager)/steps, double(m_timePath)/steps);
+}
@@ -64,6 +64,7 @@ class DD4hepSimulation(object):
   def __init__(self):
     self.steeringFile = None
     self.compactFile = []
+    self.geometryCache = None
     self.inputFiles = []
     self.outputFile = defaultOutputFile()
     self.runType = "batch"
@@ -150,6 +151,11 @@ class DD4hepSimulation(object):
                         default=ConfigHelper.makeList(self.compactFile), type=str,
                         help="The compact XML file, or multiple compact files, if the last one is the closer.")
 
+    parser.add_argument("--geometryCache", action="store", default=self.geometryCache, type=str,
+                        help="Directory to cache the constructed geometry. If none of the XML inputs changed"
+                        " the geometry is restored from the cache instead of being built from the compact file."
+                        " The Geant4 volume identifier tables are cached as well")
+
     parser.add_argument("--runType", action="store", choices=("batch", "vis", "run", "shell", "qt"),
                         default=self.runType,
                         help="The type of action to do in this invocation"  # Note: implicit string concatenation
@@ -237,6 +243,7 @@ class DD4hepSimulation(object):
 
     self.compactFile = ConfigHelper.makeList(parsed.compactFile)
     self.__checkFilesExist(self.compactFile, fileType='compact')
+    self.geometryCache = parsed.geometryCache
     self.inputFiles = parsed.inputFiles
     self.inputFiles = self.__checkFileFormat(self.inputFiles, POSSIBLEINPUTFILES)
     self.__checkFilesExist(self.inputFiles, fileType='input')
@@ -318,6 +325,8 @@ class DD4hepSimulation(object):
     kernel = DDG4.Kernel()
     dd4hep.setPrintLevel(self.printLevel)
 
+    if self.geometryCache:
+      os.environ['DD4HEP_GEOMETRY_CACHE'] = os.path.abspath(self.geometryCache)
     for compactFile in self.compactFile:
       kernel.loadGeometry(str("file:" + os.path.abspath(compactFile)))
     detectorDescription = kernel.detectorDescription()
@@ -71,6 +71,8 @@
 #include <G4MaterialPropertiesIndex.hh>
 #endif
 #include <G4ScaledSolid.hh>
+#include <G4Voxelizer.hh>
+#include <G4TessellatedSolid.hh>
 #include <CLHEP/Units/SystemOfUnits.h>
 
 // C/C++ include files
@@ -78,6 +80,9 @@
 #include <iomanip>
 #include <sstream>
 #include <limits>
+#include <atomic>
+#include <algorithm>
+#include <thread>
 
 namespace units = dd4hep;
 using namespace dd4hep::sim;
@@ -648,8 +653,12 @@ void* Geant4Converter::handleSolid(const std::string& name, const TGeoShape* sha
       solid = convertShape<TGeoArb8>(shape);
     else if (isa == TGeoPara::Class())
       solid = convertShape<TGeoPara>(shape);
-    else if (isa == TGeoTessellated::Class()) 
-      solid = convertShape<TGeoTessellated>(shape);
+    else if (isa == TGeoTessellated::Class())   {
+      // Voxelization of large meshes dominates the conversion: close the solids later in parallel
+      bool defer = numThreads > 1 && ((const TGeoTessellated*)shape)->IsClosedBody();
+      solid = convertTessellatedShape(shape, !defer);
+      if ( defer ) m_openSolids.emplace_back((G4TessellatedSolid*)solid);
+    }
     else if (isa == TGeoScaledShape::Class())  {
       TGeoScaledShape* sh   = (TGeoScaledShape*) shape;
       TGeoShape*       sol  = sh->GetShape();
@@ -1670,6 +1679,31 @@ void* Geant4Converter::printPlacement(const std::string& name, const TGeoNode* n
   return g4;
 }
 
+/// Close all pending tessellated solids using the requested number of threads
+void Geant4Converter::closeSolids()  const   {
+  std::size_t num_solids  = m_openSolids.size();
+  std::size_t num_threads = std::min(std::size_t(std::max(numThreads, 1)), num_solids);
+  std::atomic<std::size_t> next(0);
+  // The solids are independent objects, which are not registered to any store.
+  // The default voxel count however is thread local in Geant4.
+  int voxels = G4Voxelizer::GetDefaultVoxelsCount();
+  auto work = [this, num_solids, voxels, &next]()  {
+    G4Voxelizer::SetDefaultVoxelsCount(voxels);
+    for( std::size_t i = next++; i < num_solids; i = next++ )
+      m_openSolids[i]->SetSolidClosed(true);
+  };
+  std::vector<std::thread> workers;
+  for( std::size_t i = 1; i < num_threads; ++i )
+    workers.emplace_back(work);
+  work();
+  for( auto& t : workers ) t.join();
+  if ( num_solids > 0 )   {
+    printout(outputLevel, "Geant4Converter", "++ Closed %ld tessellated solids with %ld threads.",
+             num_solids, num_threads);
+  }
+  m_openSolids.clear();
+}
+
 /// Create geometry conversion
 Geant4Converter& Geant4Converter::create(DetElement top) {
   typedef std::map<const TGeoNode*, std::vector<TGeoNode*> > _DAU;
@@ -1684,6 +1718,14 @@ Geant4Converter& Geant4Converter::create(DetElement top) {
   geo.manager = &wrld.detectorDescription().manager();
   this->collect(top, geo);
   this->checkOverlaps = false;
+  TTimeStamp stage;
+  auto elapsed = [&stage]()  {
+    TTimeStamp now;
+    double     delta = now.AsDouble() - stage.AsDouble();
+    stage = now;
+    return delta;
+  };
+  printout(outputLevel, "Geant4Converter", "++ Collected geometry. [%7.3f seconds]", elapsed());
   // We do not have to handle defines etc.
   // All positions and the like are not really named.
   // Hence, start creating the G4 objects for materials, solids and log volumes.
@@ -1691,25 +1733,38 @@ Geant4Converter& Geant4Converter::create(DetElement top) {
   handleArray(this, geo.manager->GetListOfOpticalSurfaces(), &Geant4Converter::handleOpticalSurface);
   
   handle(this,     geo.volumes, &Geant4Converter::collectVolume);
+  printout(outputLevel, "Geant4Converter", "++ Handled %ld materials. [%7.3f seconds]",
+           geo.g4Materials.size(), elapsed());
   handle(this,     geo.solids,  &Geant4Converter::handleSolid);
-  printout(outputLevel, "Geant4Converter", "++ Handled %ld solids.", geo.solids.size());
+  closeSolids();
+  printout(outputLevel, "Geant4Converter", "++ Handled %ld solids. [%7.3f seconds]",
+           geo.solids.size(), elapsed());
   handleRefs(this, geo.vis,     &Geant4Converter::handleVis);
-  printout(outputLevel, "Geant4Converter", "++ Handled %ld visualization attributes.", geo.vis.size());
+  printout(outputLevel, "Geant4Converter", "++ Handled %ld visualization attributes. [%7.3f seconds]",
+           geo.vis.size(), elapsed());
   handleMap(this,  geo.limits,  &Geant4Converter::handleLimitSet);
-  printout(outputLevel, "Geant4Converter", "++ Handled %ld limit sets.", geo.limits.size());
+  printout(outputLevel, "Geant4Converter", "++ Handled %ld limit sets. [%7.3f seconds]",
+           geo.limits.size(), elapsed());
   handleMap(this,  geo.regions, &Geant4Converter::handleRegion);
-  printout(outputLevel, "Geant4Converter", "++ Handled %ld regions.", geo.regions.size());
+  printout(outputLevel, "Geant4Converter", "++ Handled %ld regions. [%7.3f seconds]",
+           geo.regions.size(), elapsed());
   handle(this,     geo.volumes, &Geant4Converter::handleVolume);
-  printout(outputLevel, "Geant4Converter", "++ Handled %ld volumes.", geo.volumes.size());
+  closeSolids();
+  printout(outputLevel, "Geant4Converter", "++ Handled %ld volumes. [%7.3f seconds]",
+           geo.volumes.size(), elapsed());
   handleRMap(this, *m_data,     &Geant4Converter::handleAssembly);
   // Now place all this stuff appropriately
   //handleRMap(this, *m_data,     &Geant4Converter::handlePlacement);
+  std::size_t num_placements = 0;
   std::map<int, std::vector<const TGeoNode*> >::const_reverse_iterator i = m_data->rbegin();
   for ( ; i != m_data->rend(); ++i )  {
     for ( const TGeoNode* node : i->second )  {
       this->handlePlacement(node->GetName(), node);
     }
+    num_placements += i->second.size();
   }
+  printout(outputLevel, "Geant4Converter", "++ Handled %ld placements. [%7.3f seconds]",
+           num_placements, elapsed());
   /// Handle concrete surfaces
   handleArray(this, geo.manager->GetListOfSkinSurfaces(),   &Geant4Converter::handleSkinSurface);
   handleArray(this, geo.manager->GetListOfBorderSurfaces(), &Geant4Converter::handleBorderSurface);
@@ -71,7 +71,9 @@ Geant4HitData::Contribution Geant4HitData::extractContribution(const G4Step* ste
   double               len   = (post-pre).mag() ;
   double               position[] = { (pre.x()+post.x())/2.0,(pre.y()+post.y())/2.0,(pre.z()+post.z())/2.0 };
   double               momentum[] = { mom.x(), mom.y(), mom.z() };
-  return Contribution(h.trkID(), h.trkPdgID(), deposit, h.trkTime(), len, position, momentum);
+  Contribution contrib(h.trkID(), h.trkPdgID(), deposit, h.trkTime(), len, position, momentum);
+  contrib.weight = h.track->GetWeight();
+  return contrib;
 }
 
 /// Extract the MC contribution for a given hit from the step information with BirksLaw effect option
@@ -86,7 +88,9 @@ Geant4HitData::Contribution Geant4HitData::extractContribution(const G4Step* ste
   double length = (post-pre).mag() ;
   double momentum[] = { mom.x(), mom.y(), mom.z() };
   double position[] = { (pre.x()+post.x())/2.0,(pre.y()+post.y())/2.0,(pre.z()+post.z())/2.0 };
-  return Contribution(h.trkID(), h.trkPdgID(), deposit, h.trkTime(), length, position, momentum);
+  Contribution contrib(h.trkID(), h.trkPdgID(), deposit, h.trkTime(), length, position, momentum);
+  contrib.weight = h.track->GetWeight();
+  return contrib;
 }
 
 /// Extract the MC contribution for a given hit from the fast simulation spot information
@@ -97,7 +101,9 @@ Geant4HitData::Contribution Geant4HitData::extractContribution(const Geant4FastS
   G4ThreeVector        pos = h.avgPositionG4();
   double               position[] = { pos.x(), pos.y(), pos.z() };
   double               momentum[] = { mom.x(), mom.y(), mom.z() };
-  return Contribution( h.trkID(), h.trkPdgID(), h.energy(), h. trkTime(), 0e0, position, momentum);
+  Contribution contrib(h.trkID(), h.trkPdgID(), h.energy(), h.trkTime(), 0e0, position, momentum);
+  contrib.weight = t->GetWeight();
+  return contrib;
 }
 
 /// Default constructor
@@ -162,6 +168,7 @@ Geant4Tracker::Hit& Geant4Tracker::Hit::storePoint(const G4Step* step, const G4S
   truth.trackID = trk->GetTrackID();
   truth.pdgID   = trk->GetDefinition()->GetPDGEncoding();
   truth.time    = trk->GetGlobalTime();
+  truth.weight  = trk->GetWeight();
   truth.setPosition(pos.x(), pos.y(), pos.z()); 
   truth.setMomentum(trm.x(), trm.y(), trm.z()); 
 
@@ -184,6 +191,7 @@ Geant4Tracker::Hit& Geant4Tracker::Hit::storePoint(const Geant4FastSimSpot* spot
   this->truth.trackID = trk->GetTrackID();
   this->truth.time    = trk->GetGlobalTime();
   this->truth.pdgID   = trk->GetDefinition()->GetPDGEncoding();
+  this->truth.weight  = trk->GetWeight();
   this->truth.setPosition(pos.x(), pos.y(), pos.z()); 
   this->truth.setMomentum(trm.x(), trm.y(), trm.z()); 
 
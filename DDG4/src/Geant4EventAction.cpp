@@ -108,6 +108,8 @@ Geant4EventActionSequence::~Geant4EventActionSequence() {
   m_begin.clear();
   m_end.clear();
   m_final.clear();
+  m_beginSub.clear();
+  m_endSub.clear();
   InstanceCount::decrement(this);
 }
 
@@ -150,3 +152,13 @@ void Geant4EventActionSequence::end(const G4Event* event)   {
   m_actors(&Geant4EventAction::end, event);
   m_final(event);
 }
+
+/// Begin-of-sub-event callback. Only the registered callbacks are called.
+void Geant4EventActionSequence::beginSubEvent(const G4Event* event)   {
+  m_beginSub(event);
+}
+
+/// End-of-sub-event callback. Only the registered callbacks are called.
+void Geant4EventActionSequence::endSubEvent(const G4Event* event)   {
+  m_endSub(event);
+}
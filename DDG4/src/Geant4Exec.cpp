@@ -28,6 +28,8 @@
 #include <DDG4/Geant4UIManager.h>
 #include <DDG4/Geant4Kernel.h>
 #include <DDG4/Geant4Random.h>
+#include <DDG4/Geant4HitCollection.h>
+#include <DDG4/Geant4Particle.h>
 
 // Geant4 include files
 #include <G4Version.hh>
@@ -41,9 +43,17 @@
 #include <G4VUserPrimaryGeneratorAction.hh>
 #include <G4VUserActionInitialization.hh>
 #include <G4VUserDetectorConstruction.hh>
+#include <G4VUserEventInformation.hh>
+#include <G4HCofThisEvent.hh>
+#include <G4EventManager.hh>
+#include <G4RunManager.hh>
+#include <G4Event.hh>
 
 // C/C++ include files
+#include <map>
+#include <algorithm>
 #include <memory>
+#include <vector>
 #include <stdexcept>
 
 namespace {
@@ -145,6 +155,29 @@ namespace dd4hep {
     class Geant4UserRunAction;
     class Geant4UserEventAction;
 
+#if G4VERSION_NUMBER >= 1120
+    /// Sub-event parallel mode: particle record of a sub-event, attached to the G4Event
+    /** @class Geant4SubEventInformation
+     *
+     * @author  M.Frank
+     * @version 1.0
+     */
+    class Geant4SubEventInformation : public G4VUserEventInformation  {
+    public:
+      /// Particles of the sub-event to be merged into the master event
+      Geant4ParticleMap particles;
+    public:
+      /// Default constructor
+      Geant4SubEventInformation() = default;
+      /// Default destructor
+      virtual ~Geant4SubEventInformation() = default;
+      /// G4VUserEventInformation overload
+      virtual void Print() const  override  {
+        particles.dump();
+      }
+    };
+#endif
+
     /// Concrete implementation of the Geant4 run action
     /** @class Geant4UserRunAction
      *
@@ -197,6 +230,26 @@ namespace dd4hep {
       virtual void BeginOfEventAction(const G4Event* evt)  final;
       /// End-of-event callback
       virtual void EndOfEventAction(const G4Event* evt)  final;
+#if G4VERSION_NUMBER >= 1120
+      /// Sub-event parallel mode: collect the hits and particles of a finished sub-event
+      virtual void MergeSubEvent(G4Event* master, const G4Event* sub)  final;
+      /// Sub-event parallel mode: finish master events once all their sub-events are merged
+      void finishPendingEvents(bool all);
+      /// Sub-event parallel mode: merge the collected sub-events into the master event
+      void mergeSubEvents(const G4Event* evt);
+    protected:
+      /// Hits and particles of a finished sub-event
+      struct SubEvent  {
+        std::unique_ptr<Geant4ParticleMap> particles;
+        std::vector<std::pair<int, std::unique_ptr<Geant4HitCollection> > > hits;
+      };
+      /// Finished sub-events by master event
+      std::map<const G4Event*, std::vector<SubEvent> > m_subEvents;
+      /// Master events waiting for sub-events together with their suspended event context
+      std::vector<std::pair<const G4Event*, Geant4Event*> > m_pendingEvents;
+      /// Flag if the current event is a sub-event without DDG4 event context
+      bool m_subEvent = false;
+#endif
     };
 
     /// Concrete implementation of the Geant4 tracking action
@@ -368,6 +421,9 @@ namespace dd4hep {
       virtual void Build()  const  final;
       /// Build the action sequences for the master thread
       virtual void BuildForMaster()  const  final;
+    protected:
+      /// Install the DDG4 user actions of a kernel instance
+      Geant4UserEventAction* buildActions(Geant4Kernel& krnl, Geant4Context* ctx)  const;
     };
 
     /// Begin-of-run callback
@@ -380,6 +436,9 @@ namespace dd4hep {
 
     /// End-of-run callback
     void Geant4UserRunAction::EndOfRunAction(const G4Run* run) {
+#if G4VERSION_NUMBER >= 1120
+      if ( eventAction ) eventAction->finishPendingEvents(true);
+#endif
       if ( m_sequence ) m_sequence->end(run); // Action not mandatory
       kernel().executePhase("end-run",(const void**)&run);
       destroyClientContext(run);
@@ -387,17 +446,130 @@ namespace dd4hep {
 
     /// Begin-of-event callback
     void Geant4UserEventAction::BeginOfEventAction(const G4Event* evt) {
+#if G4VERSION_NUMBER >= 1120
+      /// Sub-events have no primaries generated by DDG4: only provide the event context
+      /// and a particle map, which is shipped with the G4Event back to the master.
+      /// The results are handled by the event actions of the master event.
+      m_subEvent = nullptr == context()->eventPtr();
+      if ( m_subEvent )  {
+        auto* info = new Geant4SubEventInformation();
+        G4EventManager::GetEventManager()->SetUserInformation(info);
+        createClientContext(evt);
+        context()->event().addExtension(&info->particles, false);
+        if ( m_sequence ) m_sequence->beginSubEvent(evt);
+        return;
+      }
+      finishPendingEvents(false);
+#endif
       kernel().executePhase("begin-event",(const void**)&evt);
       if ( m_sequence ) m_sequence->begin(evt); // Action not mandatory
     }
 
     /// End-of-event callback
     void Geant4UserEventAction::EndOfEventAction(const G4Event* evt) {
+#if G4VERSION_NUMBER >= 1120
+      if ( m_subEvent )  {
+        if ( m_sequence ) m_sequence->endSubEvent(evt);
+        destroyClientContext(evt);
+        return;
+      }
+      else if ( evt->GetNumberOfRemainingSubEvents() > 0 )  {
+        /// Suspend the event context until the sub-events are merged.
+        /// The sub-event run manager holds the event while sub-events remain;
+        /// the grip keeps it until the event is finished and is released then.
+        G4AutoLock protection_lock(&action_mutex);
+        evt->Grip();
+        m_pendingEvents.emplace_back(evt, context()->eventPtr());
+        context()->setEvent(0);
+        return;
+      }
+#endif
       if ( m_sequence ) m_sequence->end(evt); // Action not mandatory
       kernel().executePhase("end-event",(const void**)&evt);
       destroyClientContext(evt);
     }
 
+#if G4VERSION_NUMBER >= 1120
+    /// Sub-event parallel mode: collect the hits and particles of a finished sub-event
+    void Geant4UserEventAction::MergeSubEvent(G4Event* master, const G4Event* sub)  {
+      SubEvent sub_event;
+      sub_event.particles = std::make_unique<Geant4ParticleMap>();
+      if ( auto* info = dynamic_cast<Geant4SubEventInformation*>(sub->GetUserInformation()) )  {
+        sub_event.particles->adopt(info->particles.particleMap, info->particles.equivalentTracks);
+      }
+      /// Take the hit collections: the track identifiers are remapped at the end of the master event
+      if ( G4HCofThisEvent* source = sub->GetHCofThisEvent() )  {
+        for( std::size_t i = 0, n = source->GetNumberOfCollections(); i < n; ++i )   {
+          Geant4HitCollection* from = dynamic_cast<Geant4HitCollection*>(source->GetHC(i));
+          if ( from && from->GetSize() > 0 )  {
+            source->AddHitsCollection(int(i), nullptr);
+            sub_event.hits.emplace_back(int(i), std::unique_ptr<Geant4HitCollection>(from));
+          }
+        }
+      }
+      G4AutoLock protection_lock(&action_mutex);
+      m_subEvents[master].emplace_back(std::move(sub_event));
+    }
+
+    /// Sub-event parallel mode: merge the collected sub-events into the master event
+    /** Called after the particle handler finished the master event and before the
+     *  output actions. The Geant4 track identifiers of each sub-event are shifted
+     *  behind the identifiers already present in the particle map of the event.
+     */
+    void Geant4UserEventAction::mergeSubEvents(const G4Event* evt)  {
+      std::vector<SubEvent> sub_events;
+      {
+        G4AutoLock protection_lock(&action_mutex);
+        auto i = m_subEvents.find(evt);
+        if ( i == m_subEvents.end() ) return;
+        sub_events = std::move((*i).second);
+        m_subEvents.erase(i);
+      }
+      G4HCofThisEvent*   target    = evt->GetHCofThisEvent();
+      Geant4ParticleMap* particles = context()->event().extension<Geant4ParticleMap>(false);
+      int track_offset = 0;
+      for( auto& sub_event : sub_events )   {
+        if ( particles )   {
+          const auto& equivalents = particles->equivalentTracks;
+          if ( !equivalents.empty() )
+            track_offset = std::max(track_offset, (*equivalents.rbegin()).first);
+          particles->merge(*sub_event.particles, track_offset);
+        }
+        /// Hit collection identifiers are global: the same index refers to the same collection
+        for( auto& hits : sub_event.hits )   {
+          Geant4HitCollection* to = target ? dynamic_cast<Geant4HitCollection*>(target->GetHC(hits.first)) : nullptr;
+          if ( to ) to->merge(*hits.second, track_offset);
+        }
+      }
+    }
+
+    /// Sub-event parallel mode: finish master events once all their sub-events are merged
+    void Geant4UserEventAction::finishPendingEvents(bool all)  {
+      std::vector<std::pair<const G4Event*, Geant4Event*> > ready;
+      {
+        G4AutoLock protection_lock(&action_mutex);
+        for( auto i = m_pendingEvents.begin(); i != m_pendingEvents.end(); )  {
+          if ( all || (*i).first->GetNumberOfRemainingSubEvents() == 0 )  {
+            ready.emplace_back(*i);
+            i = m_pendingEvents.erase(i);
+            continue;
+          }
+          ++i;
+        }
+      }
+      Geant4Event* current = context()->eventPtr();
+      for( auto& e : ready )  {
+        const G4Event* evt = e.first;
+        context()->setEvent(e.second);
+        if ( m_sequence ) m_sequence->end(evt); // Action not mandatory
+        kernel().executePhase("end-event",(const void**)&evt);
+        destroyClientContext(evt);
+        evt->Release();
+      }
+      context()->setEvent(current);
+    }
+#endif
+
     /// Generate primary particles
     void Geant4UserGeneratorAction::GeneratePrimaries(G4Event* event) {
       createClientContext(event);
@@ -450,6 +622,31 @@ namespace dd4hep {
         m_sequence->build();
         m_sequence->updateContext(old);
       }
+      buildActions(krnl, ctx);
+    }
+
+    /// Build the action sequences for the master thread
+    void Geant4UserActionInitialization::BuildForMaster()  const  {
+      if ( m_sequence )   {
+        m_sequence->info("+++ Executing Geant4UserActionInitialization::BuildForMaster....");
+        m_sequence->buildMaster();
+      }
+#if G4VERSION_NUMBER >= 1120
+      /// Sub-event parallel mode: the master thread tracks the primaries and merges the sub-events
+      if ( G4RunManager::GetRunManager()->GetRunManagerType() == G4RunManager::subEventMasterRM )  {
+        G4AutoLock protection_lock(&action_mutex);
+        Geant4Kernel& krnl = kernel();
+        Geant4UserEventAction* evt_action = buildActions(krnl, krnl.workerContext());
+        if ( evt_action->m_sequence )  {
+          evt_action->m_sequence->callAtEnd(evt_action, &Geant4UserEventAction::mergeSubEvents);
+        }
+      }
+#endif
+    }
+
+    /// Install the DDG4 user actions of a kernel instance
+    Geant4UserEventAction*
+    Geant4UserActionInitialization::buildActions(Geant4Kernel& krnl, Geant4Context* ctx)  const   {
       /// Set user generator action sequence. Not optional, since event context is defined inside
       Geant4UserGeneratorAction* gen_action = new Geant4UserGeneratorAction(ctx,krnl.generatorAction(false));
       SetUserAction(gen_action);
@@ -482,16 +679,9 @@ namespace dd4hep {
         Geant4UserStackingAction* action = new Geant4UserStackingAction(ctx, stk_action);
         SetUserAction(action);
       }
-      
+      return evt_action;
     }
 
-    /// Build the action sequences for the master thread
-    void Geant4UserActionInitialization::BuildForMaster()  const  {
-      if ( m_sequence )   {
-        m_sequence->info("+++ Executing Geant4UserActionInitialization::BuildForMaster....");
-        m_sequence->buildMaster();
-      }
-    }
     
     /// Compatibility actions for running Geant4 in single threaded mode
     /** @class Geant4Compatibility
@@ -176,3 +176,66 @@ void Geant4HitCollection::getHitsUnchecked(std::vector<void*>& result) {
     result.emplace_back(w.data());
   }
 }
+
+/// Move all hits of a collection of the same type to this container. Ownership is transferred.
+/** Hits of the DDG4 tracker and calorimeter types, which have a key already present
+ *  in this collection, are folded into the existing hit: the energy deposits are added
+ *  and the Monte Carlo contributions are appended. The track identifiers of the source
+ *  hits are shifted by 'track_offset'. Hits of other types are always appended.
+ */
+void Geant4HitCollection::merge(Geant4HitCollection& source, int track_offset)   {
+  if ( source.m_manipulator != m_manipulator )  {
+    throw std::runtime_error("Attempt to merge G4 hit-collection "+source.GetName()+
+                             " with a different hit type into "+GetName());
+  }
+  bool is_tracker = m_manipulator == Geant4HitWrapper::manipulator<Geant4Tracker::Hit>();
+  bool is_calo    = m_manipulator == Geant4HitWrapper::manipulator<Geant4Calorimeter::Hit>();
+  if ( track_offset != 0 )   {
+    for (Geant4HitWrapper& w : source.m_hits)   {
+      if ( is_tracker )  {
+        Geant4Tracker::Hit* hit = (Geant4Tracker::Hit*)w.data();
+        if ( hit->truth.trackID > 0 ) hit->truth.trackID += track_offset;
+        if ( hit->g4ID > 0 ) hit->g4ID += track_offset;
+      }
+      else if ( is_calo )  {
+        Geant4Calorimeter::Hit* hit = (Geant4Calorimeter::Hit*)w.data();
+        for (auto& c : hit->truth)
+          if ( c.trackID > 0 ) c.trackID += track_offset;
+        if ( hit->g4ID > 0 ) hit->g4ID += track_offset;
+      }
+    }
+  }
+  /// Fold the hits of cells already present in this collection
+  std::vector<bool> folded(source.m_hits.size(), false);
+  if ( is_tracker || is_calo )   {
+    for (const auto& k : source.m_keys)  {
+      Keys::const_iterator i = m_keys.find(k.first);
+      if ( i == m_keys.end() ) continue;
+      if ( is_tracker )  {
+        Geant4Tracker::Hit* to   = (Geant4Tracker::Hit*)m_hits.at((*i).second).data();
+        Geant4Tracker::Hit* from = (Geant4Tracker::Hit*)source.m_hits.at(k.second).data();
+        to->energyDeposit += from->energyDeposit;
+        to->truth.deposit += from->truth.deposit;
+      }
+      else  {
+        Geant4Calorimeter::Hit* to   = (Geant4Calorimeter::Hit*)m_hits.at((*i).second).data();
+        Geant4Calorimeter::Hit* from = (Geant4Calorimeter::Hit*)source.m_hits.at(k.second).data();
+        to->energyDeposit += from->energyDeposit;
+        to->truth.insert(to->truth.end(), from->truth.begin(), from->truth.end());
+      }
+      folded[k.second] = true;
+    }
+  }
+  /// Append the remaining hits. Folded hits are deleted with the source collection
+  std::vector<std::size_t> index(source.m_hits.size(), 0);
+  m_hits.reserve(m_hits.size()+source.m_hits.size());
+  for (std::size_t j = 0, n = source.m_hits.size(); j < n; ++j)  {
+    if ( folded[j] ) continue;
+    index[j] = m_hits.size();
+    m_hits.emplace_back(source.m_hits[j]);   // Copy transfers the ownership
+  }
+  for (const auto& k : source.m_keys)  {
+    if ( !folded[k.second] ) m_keys.emplace(k.first, index[k.second]);
+  }
+  source.clear();
+}
@@ -75,6 +75,7 @@ dd4hep::sim::createPrimary(int particle_id,
   p->colorFlow[0] = 0;
   p->mass         = g4p->GetMass();
   p->charge       = int(3.0 * g4p->GetCharge());
+  p->weight       = g4p->GetWeight();
   PropertyMask status(p->status);
   status.set(G4PARTICLE_GEN_STABLE);
   return p;
@@ -372,6 +373,7 @@ static G4PrimaryParticle* createG4Primary(const Geant4ParticleHandle p)  {
     g4 = new G4PrimaryParticle(def, p->psx, p->psy, p->psz, energy);
     g4->SetCharge(double(p.charge())/3.0);
   }
+  g4->SetWeight(p->weight);
   // The particle is fully defined with the 4-vector set above, setting the mass isn't necessary, not
   // using the 4-vector, means the PDG mass is used, and the momentum is scaled if the mass is set here
   // g4->SetMass(p->mass);
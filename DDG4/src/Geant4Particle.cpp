@@ -92,6 +92,7 @@ Geant4Particle& Geant4Particle::get_data(Geant4Particle& c)   {
     mass        = c.mass;
     time        = c.time;
     properTime  = c.properTime;
+    weight      = c.weight;
     process     = c.process;
     //definition  = c.definition;
     daughters   = c.daughters;
@@ -528,6 +529,55 @@ void Geant4ParticleMap::adopt(ParticleMap& pm, TrackEquivalents& equiv)    {
   //dump();
 }
 
+/// Merge the particles of a sub-event. The Geant4 track identifiers of the sub-event are shifted by 'track_offset'
+void Geant4ParticleMap::merge(Geant4ParticleMap& sub, int track_offset)    {
+  int next_id = particleMap.empty() ? 0 : (*particleMap.rbegin()).first + 1;
+  TrackEquivalents ids;
+  // (1) Append the particles in the order of the sub-event tracks
+  for( auto& part : sub.particleMap )  {
+    Particle* p = part.second;
+    ids[part.first] = next_id;
+    p->id = next_id;
+    p->parents.clear();
+    p->daughters.clear();
+    particleMap[next_id++] = p;
+  }
+  // Resolve a Geant4 track identifier of the sub-event to a particle identifier.
+  // Negative identifiers refer to the tracks of this event, which created the shipped tracks.
+  auto resolve = [&ids, &sub, this](int g4_id)  {
+    for( int count = int(sub.equivalentTracks.size()); g4_id > 0 && count >= 0; --count )  {
+      if( auto i = ids.find(g4_id); i != ids.end() ) return (*i).second;
+      auto e = sub.equivalentTracks.find(g4_id);
+      if( e == sub.equivalentTracks.end() ) return -1;
+      g4_id = (*e).second;
+    }
+    if( g4_id < 0 )  {
+      if( auto e = equivalentTracks.find(-g4_id); e != equivalentTracks.end() ) return (*e).second;
+    }
+    return -1;
+  };
+  // (2) Map the shifted Geant4 track identifiers to the new particle identifiers
+  for( const auto& equiv : sub.equivalentTracks )  {
+    if( int pid = resolve(equiv.first); pid >= 0 )
+      equivalentTracks[equiv.first + track_offset] = pid;
+    else
+      printout(ERROR,"Geant4ParticleMap","+++ No Equivalent particle for sub-event track:%d.",equiv.first);
+  }
+  // (3) Re-establish the mother daughter relationships
+  for( const auto& part : sub.particleMap )  {
+    Particle* p = part.second;
+    int parent_id = resolve(p->g4Parent);
+    p->g4Parent = p->g4Parent < 0 ? -p->g4Parent : p->g4Parent + track_offset;
+    p->originalG4ID += track_offset;
+    if( auto ip = particleMap.find(parent_id); ip != particleMap.end() )  {
+      p->parents.insert(parent_id);
+      (*ip).second->daughters.insert(p->id);
+    }
+  }
+  sub.particleMap.clear();
+  sub.equivalentTracks.clear();
+}
+
 /// Check if the particle map was ever filled (ie. some particle handler was present)
   bool Geant4ParticleMap::isValid() const   {
   return !equivalentTracks.empty();
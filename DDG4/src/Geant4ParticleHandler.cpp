@@ -51,6 +51,8 @@ Geant4ParticleHandler::Geant4ParticleHandler(Geant4Context* ctxt, const std::str
   //generatorAction().adopt(this);
   eventAction().callAtBegin(this,    &Geant4ParticleHandler::beginEvent);
   eventAction().callAtEnd(this,      &Geant4ParticleHandler::endEvent);
+  eventAction().callAtSubEventBegin(this, &Geant4ParticleHandler::beginSubEvent);
+  eventAction().callAtSubEventEnd(this,   &Geant4ParticleHandler::endSubEvent);
   trackingAction().callAtFinal(this, &Geant4ParticleHandler::end,CallbackSequence::FRONT);
   trackingAction().callUpFront(this, &Geant4ParticleHandler::begin,CallbackSequence::FRONT);
   steppingAction().call(this,        &Geant4ParticleHandler::step);
@@ -182,6 +184,11 @@ void Geant4ParticleHandler::operator()(G4Event* event)  {
 void Geant4ParticleHandler::step(const G4Step* step_value, G4SteppingManager* mgr)   {
   typedef std::vector<const G4Track*> _Sec;
   ++m_currTrack.steps;
+  if ( m_subEvent )  {
+    /// Remember the tracks created inside the sub-event to recognize the shipped tracks
+    const _Sec* sec = step_value->GetSecondaryInCurrentStep();
+    m_subEventSecondaries.insert(sec->begin(), sec->end());
+  }
   if ( (m_currTrack.reason&G4PARTICLE_ABOVE_ENERGY_THRESHOLD) )  {
     //
     // Tracks below the energy threshold are NOT stored.
@@ -228,7 +235,7 @@ void Geant4ParticleHandler::begin(const G4Track* track)   {
     }
   }
 
-  if ( prim )   {
+  if ( prim && m_primaryMap )   {
     prim_part = m_primaryMap->get(prim);
     if ( !prim_part )  {
       except("+++ Tracking preaction: Primary particle without generator particle!");
@@ -275,9 +282,14 @@ void Geant4ParticleHandler::begin(const G4Track* track)   {
   m_currTrack.steps       = 0;
   m_currTrack.secondaries = 0;
   m_currTrack.g4Parent    = h.parent();
+  if ( m_subEvent && m_subEventSecondaries.erase(track) == 0 )  {
+    /// Shipped track: the parent was tracked by the master event. Mark it negative.
+    m_currTrack.g4Parent  = -m_currTrack.g4Parent;
+  }
   m_currTrack.originalG4ID= h.id();
   m_currTrack.process     = h.creatorProcess();
   m_currTrack.time        = h.globalTime();
+  m_currTrack.weight      = h.weight();
   m_currTrack.vsx         = v.x();
   m_currTrack.vsy         = v.y();
   m_currTrack.vsz         = v.z();
@@ -392,7 +404,7 @@ void Geant4ParticleHandler::end(const G4Track* track)   {
     }
     if ( ip != m_particleMap.end() )
       (*ip).second->reason |= track_reason;
-    else
+    else if ( !(m_subEvent && pid < 0) )  // Parent tracked by the master event
       ph.dumpWithVertex(outputLevel()+3,name(),"FATAL: No real particle parent present");
   }
 
@@ -422,6 +434,39 @@ void Geant4ParticleHandler::beginEvent(const G4Event* event)  {
   }
 }
 
+/// Pre-sub-event action callback (sub-event parallel mode, worker threads only)
+void Geant4ParticleHandler::beginSubEvent(const G4Event* event)  {
+  typedef Geant4MonteCarloTruth _MC;
+  debug("+++ Event:%d Begin sub-event. Add EVENT extension of type Geant4ParticleHandler.",
+        event->GetEventID());
+  context()->event().addExtension((_MC*)this, false);
+  clear();
+  m_subEventSecondaries.clear();
+  m_primaryMap = 0;
+  m_globalParticleID = 0;
+  m_subEvent = true;
+}
+
+/// Post-sub-event action callback: export the particles to be merged into the master event
+void Geant4ParticleHandler::endSubEvent(const G4Event* event)  {
+  int count = 0;
+  do {
+    debug("+++ Sub-event iteration:%d Tracks:%d Equivalents:%d",
+          ++count,m_particleMap.size(),m_equivalentTracks.size());
+  } while( recombineParents() > 0 );
+  /// The particles are rebased when merged into the master event
+  if ( Geant4ParticleMap* part_map = context()->event().extension<Geant4ParticleMap>(false) )  {
+    part_map->adopt(m_particleMap, m_equivalentTracks);
+  }
+  else  {
+    warning("+++ Event:%d No particle map present to export the sub-event particles.",
+            event->GetEventID());
+  }
+  m_subEventSecondaries.clear();
+  m_subEvent = false;
+  clear();
+}
+
 /// Debugging: Dump Geant4 particle map
 void Geant4ParticleHandler::dumpMap(const char* tag)  const  {
   const std::string& n = name();
@@ -30,6 +30,9 @@ namespace dd4hep {
     /// Convert a specific TGeo shape into the geant4 equivalent
     template <typename T> G4VSolid* convertShape(const TGeoShape* shape);
 
+    /// Convert a tessellated shape. The solid is only closed (and voxelized) if requested
+    G4VSolid* convertTessellatedShape(const TGeoShape* shape, bool close);
+
   }    // End namespace sim
 }      // End namespace dd4hep
 #endif // DDG4_SRC_GEANT4SHAPECONVERTER_H
@@ -0,0 +1,224 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Printout.h>
+#include <DDG4/Geant4ShowerLibrary.h>
+
+// C/C++ include files
+#include <cmath>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace dd4hep::sim;
+
+namespace  {
+
+  /// File signature and format version
+  const char          LIB_MAGIC[8] = { 'D','D','4','h','e','p','S','L' };
+  const std::uint32_t LIB_VERSION  = 1;
+
+  /// Library file header. All members naturally aligned
+  struct Header  {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t numEnergy;
+    std::uint32_t numTheta;
+    std::uint32_t numDepth;
+    double        energyMin;
+    double        energyMax;
+    double        thetaMax;
+    double        depthMin;
+    double        depthMax;
+    double        depthPeriod;
+    std::uint64_t numShowers;
+    std::uint64_t numSpots;
+  };
+  static_assert(sizeof(Header) == 88, "Unexpected padding of the shower library header");
+
+  /// Index of x in [x_min, x_max) with n equidistant bins. -1 if outside
+  inline long index(double x, double x_min, double x_max, std::uint32_t n)  {
+    if ( !(x >= x_min) || !(x < x_max) ) return -1;
+    long i = long( (x - x_min) / (x_max - x_min) * double(n) );
+    return i < long(n) ? i : long(n) - 1;
+  }
+}
+
+/// Initializing constructor to fill a new library
+Geant4ShowerLibrary::Geant4ShowerLibrary(const Binning& binning)   {
+  setBinning(binning);
+  m_pending.resize(numBins());
+}
+
+/// Default destructor. Unmaps the library file
+Geant4ShowerLibrary::~Geant4ShowerLibrary()   {
+  close();
+}
+
+/// Check and apply a binning
+void Geant4ShowerLibrary::setBinning(const Binning& b)   {
+  if ( b.numEnergy < 1 || b.numTheta < 1 || b.numDepth < 1 ||
+       !(b.energyMin > 0e0) || !(b.energyMax > b.energyMin) ||
+       !(b.thetaMax > 0e0)  || !(b.depthMax > b.depthMin) || b.depthPeriod < 0e0 )   {
+    dd4hep::except("Geant4ShowerLibrary","+++ Invalid binning: E:[%g,%g]x%u theta:[0,%g]x%u depth:[%g,%g]x%u period:%g",
+           b.energyMin, b.energyMax, b.numEnergy, b.thetaMax, b.numTheta,
+           b.depthMin, b.depthMax, b.numDepth, b.depthPeriod);
+  }
+  m_binning = b;
+}
+
+/// Map a library file read-only into memory
+void Geant4ShowerLibrary::open(const std::string& file_name)   {
+  struct stat st;
+  close();
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+  if ( fd < 0 || ::fstat(fd, &st) != 0 )   {
+    int err = errno;
+    if ( fd >= 0 ) ::close(fd);
+    dd4hep::except("Geant4ShowerLibrary","+++ Cannot open shower library %s: %s", file_name.c_str(), std::strerror(err));
+  }
+  std::size_t len = std::size_t(st.st_size);
+  void* map = len >= sizeof(Header) ? ::mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+  ::close(fd);
+  if ( map == MAP_FAILED )   {
+    dd4hep::except("Geant4ShowerLibrary","+++ Cannot map shower library %s [%ld bytes]", file_name.c_str(), long(len));
+  }
+  const Header* hdr = (const Header*)map;
+  Binning b;
+  b.energyMin   = hdr->energyMin;
+  b.energyMax   = hdr->energyMax;
+  b.thetaMax    = hdr->thetaMax;
+  b.depthMin    = hdr->depthMin;
+  b.depthMax    = hdr->depthMax;
+  b.depthPeriod = hdr->depthPeriod;
+  b.numEnergy   = hdr->numEnergy;
+  b.numTheta    = hdr->numTheta;
+  b.numDepth    = hdr->numDepth;
+  std::size_t expected = sizeof(Header) +
+    std::size_t(b.numEnergy) * b.numTheta * b.numDepth * sizeof(Bin) +
+    hdr->numShowers * sizeof(Shower) + hdr->numSpots * sizeof(Spot);
+  if ( std::memcmp(hdr->magic, LIB_MAGIC, sizeof(LIB_MAGIC)) != 0 || hdr->version != LIB_VERSION || expected != len )  {
+    ::munmap(map, len);
+    dd4hep::except("Geant4ShowerLibrary","+++ %s is no shower library file of version %u", file_name.c_str(), LIB_VERSION);
+  }
+  setBinning(b);
+  m_map        = map;
+  m_mapSize    = len;
+  m_numShowers = hdr->numShowers;
+  m_numSpots   = hdr->numSpots;
+  m_bins       = (const Bin*)(hdr + 1);
+  m_showers    = (const Shower*)(m_bins + numBins());
+  m_spots      = (const Spot*)(m_showers + m_numShowers);
+  dd4hep::printout(dd4hep::INFO,"Geant4ShowerLibrary","+++ Mapped shower library %s: %ld showers %ld spots [%ld bytes]",
+           file_name.c_str(), long(m_numShowers), long(m_numSpots), long(len));
+}
+
+/// Unmap the library file
+void Geant4ShowerLibrary::close()   {
+  if ( m_map )   {
+    ::munmap(m_map, m_mapSize);
+  }
+  m_map        = nullptr;
+  m_mapSize    = 0;
+  m_bins       = nullptr;
+  m_showers    = nullptr;
+  m_spots      = nullptr;
+  m_numShowers = 0;
+  m_numSpots   = 0;
+}
+
+/// Bin index of a shower. Returns -1 if outside the library range
+long Geant4ShowerLibrary::bin(double energy, double theta, double depth)  const   {
+  const Binning& b = m_binning;
+  if ( !(energy > 0e0) ) return -1;
+  if ( b.depthPeriod > 0e0 )   {
+    depth -= b.depthPeriod * std::floor(depth / b.depthPeriod);
+  }
+  long ie = index(std::log(energy), std::log(b.energyMin), std::log(b.energyMax), b.numEnergy);
+  long it = index(theta, 0e0, b.thetaMax, b.numTheta);
+  long id = index(depth, b.depthMin, b.depthMax, b.numDepth);
+  if ( ie < 0 || it < 0 || id < 0 ) return -1;
+  return (ie * long(b.numTheta) + it) * long(b.numDepth) + id;
+}
+
+/// Add a new shower to the library in memory. Returns false if outside the library range
+bool Geant4ShowerLibrary::add(double energy, double theta, double depth, std::vector<Spot>&& spots)   {
+  long ibin = bin(energy, theta, depth);
+  if ( ibin < 0 || m_pending.empty() ) return false;
+  m_pending[ibin].emplace_back(float(energy), std::move(spots));
+  return true;
+}
+
+/// Number of showers added in memory
+std::size_t Geant4ShowerLibrary::numPending()  const   {
+  std::size_t num = 0;
+  for( const auto& b : m_pending ) num += b.size();
+  return num;
+}
+
+/// Write the showers added in memory to file
+void Geant4ShowerLibrary::save(const std::string& file_name)  const   {
+  std::ofstream os(file_name, std::ios::binary | std::ios::trunc);
+  if ( !os.good() )   {
+    dd4hep::except("Geant4ShowerLibrary","+++ Cannot open file %s for writing: %s", file_name.c_str(), std::strerror(errno));
+  }
+  Header hdr;
+  std::memset(&hdr, 0, sizeof(hdr));
+  std::memcpy(hdr.magic, LIB_MAGIC, sizeof(LIB_MAGIC));
+  hdr.version     = LIB_VERSION;
+  hdr.numEnergy   = m_binning.numEnergy;
+  hdr.numTheta    = m_binning.numTheta;
+  hdr.numDepth    = m_binning.numDepth;
+  hdr.energyMin   = m_binning.energyMin;
+  hdr.energyMax   = m_binning.energyMax;
+  hdr.thetaMax    = m_binning.thetaMax;
+  hdr.depthMin    = m_binning.depthMin;
+  hdr.depthMax    = m_binning.depthMax;
+  hdr.depthPeriod = m_binning.depthPeriod;
+  for( const auto& b : m_pending )   {
+    hdr.numShowers += b.size();
+    for( const auto& s : b ) hdr.numSpots += s.second.size();
+  }
+  os.write((const char*)&hdr, sizeof(hdr));
+
+  /// Bins, showers and spots are written in the same order
+  std::uint64_t first = 0;
+  for( const auto& b : m_pending )   {
+    Bin entry { first, b.size() };
+    os.write((const char*)&entry, sizeof(entry));
+    first += b.size();
+  }
+  first = 0;
+  for( const auto& b : m_pending )   {
+    for( const auto& s : b )   {
+      Shower entry { first, std::uint32_t(s.second.size()), s.first };
+      os.write((const char*)&entry, sizeof(entry));
+      first += s.second.size();
+    }
+  }
+  for( const auto& b : m_pending )   {
+    for( const auto& s : b )   {
+      os.write((const char*)s.second.data(), s.second.size() * sizeof(Spot));
+    }
+  }
+  if ( !os.good() )   {
+    dd4hep::except("Geant4ShowerLibrary","+++ Failed to write shower library %s", file_name.c_str());
+  }
+  dd4hep::printout(dd4hep::INFO,"Geant4ShowerLibrary","+++ Saved shower library %s: %ld showers %ld spots",
+           file_name.c_str(), long(hdr.numShowers), long(hdr.numSpots));
+}
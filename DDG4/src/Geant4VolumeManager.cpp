@@ -23,13 +23,21 @@
 #include <DDG4/Geant4Mapping.h>
 
 // Geant4 include files
+#include <G4Version.hh>
 #include <G4VTouchable.hh>
 #include <G4LogicalVolume.hh>
 #include <G4VPhysicalVolume.hh>
+#include <G4LogicalVolumeStore.hh>
+
+// ROOT include files
+#include <TSystem.h>
 
 // C/C++ include files
 #include <set>
+#include <cstdlib>
+#include <fstream>
 #include <stdexcept>
+#include <unordered_map>
 #include <string>
 #include <utility>
 #include <vector>
@@ -70,6 +78,7 @@ namespace  {
     typedef std::vector<const TGeoNode*> Chain;
     // typedef std::map<VolumeID,Geant4TouchableHandler::Geant4PlacementPath> Registries;
     typedef std::set<VolumeID> Registries;
+    typedef std::pair<Geant4TouchableHandler::Geant4PlacementPath, Geant4GeometryInfo::Placement> Entry;
 
     /// Reference to the Detector instance
     const Detector&     m_detDesc;
@@ -77,6 +86,8 @@ namespace  {
     Registries          m_entries;
     /// Reference to Geant4 translation information
     Geant4GeometryInfo& m_geo;
+    /// Optional record of all registered placement paths
+    std::vector<Entry>* m_record { nullptr };
 
     /// Default constructor
     Populator(const Detector& description, Geant4GeometryInfo& g)
@@ -119,14 +130,18 @@ namespace  {
                  "++ Detector element %s of type %s has no placement.",
                  de.name(), de.type().c_str());
       }
-      /// Needed to compute the cellID of parameterized volumes
+      m_entries.clear();
+      scanParametrised();
+    }
+
+    /// Needed to compute the cellID of parameterized volumes
+    void scanParametrised()  {
       for( const auto& pv : m_geo.g4Placements )  {
         if( pv.second->IsParameterised() )
           m_geo.g4Parameterised[pv.second] = pv.first;
         if( pv.second->IsReplicated() )
           m_geo.g4Replicated[pv.second] = pv.first;
       }
-      m_entries.clear();
     }
 
     /// Scan a single physical volume and look for sensitive elements below
@@ -242,6 +257,7 @@ namespace  {
             opt.flags.replicated   = path.front()->IsReplicated()    ? 1 : 0;
             m_geo.g4Paths[hash]    = { code, opt.value };
             m_entries.emplace(code);
+            if ( m_record ) m_record->emplace_back(path, m_geo.g4Paths[hash]);
             return;
           }
           /// This is a normal case for parametrized volumes and no error
@@ -278,13 +294,191 @@ namespace  {
   };
 }
 
+namespace  {
+
+  /// Persistent cache of the Geant4 placement path table
+  /**
+   *  The cache is enabled by the environment variable DD4HEP_GEOMETRY_CACHE
+   *  pointing to a (shared) directory. Geant4 placement paths are stored
+   *  as daughter indices starting from the world volume, which are stable
+   *  between jobs. The file is keyed by a checksum of the Geant4 volume tree,
+   *  the volume identifiers of the DD4hep placements and the readouts.
+   *  Geometries with parametrised or replicated placements are not cached.
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   *  \ingroup DD4HEP_SIMULATION
+   */
+  struct PathCache  {
+    typedef Geant4TouchableHandler::Geant4PlacementPath Path;
+    enum { MAGIC = 0x44344750 };
+
+    /// Reference to Geant4 translation information
+    Geant4GeometryInfo& m_geo;
+    /// Name of the cache file. Empty if the cache is not usable
+    std::string         m_file;
+
+    /// Initializing constructor
+    PathCache(Geant4GeometryInfo& g) : m_geo(g)  {
+      const char* dir = ::getenv("DD4HEP_GEOMETRY_CACHE");
+      if ( !dir )
+        return;
+      for( const auto& pv : m_geo.g4Placements )  {
+        if( pv.second->IsParameterised() || pv.second->IsReplicated() )  {
+          printout(DEBUG, "Geant4VolumeManager", "+++ Parametrised placements: Path table is not cached.");
+          return;
+        }
+      }
+      char text[32];
+      ::snprintf(text, sizeof(text), "%016llx", (unsigned long long)checksum());
+      m_file = std::string(dir) + "/g4paths_" + text + ".bin";
+    }
+
+    /// Checksum of the Geant4 volume tree and the volume identifiers
+    uint64_t checksum()  const  {
+      std::string tag = "Geant4VolumeManager " + versionString() + " " + G4Version;
+      uint64_t key = detail::hash64(tag), ids = 0;
+      for( const G4LogicalVolume* lv : *G4LogicalVolumeStore::GetInstance() )  {
+        key = detail::update_hash64(key, lv->GetName());
+        for( std::size_t i = 0, n = lv->GetNoDaughters(); i < n; ++i )  {
+          const G4VPhysicalVolume* pv = lv->GetDaughter(i);
+          int copy = pv->GetCopyNo();
+          key = detail::update_hash64(key, pv->GetName());
+          key = detail::update_hash64(key, &copy, sizeof(copy));
+        }
+      }
+      /// The maps are ordered by pointer values: combine independent of the order
+      for( const auto& p : m_geo.g4Placements )  {
+        PlacedVolume pv = p.first;
+        uint64_t h = detail::hash64(pv.name());
+        for( const auto& id : pv.volIDs() )  {
+          h = detail::update_hash64(h, id.first);
+          h = detail::update_hash64(h, &id.second, sizeof(id.second));
+        }
+        ids += h;
+      }
+      for( const auto& s : m_geo.sensitives )  {
+        SensitiveDetector sd = s.first;
+        if ( sd.isValid() && sd.readout().isValid() )
+          ids += detail::hash64(sd.readout().idSpec().fieldDescription());
+      }
+      return detail::update_hash64(key, &ids, sizeof(ids));
+    }
+
+    /// Restore the path table from the cache file. Returns true on success
+    bool load()  const  {
+      std::ifstream in(m_file, std::ios::in | std::ios::binary);
+      std::unordered_map<uint64_t, Geant4GeometryInfo::Placement> table;
+      uint32_t magic = 0;
+      uint64_t count = 0;
+      if ( !in.good() )
+        return false;
+      in.read((char*)&magic, sizeof(magic));
+      in.read((char*)&count, sizeof(count));
+      if ( !in.good() || magic != MAGIC )
+        return false;
+      table.reserve(count);
+      Path path;
+      std::vector<uint32_t> indices;
+      for( uint64_t k = 0; k < count; ++k )  {
+        Geant4GeometryInfo::Placement plc;
+        uint32_t depth = 0;
+        in.read((char*)&plc.volumeID, sizeof(plc.volumeID));
+        in.read((char*)&plc.flags, sizeof(plc.flags));
+        in.read((char*)&depth, sizeof(depth));
+        indices.resize(depth);
+        in.read((char*)indices.data(), depth*sizeof(uint32_t));
+        if ( !in.good() || depth == 0 )
+          return false;
+        const G4LogicalVolume* lv = m_geo.world()->GetLogicalVolume();
+        path.resize(depth);
+        for( uint32_t j = 0; j < depth; ++j )  {
+          if ( indices[j] >= std::size_t(lv->GetNoDaughters()) )
+            return false;
+          const G4VPhysicalVolume* pv = lv->GetDaughter(indices[j]);
+          path[depth-1-j] = pv;
+          lv = pv->GetLogicalVolume();
+        }
+        table.emplace(detail::hash64(&path[0], path.size()*sizeof(path[0])), plc);
+      }
+      m_geo.g4Paths = std::move(table);
+      return true;
+    }
+
+    /// Save the recorded path table to the cache file
+    bool save(const std::vector<Populator::Entry>& entries)  const  {
+      std::unordered_map<const G4VPhysicalVolume*, uint32_t> index;
+      for( const G4LogicalVolume* lv : *G4LogicalVolumeStore::GetInstance() )  {
+        for( std::size_t i = 0, n = lv->GetNoDaughters(); i < n; ++i )
+          index[lv->GetDaughter(i)] = uint32_t(i);
+      }
+      std::size_t idx = m_file.rfind('/');
+      std::string tmp = m_file + "." + std::to_string(gSystem->GetPid()) + ".tmp";
+      gSystem->mkdir(m_file.substr(0, idx).c_str(), kTRUE);
+      {
+        std::ofstream out(tmp, std::ios::out | std::ios::binary);
+        uint32_t magic = MAGIC;
+        uint64_t count = entries.size();
+        out.write((const char*)&magic, sizeof(magic));
+        out.write((const char*)&count, sizeof(count));
+        for( const auto& e : entries )  {
+          uint32_t depth = e.first.size();
+          out.write((const char*)&e.second.volumeID, sizeof(e.second.volumeID));
+          out.write((const char*)&e.second.flags, sizeof(e.second.flags));
+          out.write((const char*)&depth, sizeof(depth));
+          for( auto k = e.first.rbegin(); k != e.first.rend(); ++k )  {
+            auto i = index.find(*k);
+            if ( i == index.end() )  {
+              out.close();
+              gSystem->Unlink(tmp.c_str());
+              return false;
+            }
+            out.write((const char*)&i->second, sizeof(i->second));
+          }
+        }
+        if ( !out.good() )  {
+          out.close();
+          gSystem->Unlink(tmp.c_str());
+          return false;
+        }
+      }
+      /// Many jobs may share the cache directory: write to a temporary and rename
+      if ( 0 != gSystem->Rename(tmp.c_str(), m_file.c_str()) )  {
+        gSystem->Unlink(tmp.c_str());
+        return false;
+      }
+      return true;
+    }
+  };
+}
+
 /// Initializing constructor. The tree will automatically be built if possible
 Geant4VolumeManager::Geant4VolumeManager(const Detector& description, Geant4GeometryInfo* info)
   : Handle<Geant4GeometryInfo>(info)  {
   if( info && info->valid )  {
     if( !info->has_volmgr )  {
+      PathCache cache(*info);
       Populator p(description, *info);
-      p.populate(description.world());
+      if ( !cache.m_file.empty() && cache.load() )  {
+        p.scanParametrised();
+        printout(INFO, "Geant4VolumeManager", "+++ Restored %ld Geant4 placement paths from %s",
+                 info->g4Paths.size(), cache.m_file.c_str());
+      }
+      else if ( !cache.m_file.empty() )  {
+        std::vector<Populator::Entry> entries;
+        p.m_record = &entries;
+        p.populate(description.world());
+        p.m_record = nullptr;
+        if ( cache.save(entries) )
+          printout(INFO, "Geant4VolumeManager", "+++ Saved %ld Geant4 placement paths to %s",
+                   entries.size(), cache.m_file.c_str());
+        else
+          printout(WARNING, "Geant4VolumeManager", "+++ Failed to write placement path cache %s",
+                   cache.m_file.c_str());
+      }
+      else  {
+        p.populate(description.world());
+      }
       info->has_volmgr = true;
     }
     return;
@@ -311,6 +505,9 @@ bool Geant4VolumeManager::checkValidity() const  {
 }
 
 namespace  {
+  /// Maximal depth of placement paths resolved without heap allocation
+  static constexpr int MAX_PATH_DEPTH = 64;
+
   std::string debug_status(const Geant4VolumeManager* mgr)  {
     char text[256];
     auto* p = mgr->ptr();
@@ -325,6 +522,18 @@ namespace  {
 
 /// Access CELLID by Geant4 touchable object
 VolumeID Geant4VolumeManager::volumeID(const G4VTouchable* touchable) const  {
+  /// Fast path: hash the placement path on the stack without allocating it
+  int depth = touchable ? touchable->GetHistoryDepth() : 0;
+  if( depth > 0 && depth <= MAX_PATH_DEPTH && isValid() && ptr()->valid )  {
+    const G4VPhysicalVolume* stack_path[MAX_PATH_DEPTH];
+    for( int k = 0; k < depth; ++k )
+      stack_path[k] = touchable->GetVolume(k);
+    auto i = ptr()->g4Paths.find(detail::hash64(stack_path, sizeof(stack_path[0])*depth));
+    /// Parametrised volumes and errors are handled below
+    if( i != ptr()->g4Paths.end() && i->second.flags == 0 )  {
+      return i->second.volumeID;
+    }
+  }
   Geant4TouchableHandler handler(touchable);
   std::vector<const G4VPhysicalVolume*> path = handler.placementPath();
   if( !isValid() )  {
@@ -6,10 +6,11 @@
 #include "Evaluator/detail/Evaluator.h"
 
 #include <iostream>
+#include <algorithm>
 #include <cmath>        // for pow()
 #include <sstream>
 #include <mutex>
-#include <condition_variable>
+#include <shared_mutex>
 #include <cctype>
 #include <cerrno>
 #include <cstring>
@@ -17,6 +18,7 @@
 #include <stack>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 // Disable some diagnostics, which we know, but need to ignore
 #if defined(__GNUC__) && !defined(__APPLE__) && !defined(__llvm__)
@@ -75,6 +77,27 @@ namespace  {
     FCN(double (*f)(double,double,double,double)) { f4 = f; }
     FCN(double (*f)(double,double,double,double,double)) { f5 = f; }
   };
+
+  /// Compiled expression: one instruction of the stack machine
+  struct Instruction {
+    int          code;     // operator code, OP_VALUE, OP_VARIABLE or OP_FUNCTION
+    int          npar;     // number of function parameters
+    double       value;    // constant value
+    const Item*  item;     // dictionary entry of variables and functions
+  };
+
+  /// Compiled expression: instruction sequence in reverse polish notation
+  /**
+   *  The sequence is recorded while engine() evaluates the expression the
+   *  first time. It references the dictionary entries, not their values:
+   *  re-defining a variable does not invalidate the compiled expression.
+   */
+  struct Program {
+    std::vector<Instruction> code;
+    std::size_t              depth = 0;
+    void add(int c, double v)                 { code.push_back({c, 0, v, nullptr}); }
+    void add(int c, const Item* i, int n=0)   { code.push_back({c, n, 0e0, i});     }
+  };
 }
 
 //typedef char * pchar;
@@ -82,47 +105,26 @@ typedef std::unordered_map<std::string,Item> dic_type;
 
 /// Internal expression evaluator helper class
 struct EVAL::Object::Struct {
-  // based on https://stackoverflow.com/a/58018604
+  /// Shared access to the dictionary: any number of concurrent evaluations
   struct ReadLock {
-    ReadLock(Struct* s): theStruct(s), theLg(s->theLock) { 
-      while(theStruct->theWriterWaiting)
-        theStruct->theCond.wait(theLg);
-      ++theStruct->theReadersWaiting;
-    }
-
+    ReadLock(Struct* s): theLg(s->theLock) {}
     ReadLock(const ReadLock&) = delete;
-    ~ReadLock() {
-      --theStruct->theReadersWaiting;
-      while(theStruct->theReadersWaiting > 0)
-        theStruct->theCond.wait(theLg);
-      theStruct->theCond.notify_one();
-    }
-    Struct* theStruct;
-    std::unique_lock<std::mutex> theLg;
-
+    std::shared_lock<std::shared_timed_mutex> theLg;
   };
+  /// Exclusive access to the dictionary: modifications
   struct WriteLock {
-    WriteLock(Struct* s): theStruct(s), theLg(s->theLock) {
-      while(theStruct->theWriterWaiting)
-        theStruct->theCond.wait(theLg);
-    }
+    WriteLock(Struct* s): theLg(s->theLock) {}
     WriteLock(const WriteLock&) = delete;
-    ~WriteLock() {
-      theStruct->theWriterWaiting = true;
-      while(theStruct->theReadersWaiting > 0)
-        theStruct->theCond.wait(theLg);
-      theStruct->theWriterWaiting = false;
-      theStruct->theCond.notify_all();
-    }
-    Struct* theStruct;
-    std::unique_lock<std::mutex> theLg;
+    std::unique_lock<std::shared_timed_mutex> theLg;
   };
 
   dic_type    theDictionary;
-  int theReadersWaiting = 0;
-  bool theWriterWaiting = false;
-  std::condition_variable theCond;
-  std::mutex  theLock;
+  /// Cache of compiled expressions. Entries are only removed under the WriteLock
+  std::unordered_map<std::string,Program> theCache;
+  std::shared_timed_mutex theCacheLock;
+  /// Use compiled expressions. Disabled by the environment DD4HEP_EVALUATOR_NOCACHE for comparisons
+  bool        useCache = ::getenv("DD4HEP_EVALUATOR_NOCACHE") == nullptr;
+  std::shared_timed_mutex theLock;
 };
 
 //---------------------------------------------------------------------------
@@ -144,10 +146,16 @@ static constexpr char sss[MAX_N_PAR+2] = "012345";
 enum { ENDL, LBRA, OR, AND, EQ, NE, GE, GT, LE, LT,
        PLUS, MINUS, MULT, DIV, POW, RBRA, VALUE };
 
-static int engine(char const*, char const*, double &, char const* &, const dic_type &);
+/// Additional instruction codes of compiled expressions
+enum { OP_VALUE = 100, OP_VARIABLE, OP_FUNCTION };
+
+/// Upper limit of the number of cached expressions
+static constexpr std::size_t MAX_CACHE_SIZE = 100000;
+
+static int engine(char const*, char const*, double &, char const* &, const dic_type &, Program* = nullptr);
 
 static int variable(const std::string & name, double & result,
-                    const dic_type & dictionary)
+                    const dic_type & dictionary, const Item* & found)
 /***********************************************************************
  *                                                                     *
  * Name: variable                                    Date:    03.10.00 *
@@ -168,6 +176,7 @@ static int variable(const std::string & name, double & result,
     return EVAL::ERROR_UNKNOWN_VARIABLE;
   //NOTE: copying ::string not thread safe so must use ref
   Item const& item = iter->second;
+  found = &item;
   switch (item.what) {
   case Item::VARIABLE:
     result = item.variable;
@@ -185,7 +194,7 @@ static int variable(const std::string & name, double & result,
 }
 
 static int execute_function(const std::string & name, std::stack<double> & par,
-                    double & result, const dic_type & dictionary)
+                    double & result, const dic_type & dictionary, const Item* & found)
 /***********************************************************************
  *                                                                     *
  * Name: execute_function                            Date:    03.10.00 *
@@ -209,6 +218,7 @@ static int execute_function(const std::string & name, std::stack<double> & par,
   if (iter == dictionary.end()) return EVAL::ERROR_UNKNOWN_FUNCTION;
   //NOTE: copying ::string not thread safe so must use ref
   Item const& item = iter->second;
+  found = &item;
 
   double pp[MAX_N_PAR];
   for(int i=0; i<npar; i++) { pp[i] = par.top(); par.pop(); }
@@ -239,7 +249,7 @@ static int execute_function(const std::string & name, std::stack<double> & par,
 }
 
 static int operand(char const* begin, char const* end, double & result,
-                   char const* & endp, const dic_type & dictionary)
+                   char const* & endp, const dic_type & dictionary, Program* prog)
 /***********************************************************************
  *                                                                     *
  * Name: operand                                     Date:    03.10.00 *
@@ -255,6 +265,7 @@ static int operand(char const* begin, char const* end, double & result,
  *   result - value of the operand.                                    *
  *   endp   - pointer to the character where the evaluation stoped.    *
  *   dictionary - dictionary of available variables and functions.     *
+ *   prog   - optional instruction sequence to record the operand.     *
  *                                                                     *
  ***********************************************************************/
 {
@@ -273,6 +284,7 @@ static int operand(char const* begin, char const* end, double & result,
 #endif
       result = strtod(pointer, (char **)(&pointer));
     if (errno == 0) {
+      if (prog) prog->add(OP_VALUE, result);
       EVAL_EXIT( EVAL::OK, --pointer );
     }else{
       EVAL_EXIT( EVAL::ERROR_CALCULATION_ERROR, begin );
@@ -292,8 +304,10 @@ static int operand(char const* begin, char const* end, double & result,
 
   result = 0.0;
   SKIP_BLANKS;
+  const Item* item = nullptr;
   if (c != '(') {
-    EVAL_STATUS = variable(name, result, dictionary);
+    EVAL_STATUS = variable(name, result, dictionary, item);
+    if (prog && EVAL_STATUS == EVAL::OK) prog->add(OP_VARIABLE, item);
     EVAL_EXIT( EVAL_STATUS, (EVAL_STATUS == EVAL::OK) ? --pointer : begin);
   }
 
@@ -315,7 +329,7 @@ static int operand(char const* begin, char const* end, double & result,
     case ',':
       if (pos.size() == 1) {
         par_end = pointer-1;
-        EVAL_STATUS = engine(par_begin, par_end, value, par_end, dictionary);
+        EVAL_STATUS = engine(par_begin, par_end, value, par_end, dictionary, prog);
         if (EVAL_STATUS == EVAL::WARNING_BLANK_STRING)
 	  { EVAL_EXIT( EVAL::ERROR_EMPTY_PARAMETER, --par_end ); }
         if (EVAL_STATUS != EVAL::OK)
@@ -330,7 +344,7 @@ static int operand(char const* begin, char const* end, double & result,
         break;
       }else{
         par_end = pointer-1;
-        EVAL_STATUS = engine(par_begin, par_end, value, par_end, dictionary);
+        EVAL_STATUS = engine(par_begin, par_end, value, par_end, dictionary, prog);
         switch (EVAL_STATUS) {
         case EVAL::OK:
           par.push(value);
@@ -342,7 +356,9 @@ static int operand(char const* begin, char const* end, double & result,
         default:
           EVAL_EXIT( EVAL_STATUS, par_end );
         }
-        EVAL_STATUS = execute_function(name, par, result, dictionary);
+        int npar = par.size();
+        EVAL_STATUS = execute_function(name, par, result, dictionary, item);
+        if (prog && EVAL_STATUS == EVAL::OK) prog->add(OP_FUNCTION, item, npar);
         EVAL_EXIT( EVAL_STATUS, (EVAL_STATUS == EVAL::OK) ? pointer : begin);
       }
     }
@@ -351,64 +367,62 @@ static int operand(char const* begin, char const* end, double & result,
 
 /***********************************************************************
  *                                                                     *
- * Name: maker                                       Date:    28.09.00 *
+ * Name: apply                                       Date:    28.09.00 *
  * Author: Evgeni Chernyaev                          Revised:          *
  *                                                                     *
- * Function: Executes basic arithmetic operations on values in the top *
- *           of the stack. Result is placed back into the stack.       *
- *           This function is used by engine().                        *
+ * Function: Executes basic arithmetic operations on two values.       *
+ *           This function is used by maker() and execute().           *
  *                                                                     *
  * Parameters:                                                         *
- *   op  - code of the operation.                                      *
- *   val - stack of values.                                            *
+ *   op     - code of the operation.                                   *
+ *   val1   - left operand.                                            *
+ *   val2   - right operand.                                           *
+ *   result - result of the operation.                                 *
  *                                                                     *
  ***********************************************************************/
-static int maker(int op, std::stack<double> & val)
+static int apply(int op, double val1, double val2, double & result)
 {
-  if (val.size() < 2) return EVAL::ERROR_SYNTAX_ERROR;
-  double val2 = val.top(); val.pop();
-  double val1 = val.top();
   switch (op) {
   case OR:                                // operator ||
-    val.top() = (val1 || val2) ? 1. : 0.;
+    result = (val1 || val2) ? 1. : 0.;
     return EVAL::OK;
   case AND:                               // operator &&
-    val.top() = (val1 && val2) ? 1. : 0.;
+    result = (val1 && val2) ? 1. : 0.;
     return EVAL::OK;
   case EQ:                                // operator ==
-    val.top() = (val1 == val2) ? 1. : 0.;
+    result = (val1 == val2) ? 1. : 0.;
     return EVAL::OK;
   case NE:                                // operator !=
-    val.top() = (val1 != val2) ? 1. : 0.;
+    result = (val1 != val2) ? 1. : 0.;
     return EVAL::OK;
   case GE:                                // operator >=
-    val.top() = (val1 >= val2) ? 1. : 0.;
+    result = (val1 >= val2) ? 1. : 0.;
     return EVAL::OK;
   case GT:                                // operator >
-    val.top() = (val1 >  val2) ? 1. : 0.;
+    result = (val1 >  val2) ? 1. : 0.;
     return EVAL::OK;
   case LE:                                // operator <=
-    val.top() = (val1 <= val2) ? 1. : 0.;
+    result = (val1 <= val2) ? 1. : 0.;
     return EVAL::OK;
   case LT:                                // operator <
-    val.top() = (val1 <  val2) ? 1. : 0.;
+    result = (val1 <  val2) ? 1. : 0.;
     return EVAL::OK;
   case PLUS:                              // operator '+'
-    val.top() = val1 + val2;
+    result = val1 + val2;
     return EVAL::OK;
   case MINUS:                             // operator '-'
-    val.top() = val1 - val2;
+    result = val1 - val2;
     return EVAL::OK;
   case MULT:                              // operator '*'
-    val.top() = val1 * val2;
+    result = val1 * val2;
     return EVAL::OK;
   case DIV:                               // operator '/'
     if (val2 == 0.0) return EVAL::ERROR_CALCULATION_ERROR;
-    val.top() = val1 / val2;
+    result = val1 / val2;
     return EVAL::OK;
   case POW:                               // operator '^' (or '**')
     errno = 0;
-    val.top() = pow(val1,val2);
+    result = pow(val1,val2);
     if (errno == 0) return EVAL::OK;
     ATTR_FALLTHROUGH;
   default:
@@ -416,6 +430,28 @@ static int maker(int op, std::stack<double> & val)
   }
 }
 
+/***********************************************************************
+ *                                                                     *
+ * Name: maker                                       Date:    28.09.00 *
+ * Author: Evgeni Chernyaev                          Revised:          *
+ *                                                                     *
+ * Function: Executes basic arithmetic operations on values in the top *
+ *           of the stack. Result is placed back into the stack.       *
+ *           This function is used by engine().                        *
+ *                                                                     *
+ * Parameters:                                                         *
+ *   op  - code of the operation.                                      *
+ *   val - stack of values.                                            *
+ *                                                                     *
+ ***********************************************************************/
+static int maker(int op, std::stack<double> & val)
+{
+  if (val.size() < 2) return EVAL::ERROR_SYNTAX_ERROR;
+  double val2 = val.top(); val.pop();
+  double val1 = val.top();
+  return apply(op, val1, val2, val.top());
+}
+
 /***********************************************************************
  *                                                                     *
  * Name: engine                                      Date:    28.09.00 *
@@ -430,10 +466,11 @@ static int maker(int op, std::stack<double> & val)
  *   result - result of the evaluation.                                *
  *   endp   - pointer to the character where the evaluation stoped.    *
  *   dictionary - dictionary of available variables and functions.     *
+ *   prog   - optional instruction sequence to record the evaluation.  *
  *                                                                     *
  ***********************************************************************/
 static int engine(char const* begin, char const* end, double & result,
-                  char const*& endp, const dic_type & dictionary)
+                  char const*& endp, const dic_type & dictionary, Program* prog)
 {
   static constexpr int SyntaxTable[17][17] = {
     //E  (  || && == != >= >  <= <  +  -  *  /  ^  )  V - current token
@@ -548,12 +585,13 @@ static int engine(char const* begin, char const* end, double & result,
     case 0:                             // syntax error
       EVAL_EXIT( EVAL::ERROR_SYNTAX_ERROR, pointer );
     case 1:                             // operand: number, variable, function
-      EVAL_STATUS = operand(pointer, end, value, pointer, dictionary);
+      EVAL_STATUS = operand(pointer, end, value, pointer, dictionary, prog);
       if (EVAL_STATUS != EVAL::OK) { EVAL_EXIT( EVAL_STATUS, pointer ); }
       val.push(value);
       continue;
     case 2:                             // unary + or unary -
       val.push(0.0);
+      if (prog) prog->add(OP_VALUE, 0.0);
     case 3: default:                    // next operator
       break;
     }
@@ -582,6 +620,7 @@ static int engine(char const* begin, char const* end, double & result,
         if (EVAL_STATUS != EVAL::OK) {
           EVAL_EXIT( EVAL_STATUS, pos.top() );
         }
+        if (prog) prog->add(iTop, 0.0);
         op.top() = iCur; pos.top() = pointer;
         break;
       case 3:                           // delete '(' from stack
@@ -592,6 +631,7 @@ static int engine(char const* begin, char const* end, double & result,
         if (EVAL_STATUS != EVAL::OK) {  // repete with the same iCur
           EVAL_EXIT( EVAL_STATUS, pos.top() );
         }
+        if (prog) prog->add(iTop, 0.0);
         op.pop(); pos.pop();
         continue;
       }
@@ -600,6 +640,105 @@ static int engine(char const* begin, char const* end, double & result,
   }
 }
 
+//---------------------------------------------------------------------------
+static int execute(const Program& prog, double & result, EVAL::Object::Struct* imp);
+
+/// Access the compiled instruction sequence of an expression. Requires the ReadLock
+static const Program* compiled(char const* expression, Program& local, EVAL::Object::Struct* imp)
+{
+  std::string key(expression);
+  {
+    std::shared_lock<std::shared_timed_mutex> guard(imp->theCacheLock);
+    auto iter = imp->theCache.find(key);
+    if (iter != imp->theCache.end()) return &iter->second;
+  }
+  double      value;
+  char const* endp;
+  char const* end = expression + key.length() - 1;
+  if (engine(expression, end, value, endp, imp->theDictionary, &local) != EVAL::OK)
+    return nullptr;
+  // Maximal stack depth required by the execution
+  int depth = 0;
+  for (const auto& i : local.code) {
+    depth += (i.code == OP_VALUE || i.code == OP_VARIABLE) ? 1 : (i.code == OP_FUNCTION) ? 1 - i.npar : -1;
+    local.depth = std::max(local.depth, std::size_t(depth));
+  }
+  std::unique_lock<std::shared_timed_mutex> guard(imp->theCacheLock);
+  if (imp->theCache.size() >= MAX_CACHE_SIZE) return &local;
+  return &imp->theCache.emplace(std::move(key), std::move(local)).first->second;
+}
+
+/***********************************************************************
+ *                                                                     *
+ * Function: Executes a compiled expression.                           *
+ *           Any failure is reported as ERROR_CALCULATION_ERROR: the   *
+ *           caller re-runs engine() to obtain the exact diagnostics.  *
+ *                                                                     *
+ * Parameters:                                                         *
+ *   prog   - compiled instruction sequence.                           *
+ *   result - result of the evaluation.                                *
+ *   imp    - evaluator data (ReadLock must be held).                  *
+ *                                                                     *
+ ***********************************************************************/
+static int execute(const Program& prog, double & result, EVAL::Object::Struct* imp)
+{
+  double  local_stack[32];
+  std::vector<double> heap_stack;
+  double* stack = local_stack;
+  int     sp    = 0;
+
+  if (prog.depth > 32) {
+    heap_stack.resize(prog.depth);
+    stack = heap_stack.data();
+  }
+  for (const auto& i : prog.code) {
+    switch (i.code) {
+    case OP_VALUE:
+      stack[sp++] = i.value;
+      break;
+    case OP_VARIABLE:
+      if (i.item->what == Item::VARIABLE) {
+        stack[sp++] = i.item->variable;
+        break;
+      }
+      else if (i.item->what == Item::EXPRESSION) {
+        Program local;
+        const Program* p = compiled(i.item->expression.c_str(), local, imp);
+        if (p && execute(*p, stack[sp], imp) == EVAL::OK) {
+          ++sp;
+          break;
+        }
+      }
+      return EVAL::ERROR_CALCULATION_ERROR;
+    case OP_FUNCTION: {
+      if (i.item->what != Item::FUNCTION || i.item->function == 0)
+        return EVAL::ERROR_CALCULATION_ERROR;
+      FCN fcn(i.item->function);
+      double* pp = stack + sp - i.npar;
+      errno = 0;
+      switch (i.npar) {
+      case 0: pp[0] = (*fcn.f0)(); break;
+      case 1: pp[0] = (*fcn.f1)(pp[0]); break;
+      case 2: pp[0] = (*fcn.f2)(pp[0],pp[1]); break;
+      case 3: pp[0] = (*fcn.f3)(pp[0],pp[1],pp[2]); break;
+      case 4: pp[0] = (*fcn.f4)(pp[0],pp[1],pp[2],pp[3]); break;
+      case 5: pp[0] = (*fcn.f5)(pp[0],pp[1],pp[2],pp[3],pp[4]); break;
+      }
+      if (errno != 0) return EVAL::ERROR_CALCULATION_ERROR;
+      sp += 1 - i.npar;
+      break;
+    }
+    default:
+      --sp;
+      if (apply(i.code, stack[sp-1], stack[sp], stack[sp-1]) != EVAL::OK)
+        return EVAL::ERROR_CALCULATION_ERROR;
+      break;
+    }
+  }
+  result = stack[0];
+  return EVAL::OK;
+}
+
 //---------------------------------------------------------------------------
 static int setItem(const char * prefix, const char * name,
                    const Item & item, EVAL::Object::Struct* imp) {
@@ -705,6 +844,14 @@ Evaluator::Object::EvalStatus Evaluator::Object::evaluate(const char * expressio
   EvalStatus s;
   if (expression != 0) {
     Struct::ReadLock guard(imp);
+    Program local;
+    const Program* prog = imp->useCache ? compiled(expression, local, imp) : nullptr;
+    if (prog && execute(*prog, s.theResult, imp) == EVAL::OK) {
+      s.theStatus   = EVAL::OK;
+      s.thePosition = expression + strlen(expression);
+      return s;
+    }
+    // Not compilable or failed: the interpreter provides the diagnostics
     s.theStatus = engine(expression,
                          expression+strlen(expression)-1,
                          s.theResult,
@@ -874,6 +1021,7 @@ void Evaluator::Object::removeVariable(const char * name) {
   if (n == 0) return;
   Struct::WriteLock guard(imp);
   imp->theDictionary.erase(std::string(pointer,n));
+  imp->theCache.clear();
 }
 
 //---------------------------------------------------------------------------
@@ -884,6 +1032,7 @@ void Evaluator::Object::removeFunction(const char * name, int npar) {
   if (n == 0) return;
   Struct::WriteLock guard(imp);
   imp->theDictionary.erase(sss[npar]+std::string(pointer,n));
+  imp->theCache.clear();
 }
 
 //---------------------------------------------------------------------------
@@ -18,9 +18,12 @@
 #include "DD4hep/VolumeManager.h"
 
 #include "DDSegmentation/Segmentation.h"
+#include "DDRec/CellIDSpatialIndex.h"
 
 #include <set>
+#include <memory>
 #include <string>
+#include <vector>
 
 
 namespace dd4hep {
@@ -67,13 +70,43 @@ namespace dd4hep {
        */
       Position position(const CellID& cellID) const;
 
+      /** Return the nominal global positions for an array of cellIDs of sensitive volumes.
+       *  The cells are grouped by their volume context: the context lookup, the readout search
+       *  and the combined local to global transformation are done once per sensitive volume.
+       *  If num_threads > 1 the cells are split between the given number of threads.
+       *  No Alignment corrections are applied.
+       */
+      void positionsNominal(const CellID* cellIDs, std::size_t num_cells, Position* positions,
+                            int num_threads=1) const;
+
+      /** Return the nominal global positions for a vector of cellIDs of sensitive volumes.
+       *  See above for details.
+       */
+      void positionsNominal(const std::vector<CellID>& cellIDs, std::vector<Position>& positions,
+                            int num_threads=1) const;
+
+      /** Return the global positions for a vector of cellIDs of sensitive volumes.
+       *  Alignment corrections are applied (TO BE DONE).
+       */
+      void positions(const std::vector<CellID>& cellIDs, std::vector<Position>& positions,
+                     int num_threads=1) const;
+
 
       /** Return the global cellID for the given global position.
        *  Note: this call is rather slow - only use it when really needed !
-       *  
+       *  If the spatial index was built, points within the indexed subdetectors
+       *  are looked up in the index, which is fast and thread-safe.
        */
       CellID cellID(const Position& global) const;
 
+      /** Build the spatial index over the sensitive volumes of the given subdetectors
+       *  (all subdetectors if empty) to speed up cellID(global). Built only once.
+       */
+      void buildSpatialIndex(const std::vector<DetElement>& subdetectors = {}) ;
+
+      /// Access the spatial index. NULL if it was not built
+      const CellIDSpatialIndex* spatialIndex() const { return _spatialIndex.get() ; }
+
 
 
       /** Find the context with DetElement, placements etc for a given cellID of a sensitive volume.
@@ -119,6 +152,7 @@ namespace dd4hep {
     protected:
       VolumeManager _volumeManager{} ;
       const Detector* _description ;
+      std::shared_ptr<CellIDSpatialIndex> _spatialIndex{} ; //!
 
     };
 
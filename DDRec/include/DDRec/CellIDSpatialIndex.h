@@ -0,0 +1,121 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDREC_CELLIDSPATIALINDEX_H
+#define DDREC_CELLIDSPATIALINDEX_H
+
+#include "DD4hep/DetElement.h"
+#include "DD4hep/Segmentations.h"
+#include "DD4hep/VolumeManager.h"
+
+#include "TGeoMatrix.h"
+
+#include <vector>
+
+class TGeoShape;
+class TGeoVolume;
+
+namespace dd4hep {
+  namespace rec {
+
+    /** Spatial index over the sensitive volumes registered to the VolumeManager.
+     *
+     *  For every indexed subdetector a bounding volume hierarchy over the world
+     *  bounding boxes of its sensitive volumes is built once. Point queries walk
+     *  the hierarchy with a fixed size stack, check the candidate shapes in their
+     *  local frame and compute the cellID from the segmentation of the volume.
+     *  The index is read-only after construction: queries are thread-safe and do
+     *  not allocate memory. Alignment corrections are not applied.
+     *
+     * @author M.Frank
+     */
+    class CellIDSpatialIndex {
+    public:
+
+      /// Index entry of one sensitive volume
+      struct Entry {
+        /// Volume identifier of the sensitive placement
+        VolumeID          volumeID{} ;
+        /// Shape of the sensitive volume
+        const TGeoShape*  shape{nullptr} ;
+        /// Sensitive volume: needed to exclude points inside daughter volumes
+        const TGeoVolume* volume{nullptr} ;
+        /// Segmentation of the readout
+        Segmentation      segmentation{} ;
+        /// Transformation from the volume frame to the world frame
+        TGeoHMatrix       toGlobal{} ;
+        /// World bounding box
+        double            lower[3]{}, upper[3]{} ;
+      } ;
+
+      /// Node of the bounding volume hierarchy
+      struct Node {
+        /// Bounding box of all entries below this node
+        double lower[3]{}, upper[3]{} ;
+        /// Leaf: first entry. Otherwise: index of the first child node (second is first+1)
+        int    first{0} ;
+        /// Leaf: number of entries. Zero for inner nodes
+        int    count{0} ;
+      } ;
+
+      /// Hierarchy of one subdetector
+      struct Tree {
+        /// Subdetector
+        DetElement        detector{} ;
+        /// Nodes of the hierarchy. The first node is the root
+        std::vector<Node> nodes{} ;
+      } ;
+
+      /// Maximal depth of the hierarchy supported by the query stack
+      static constexpr int MAX_DEPTH = 64 ;
+
+    protected:
+      /// Index entries. Entries of a tree leaf are contiguous
+      std::vector<Entry> _entries{} ;
+      /// One hierarchy per subdetector
+      std::vector<Tree>  _trees{} ;
+      /// Flag if all subdetectors with sensitive volumes are indexed
+      bool               _complete{false} ;
+
+      /// Recursive build of the hierarchy node in the given slot over the entries [begin, end)
+      void build(Tree& tree, int slot, std::size_t begin, std::size_t end) ;
+      /// Check if the local point lies within a daughter of the sensitive volume
+      static bool inDaughter(const TGeoVolume* volume, const double local[3]) ;
+
+    public:
+      /** Build the index from the VolumeManager for the given subdetectors.
+       *  If the list is empty, all subdetectors are indexed.
+       */
+      CellIDSpatialIndex(const VolumeManager& manager, const std::vector<DetElement>& subdetectors = {}) ;
+
+      /// Default destructor
+      ~CellIDSpatialIndex() = default ;
+
+      /// Flag if all subdetectors with sensitive volumes are indexed
+      bool isComplete() const { return _complete ; }
+
+      /// Number of indexed sensitive volumes
+      std::size_t size() const { return _entries.size() ; }
+
+      /// Access the subdetector trees
+      const std::vector<Tree>& trees() const { return _trees ; }
+
+      /** Find the sensitive volume containing the global point and compute the cellID.
+       *  Returns false if the point is not inside an indexed sensitive volume.
+       */
+      bool cellID(const Position& global, CellID& cell) const ;
+    } ;
+
+  } /* namespace rec */
+} /* namespace dd4hep */
+
+#endif // DDREC_CELLIDSPATIALINDEX_H
@@ -499,6 +499,42 @@ namespace dd4hep {
 
     std::ostream& operator<<( std::ostream& io , const NeighbourSurfacesData& d ) ;
 
+    /** Flat table of the measurement planes of a layered detector, e.g. scintillator bar
+     *  or fibre planes, for fast intersection of tracks with the layers.
+     *  All quantities in world coordinates. Planes are sorted in zPosition.
+     *
+     * @author M.Frank
+     */
+    struct LayerPlaneStruct {
+
+      struct LayerPlane {
+        /// id of the layer DetElement
+        int layerID ;
+        /// id of the enclosing module DetElement - -1 if the layer is placed directly in the subdetector
+        int parentID ;
+        /// z position of the plane origin
+        double zPosition ;
+        /// origin of the plane
+        double origin[3] ;
+        /// normal of the plane
+        double normal[3] ;
+        /// measurement direction
+        double u[3] ;
+        /// second direction (along bars or fibres)
+        double v[3] ;
+        /// full thickness of the layer along the normal
+        double thickness ;
+        /// average radiation length of the layer material
+        double radiationLength ;
+      } ;
+
+      /// the measurement planes, sorted in zPosition
+      std::vector<LayerPlane> planes ;
+    } ;
+    typedef StructExtension<LayerPlaneStruct> LayerPlaneData ;
+
+    std::ostream& operator<<( std::ostream& io , const LayerPlaneData& d ) ;
+
     struct MapStringDoubleStruct {
       std::map<std::string, double> doubleParameters{};
     };
@@ -0,0 +1,125 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDREC_MATERIALMAP_H
+#define DDREC_MATERIALMAP_H
+
+#include "DDRec/MaterialScanEngine.h"
+#include "DDRec/Material.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace dd4hep {
+  namespace rec {
+
+    /** Precomputed table of the material between two surfaces of a detector layer.
+     *
+     *  The material is sampled on the nodes of a regular two dimensional grid
+     *  once with the MaterialScanEngine. Later lookups interpolate bilinearly
+     *  between the four neighbouring nodes in constant time without any
+     *  geometry navigation. Grid coordinates (u,v) are
+     *  - SPHERICAL:   (theta,phi) of rays from the origin between the spheres of radius inner and outer
+     *  - CYLINDRICAL: (theta,phi) of rays from the origin between the cylinders (z-axis) of radius inner and outer
+     *  - PLANAR:      (x,y) of rays parallel to the z-axis between the planes z = origin.z + inner and outer
+     *
+     *  Tables are written to and read from a binary file (native byte order) with
+     *  save() and load(). One file may contain the maps of several layers.
+     *
+     * @author M.Frank
+     */
+    class MaterialMap {
+    public:
+
+      /// Shape of the bounding surfaces and meaning of the grid coordinates
+      enum Type { SPHERICAL = 0, CYLINDRICAL = 1, PLANAR = 2 } ;
+
+      /// Integrated material at one grid node. Linear in the material: may be interpolated
+      typedef MaterialScanEngine::Result Entry ;
+
+    protected:
+      /// Name of the layer
+      std::string        _name{} ;
+      /// Shape of the bounding surfaces
+      Type               _type{SPHERICAL} ;
+      /// Origin of the rays
+      Vector3D           _origin{} ;
+      /// Inner and outer bounding surface
+      double             _inner{0}, _outer{0} ;
+      /// Grid range and number of nodes in u
+      double             _uMin{0}, _uMax{0} ;
+      std::size_t        _nu{0} ;
+      /// Grid range and number of nodes in v
+      double             _vMin{0}, _vMax{0} ;
+      std::size_t        _nv{0} ;
+      /// Inverse node spacing
+      double             _uScale{0}, _vScale{0} ;
+      /// Node values: index i*nv + j
+      std::vector<Entry> _entries{} ;
+
+      /// Recompute the cached node spacing
+      void updateScale() ;
+
+    public:
+      /// Default constructor
+      MaterialMap() = default ;
+      /// Initializing constructor. Ranges of theta/phi in radians, all lengths in dd4hep units
+      MaterialMap(const std::string& name, Type type, const Vector3D& origin, double inner, double outer,
+                  double u_min, double u_max, std::size_t nu,
+                  double v_min, double v_max, std::size_t nv) ;
+      /// Default destructor
+      ~MaterialMap() = default ;
+
+      /// Name of the layer
+      const std::string& name() const { return _name ; }
+      /// Shape of the bounding surfaces
+      Type type() const { return _type ; }
+      /// Number of grid nodes in u
+      std::size_t nu() const { return _nu ; }
+      /// Number of grid nodes in v
+      std::size_t nv() const { return _nv ; }
+
+      /// The ray between the bounding surfaces through the grid node (i,j)
+      MaterialScanEngine::Ray ray(std::size_t i, std::size_t j) const ;
+      /// Fill all grid nodes by tracing their rays through the geometry
+      void build(MaterialScanEngine& engine) ;
+
+      /// Access the value of the grid node (i,j)
+      const Entry& entry(std::size_t i, std::size_t j) const { return _entries[ i * _nv + j ] ; }
+      /// Set the value of the grid node (i,j), e.g. from an external material scan
+      void setEntry(std::size_t i, std::size_t j, const Entry& value) ;
+
+      /// Interpolated material at the grid coordinates (u,v). Coordinates outside the grid are clamped
+      Entry interpolate(double u, double v) const ;
+      /// Interpolated material for the ray through the given point (direction from the origin or (x,y))
+      Entry lookup(const Vector3D& point) const ;
+      /// Averaged material for the ray through the given point
+      MaterialData averagedMaterial(const Vector3D& point) const ;
+      /// Averaged material from integrated values. See MaterialManager::createAveragedMaterial
+      static MaterialData averagedMaterial(const Entry& entry) ;
+
+      /// Write the map to a binary stream
+      void write(std::ostream& os) const ;
+      /// Read the map from a binary stream
+      void read(std::istream& is) ;
+
+      /// Save a set of layer maps to file
+      static void save(const std::string& file_name, const std::vector<MaterialMap>& maps) ;
+      /// Load all layer maps from file
+      static std::vector<MaterialMap> load(const std::string& file_name) ;
+    } ;
+
+  } /* namespace rec */
+} /* namespace dd4hep */
+
+#endif // DDREC_MATERIALMAP_H
@@ -0,0 +1,118 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDREC_MATERIALSCANENGINE_H
+#define DDREC_MATERIALSCANENGINE_H
+
+#include "DDRec/MaterialManager.h"
+#include "DD4hep/Detector.h"
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+class TGeoNavigator;
+
+namespace dd4hep {
+  namespace rec {
+
+    /** Parallel engine to integrate the material budget along many straight rays.
+     *
+     *  Rays are produced in blocks by a generator, distributed to worker threads
+     *  with their own TGeo navigators and the results are handed to the output
+     *  callback in the order of the ray index. Only one block per thread is kept
+     *  in memory: arbitrarily large scans may be streamed to disk.
+     *
+     *  The step algorithm is the one of MaterialManager::materialsBetween.
+     *  Using more than one thread switches the TGeoManager to multi-threaded
+     *  navigation (TGeoManager::SetMaxThreads).
+     *
+     * @author M.Frank
+     */
+    class MaterialScanEngine {
+    public:
+
+      /// Straight ray between two points
+      struct Ray {
+        Vector3D start{} ;
+        Vector3D end{} ;
+      } ;
+
+      /// Integrated material along one ray
+      struct Result {
+        /// Length of the traversed material layers
+        double length{0} ;
+        /// Material budget in units of the radiation length
+        double x0{0} ;
+        /// Material budget in units of the nuclear interaction length
+        double lambda{0} ;
+        /// Sums of density*length, density*length/A and density*length*Z/A for material averaging
+        double rho_l{0} ;
+        double rho_l_over_A{0} ;
+        double rho_l_Z_over_A{0} ;
+        /// False if the start point is outside the world volume
+        bool   valid{false} ;
+      } ;
+
+      /// Ray generator: fill the ray with the given index. Returns false if no more rays
+      typedef std::function<bool(std::uint64_t index, Ray& ray)> generator_t ;
+      /// Output callback: called in ray index order from the calling thread
+      typedef std::function<void(std::uint64_t index, const Ray& ray, const Result& result)> output_t ;
+
+    protected:
+      /// Reference to the TGeoManager
+      TGeoManager* _tgeoMgr{nullptr} ;
+      /// Number of worker threads
+      int          _numThreads{1} ;
+      /// Number of rays per work block
+      std::size_t  _blockSize{4096} ;
+      /// Minimal thickness of material layers
+      double       _epsilon{MaterialManager::epsilon} ;
+
+      /// Integrate the material along one ray with the given navigator
+      void trace(TGeoNavigator* nav, const Ray& ray, Result& result) const ;
+
+    public:
+      /// Initializing constructor
+      MaterialScanEngine(Detector& description, int num_threads = 1, double eps = MaterialManager::epsilon) ;
+      /// Default destructor
+      ~MaterialScanEngine() = default ;
+
+      /// Number of worker threads
+      int numThreads() const { return _numThreads ; }
+      /// Number of rays per work block
+      void setBlockSize(std::size_t block_size) ;
+
+      /// Scan all rays of the generator. Returns the number of scanned rays
+      std::uint64_t scan(const generator_t& generator, const output_t& output) ;
+      /// Scan a fixed set of rays
+      void scan(const std::vector<Ray>& rays, std::vector<Result>& results) ;
+
+      /** Grid of parallel rays: start points origin + i*du + j*dv for i < nu, j < nv.
+       *  Every ray ends at start + path.
+       */
+      static generator_t grid(const Vector3D& origin, const Vector3D& du, const Vector3D& dv,
+                              std::size_t nu, std::size_t nv, const Vector3D& path) ;
+
+      /** Rays of the given length from a common origin with random directions
+       *  uniform in cos(theta) within [theta_min, theta_max] and phi within [phi_min, phi_max].
+       *  The directions depend on the seed and the ray index only: independent of threading.
+       */
+      static generator_t random(const Vector3D& origin, double length, std::uint64_t count,
+                                double theta_min, double theta_max,
+                                double phi_min, double phi_max, std::uint64_t seed = 1) ;
+    } ;
+
+  } /* namespace rec */
+} /* namespace dd4hep */
+
+#endif // DDREC_MATERIALSCANENGINE_H
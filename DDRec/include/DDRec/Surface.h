@@ -599,6 +599,11 @@ namespace dd4hep {
        */
       virtual std::vector< std::pair< Vector3D, Vector3D> > getLines(unsigned nMax=100) ;
 
+      /** Axis aligned box in world coordinates enclosing the volume of the surface.
+       *  Bounds the surface unless its type is unbounded.
+       */
+      void boundingBox( Vector3D& lower, Vector3D& upper ) const ;
+
     protected:
       void initialize() ;
 
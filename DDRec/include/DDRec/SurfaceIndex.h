@@ -0,0 +1,112 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDREC_SURFACEINDEX_H
+#define DDREC_SURFACEINDEX_H
+
+#include "DDRec/ISurface.h"
+
+#include <map>
+#include <vector>
+#include <cstdint>
+
+namespace dd4hep {
+  namespace rec {
+
+    /** Bounding volume hierarchy over a set of surfaces.
+     *
+     *  The surfaces are bounded by the axis aligned boxes of their volumes in
+     *  world coordinates (see Surface::boundingBox). Queries only test the
+     *  surfaces whose boxes contain the point or are crossed by the ray.
+     *  Surfaces of other ISurface implementations have no known extent and
+     *  are tested by every query.
+     *
+     *  The index is immutable once built: all queries are const and may be
+     *  issued concurrently from several threads.
+     *
+     * @author M.Frank
+     */
+    class SurfaceIndex {
+    public:
+
+      /// Crossing of a ray with a surface
+      struct Intersection {
+        /// Distance from the start of the ray
+        double    distance{0} ;
+        /// Crossing point in world coordinates
+        Vector3D  point{} ;
+        /// The surface crossed
+        ISurface* surface{nullptr} ;
+      } ;
+
+    protected:
+      /// Axis aligned box of one surface
+      struct Item {
+        double    lower[3] ;
+        double    upper[3] ;
+        ISurface* surface ;
+      } ;
+      /// Node of the hierarchy. Leaves have count > 0, inner nodes count == 0 and the
+      /// left child at the next index
+      struct Node {
+        double        lower[3] ;
+        double        upper[3] ;
+        std::uint32_t first ;
+        std::uint32_t count ;
+      } ;
+
+      /// Bounded surfaces in leaf order
+      std::vector<Item>      _items{} ;
+      /// Flattened hierarchy, root at index 0
+      std::vector<Node>      _nodes{} ;
+      /// Surfaces without known extent
+      std::vector<ISurface*> _unbounded{} ;
+      /// Padding of the boxes
+      double                 _tolerance{1e-4} ;
+
+      /// Recursively build the hierarchy over the items [first, last)
+      std::uint32_t build(std::uint32_t first, std::uint32_t last) ;
+      /// Collect the crossings of a ray with one surface in [t_min, t_max]
+      void intersect(ISurface* surf, const Vector3D& start, const Vector3D& direction,
+                     double t_min, double t_max, double epsilon, std::vector<Intersection>& result) const ;
+
+    public:
+      /// Build the index over all surfaces of the map. Boxes are padded by tolerance
+      SurfaceIndex(const std::multimap<unsigned long, ISurface*>& surfaces, double tolerance = 1e-4) ;
+      /// Build the index over a list of surfaces
+      SurfaceIndex(const std::vector<ISurface*>& surfaces, double tolerance = 1e-4) ;
+      /// Default destructor
+      ~SurfaceIndex() = default ;
+
+      /// Number of indexed surfaces
+      std::size_t size() const { return _items.size() + _unbounded.size() ; }
+
+      /// Find all surfaces the point lies on
+      void findSurfaces(const Vector3D& point, std::vector<ISurface*>& result, double epsilon = 1e-4) const ;
+      /// Find all surfaces the point lies on
+      std::vector<ISurface*> findSurfaces(const Vector3D& point, double epsilon = 1e-4) const ;
+
+      /** All crossings of the ray start + t * direction, 0 <= t <= max_distance, with the surfaces
+       *  ordered by distance. The direction must be normalized. Curved surfaces are intersected
+       *  numerically: crossings closer than 1/32 of the box chord, e.g. tangential ones, may be missed.
+       */
+      void intersect(const Vector3D& start, const Vector3D& direction, double max_distance,
+                     std::vector<Intersection>& result, double epsilon = 1e-4) const ;
+      /// Same as above, returning the ordered crossings
+      std::vector<Intersection> intersect(const Vector3D& start, const Vector3D& direction,
+                                          double max_distance, double epsilon = 1e-4) const ;
+    } ;
+
+  } /* namespace rec */
+} /* namespace dd4hep */
+
+#endif // DDREC_SURFACEINDEX_H
@@ -14,9 +14,12 @@
 #define DDREC_SURFACEMANAGER_H
 
 #include "DDRec/ISurface.h"
+#include "DDRec/SurfaceIndex.h"
 #include "DD4hep/Detector.h"
 #include <string>
 #include <map>
+#include <memory>
+#include <mutex>
 
 namespace dd4hep {
   namespace rec {
@@ -35,6 +38,7 @@ namespace dd4hep {
     class SurfaceManager {
 
       typedef std::map< std::string,  SurfaceMap > SurfaceMapsMap ;
+      typedef std::map< std::string,  std::unique_ptr<SurfaceIndex> > SurfaceIndexMap ;
 
     public:
       /// The constructor
@@ -61,6 +65,11 @@ namespace dd4hep {
        */
       const SurfaceMap* map( const std::string name ) const ;
 
+      /** Get the spatial index over all surfaces of the map with the given name for
+       *  fast point and ray queries. The index is built on first access. Returns 0 if
+       *  no map exists. Thread safe.
+       */
+      const SurfaceIndex* index( const std::string& name ) const ;
       
       ///create a string with all available maps and their size (number of surfaces)
       std::string toString() const ;
@@ -72,6 +81,10 @@ namespace dd4hep {
       void initialize(const Detector& theDetector) ;
 
       SurfaceMapsMap _map ;
+
+      /// Spatial indices built on demand
+      mutable SurfaceIndexMap _index ;
+      mutable std::mutex      _indexLock ;
     };
 
   } /* namespace rec */
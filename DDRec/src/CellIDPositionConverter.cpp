@@ -17,6 +17,13 @@
 #include <DD4hep/detail/VolumeManagerInterna.h>
 
 #include <TGeoManager.h>
+#include <TGeoMatrix.h>
+
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include <exception>
+#include <unordered_map>
 
 namespace dd4hep {
   namespace rec {
@@ -82,11 +89,125 @@ namespace dd4hep {
     }
 
 
+    namespace {
+
+      /// Cached conversion data of one sensitive volume
+      struct VolumeGroup {
+        VolumeID     volumeID{} ;
+        Segmentation segmentation{} ;
+        TGeoHMatrix  toGlobal{} ;
+      } ;
+    }
+
+    void CellIDPositionConverter::positionsNominal(const CellID* cells, std::size_t num_cells,
+                                                   Position* result, int num_threads) const {
+
+      std::mutex         lock ;
+      std::exception_ptr error ;
+
+      // convert a range of cells: the group caches are local to the calling thread
+      auto convert = [this, cells, result, &lock, &error](std::size_t begin, std::size_t end){
+	std::unordered_map<const VolumeManagerContext*, VolumeGroup> groups ;
+	std::unordered_map<VolumeID, const VolumeGroup*> volumes ;
+	const VolumeGroup* last = nullptr ;
+	try {
+	  for( std::size_t i = begin ; i < end ; ++i ){
+
+	    const CellID       cell  = cells[i] ;
+	    const VolumeGroup* group = nullptr ;
+
+	    // cells of the same sensitive volume have identical bits outside the segmentation fields
+	    if( last ) {
+	      VolumeID vid = last->segmentation.volumeID( cell ) ;
+	      if( vid == last->volumeID ) {
+		group = last ;
+	      } else {
+		auto iv = volumes.find( vid ) ;
+		if( iv != volumes.end() && iv->second->segmentation.volumeID( cell ) == iv->second->volumeID )
+		  group = iv->second ;
+	      }
+	    }
+	    if( ! group ) {
+	      const VolumeManagerContext* context = findContext( cell ) ;
+	      if( context == NULL ) {
+		result[i] = Position() ;
+		continue ;
+	      }
+	      auto ig = groups.find( context ) ;
+	      if( ig == groups.end() ) {
+		ig = groups.emplace( context, VolumeGroup() ).first ;
+		VolumeGroup& g = ig->second ;
+		DetElement det = context->element ;
+		// the nominal alignment may be created on first access
+		std::lock_guard<std::mutex> guard( lock ) ;
+		g.segmentation = findReadout( det ).segmentation() ;
+		g.volumeID     = g.segmentation.volumeID( cell ) ;
+		g.toGlobal     = det.nominal().worldTransformation() ;
+		g.toGlobal.Multiply( &context->toElement() ) ;
+	      }
+	      group = &ig->second ;
+	      volumes[ group->volumeID ] = group ;
+	    }
+	    double l[3], g[3] ;
+	    group->segmentation.position( cell ).GetCoordinates( l ) ;
+	    group->toGlobal.LocalToMaster( l, g ) ;
+	    result[i].SetCoordinates( g ) ;
+	    last = group ;
+	  }
+	} catch( ... ) {
+	  std::lock_guard<std::mutex> guard( lock ) ;
+	  if( ! error ) error = std::current_exception() ;
+	}
+      } ;
+
+      std::size_t nthr = std::max( 1, num_threads ) ;
+      nthr = std::min( nthr, std::max( num_cells / 1024, std::size_t(1) ) ) ;
+      if( nthr <= 1 ) {
+	convert( 0, num_cells ) ;
+      } else {
+	std::vector<std::thread> workers ;
+	std::size_t chunk = ( num_cells + nthr - 1 ) / nthr ;
+	for( std::size_t begin = 0 ; begin < num_cells ; begin += chunk )
+	  workers.emplace_back( convert, begin, std::min( begin + chunk, num_cells ) ) ;
+	for( auto& t : workers )
+	  t.join() ;
+      }
+      if( error )
+	std::rethrow_exception( error ) ;
+    }
+
+    void CellIDPositionConverter::positionsNominal(const std::vector<CellID>& cells, std::vector<Position>& result,
+                                                   int num_threads) const {
+      result.resize( cells.size() ) ;
+      positionsNominal( cells.data(), cells.size(), result.data(), num_threads ) ;
+    }
+
+    void CellIDPositionConverter::positions(const std::vector<CellID>& cells, std::vector<Position>& result,
+                                            int num_threads) const {
+
+      // untill we have the alignment map object, we return the nominal positions
+
+      positionsNominal( cells, result, num_threads ) ;
+    }
+
+
+
+
+    void CellIDPositionConverter::buildSpatialIndex(const std::vector<DetElement>& subdetectors) {
+      if( ! _spatialIndex )
+	_spatialIndex = std::make_shared<CellIDSpatialIndex>( _volumeManager, subdetectors ) ;
+    }
 
 
     CellID CellIDPositionConverter::cellID(const Position& global) const {
 
       CellID result(0) ;
+
+      if( _spatialIndex ) {
+	// if all subdetectors are indexed, a miss means no sensitive volume at this point
+	if( _spatialIndex->cellID( global, result ) || _spatialIndex->isComplete() )
+	  return result ;
+      }
       
       TGeoManager *geoManager = _description->world().volume()->GetGeoManager() ;
       
@@ -0,0 +1,216 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+#include <DDRec/CellIDSpatialIndex.h>
+
+#include <DD4hep/Printout.h>
+#include <DD4hep/Volumes.h>
+#include <DD4hep/detail/VolumeManagerInterna.h>
+
+#include <TGeoNode.h>
+#include <TGeoShape.h>
+#include <TGeoBBox.h>
+#include <TGeoVolume.h>
+
+#include <set>
+#include <map>
+#include <limits>
+#include <algorithm>
+
+namespace dd4hep {
+  namespace rec {
+
+    namespace {
+
+      /// Collect the contexts of a volume manager section and all its subsections
+      void collectContexts(const VolumeManager& mgr, std::set<const VolumeManagerContext*>& contexts) {
+	const detail::VolumeManagerObject* o = mgr.ptr() ;
+	for( const auto& v : o->volumes )
+	  contexts.insert( v.second ) ;
+	for( const auto& s : o->subdetectors )
+	  collectContexts( s.second, contexts ) ;
+      }
+
+      /// Top level subdetector of a detector element
+      DetElement topDetector(DetElement det) {
+	while( det.isValid() && det.parent().isValid() && det.parent().parent().isValid() )
+	  det = det.parent() ;
+	return det ;
+      }
+
+      inline bool inside(const double lower[3], const double upper[3], const double p[3]) {
+	return p[0] >= lower[0] && p[0] <= upper[0] &&
+	  p[1] >= lower[1] && p[1] <= upper[1] &&
+	  p[2] >= lower[2] && p[2] <= upper[2] ;
+      }
+    }
+
+    CellIDSpatialIndex::CellIDSpatialIndex(const VolumeManager& manager, const std::vector<DetElement>& subdetectors) {
+
+      std::set<const VolumeManagerContext*> contexts ;
+      std::map<DetElement, std::vector<Entry> > detectors ;
+      std::set<DetElement> selected( subdetectors.begin(), subdetectors.end() ) ;
+      std::set<DetElement> skipped ;
+
+      collectContexts( manager, contexts ) ;
+
+      for( const VolumeManagerContext* context : contexts ) {
+	PlacedVolume pv = context->volumePlacement() ;
+	if( ! pv.isValid() || ! pv.volume().isSensitive() )
+	  continue ;
+
+	DetElement det = context->element ;
+	DetElement top = topDetector( det ) ;
+	if( ! selected.empty() && selected.find( top ) == selected.end() ) {
+	  skipped.insert( top ) ;
+	  continue ;
+	}
+	SensitiveDetector sd = pv.volume().sensitiveDetector() ;
+	if( ! sd.readout().isValid() || ! sd.readout().segmentation().isValid() )
+	  continue ;
+
+	Entry e ;
+	e.volumeID     = context->identifier ;
+	e.volume       = pv.volume().ptr() ;
+	e.shape        = e.volume->GetShape() ;
+	e.segmentation = sd.readout().segmentation() ;
+	e.toGlobal     = det.nominal().worldTransformation() ;
+	e.toGlobal.Multiply( &context->toElement() ) ;
+
+	// world bounding box from the corners of the local bounding box
+	const TGeoBBox* box = (const TGeoBBox*)e.shape ;
+	const double*   org = box->GetOrigin() ;
+	const double    d[3] = { box->GetDX(), box->GetDY(), box->GetDZ() } ;
+	for( int k = 0 ; k < 3 ; ++k ) {
+	  e.lower[k] =  std::numeric_limits<double>::max() ;
+	  e.upper[k] = -std::numeric_limits<double>::max() ;
+	}
+	for( int c = 0 ; c < 8 ; ++c ) {
+	  double l[3], g[3] ;
+	  for( int k = 0 ; k < 3 ; ++k )
+	    l[k] = org[k] + ( (c>>k)&1 ? d[k] : -d[k] ) ;
+	  e.toGlobal.LocalToMaster( l, g ) ;
+	  for( int k = 0 ; k < 3 ; ++k ) {
+	    e.lower[k] = std::min( e.lower[k], g[k] ) ;
+	    e.upper[k] = std::max( e.upper[k], g[k] ) ;
+	  }
+	}
+	detectors[ top ].emplace_back( std::move( e ) ) ;
+      }
+
+      for( auto& d : detectors ) {
+	std::size_t begin = _entries.size() ;
+	_entries.insert( _entries.end(), std::make_move_iterator( d.second.begin() ), std::make_move_iterator( d.second.end() ) ) ;
+	Tree tree ;
+	tree.detector = d.first ;
+	tree.nodes.emplace_back() ;
+	build( tree, 0, begin, _entries.size() ) ;
+	_trees.emplace_back( std::move( tree ) ) ;
+	printout( DEBUG, "CellIDSpatialIndex", "+++ Indexed %ld sensitive volumes of %s [%ld nodes].",
+		  d.second.size(), d.first.name(), _trees.back().nodes.size() ) ;
+      }
+      _complete = skipped.empty() ;
+      printout( INFO, "CellIDSpatialIndex", "+++ Indexed %ld sensitive volumes of %ld subdetectors.",
+		_entries.size(), _trees.size() ) ;
+    }
+
+    void CellIDSpatialIndex::build(Tree& tree, int slot, std::size_t begin, std::size_t end) {
+      static constexpr std::size_t LEAF_SIZE = 4 ;
+
+      Node node ;
+      double clow[3], cupp[3] ;
+      for( int k = 0 ; k < 3 ; ++k ) {
+	node.lower[k] = clow[k] =  std::numeric_limits<double>::max() ;
+	node.upper[k] = cupp[k] = -std::numeric_limits<double>::max() ;
+      }
+      for( std::size_t i = begin ; i < end ; ++i ) {
+	const Entry& e = _entries[i] ;
+	for( int k = 0 ; k < 3 ; ++k ) {
+	  double c = 0.5 * ( e.lower[k] + e.upper[k] ) ;
+	  node.lower[k] = std::min( node.lower[k], e.lower[k] ) ;
+	  node.upper[k] = std::max( node.upper[k], e.upper[k] ) ;
+	  clow[k] = std::min( clow[k], c ) ;
+	  cupp[k] = std::max( cupp[k], c ) ;
+	}
+      }
+      if( end - begin <= LEAF_SIZE ) {
+	node.first = int( begin ) ;
+	node.count = int( end - begin ) ;
+	tree.nodes[slot] = node ;
+	return ;
+      }
+      // median split along the longest extent of the box centers
+      int axis = 0 ;
+      for( int k = 1 ; k < 3 ; ++k )
+	if( cupp[k] - clow[k] > cupp[axis] - clow[axis] ) axis = k ;
+      std::size_t mid = begin + ( end - begin ) / 2 ;
+      std::nth_element( _entries.begin() + begin, _entries.begin() + mid, _entries.begin() + end,
+			[axis]( const Entry& a, const Entry& b ) {
+			  return a.lower[axis] + a.upper[axis] < b.lower[axis] + b.upper[axis] ;
+			} ) ;
+      // the two children are stored next to each other
+      node.first = int( tree.nodes.size() ) ;
+      tree.nodes[slot] = node ;
+      tree.nodes.emplace_back() ;
+      tree.nodes.emplace_back() ;
+      build( tree, node.first,     begin, mid ) ;
+      build( tree, node.first + 1, mid,   end ) ;
+    }
+
+    bool CellIDSpatialIndex::inDaughter(const TGeoVolume* volume, const double local[3]) {
+      for( int i = 0, n = volume->GetNdaughters() ; i < n ; ++i ) {
+	const TGeoNode* dau = volume->GetNode( i ) ;
+	double l[3] ;
+	dau->GetMatrix()->MasterToLocal( local, l ) ;
+	if( dau->GetVolume()->GetShape()->Contains( l ) )
+	  return true ;
+      }
+      return false ;
+    }
+
+    bool CellIDSpatialIndex::cellID(const Position& global, CellID& cell) const {
+      double g[3] ;
+      int    stack[MAX_DEPTH] ;
+      global.GetCoordinates( g ) ;
+
+      for( const Tree& tree : _trees ) {
+	int depth = 0 ;
+	stack[depth++] = 0 ;
+	while( depth > 0 ) {
+	  const Node& node = tree.nodes[ stack[--depth] ] ;
+	  if( ! inside( node.lower, node.upper, g ) )
+	    continue ;
+	  if( node.count == 0 ) {
+	    stack[depth++] = node.first ;
+	    stack[depth++] = node.first + 1 ;
+	    continue ;
+	  }
+	  for( int i = node.first, last = node.first + node.count ; i < last ; ++i ) {
+	    const Entry& e = _entries[i] ;
+	    double l[3] ;
+	    if( ! inside( e.lower, e.upper, g ) )
+	      continue ;
+	    e.toGlobal.MasterToLocal( g, l ) ;
+	    // points inside daughters belong to the daughter volume (if sensitive it is indexed itself)
+	    if( e.shape->Contains( l ) && ! inDaughter( e.volume, l ) ) {
+	      cell = e.segmentation.cellID( Position( l[0], l[1], l[2] ), global, e.volumeID ) ;
+	      return true ;
+	    }
+	  }
+	}
+      }
+      return false ;
+    }
+
+  } /* namespace rec */
+} /* namespace dd4hep */
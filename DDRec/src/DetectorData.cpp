@@ -213,6 +213,26 @@ namespace dd4hep {
     }
 
 
+    std::ostream& operator<<( std::ostream& io , const LayerPlaneData& d ){
+      boost::io::ios_base_all_saver ifs(io);
+
+      io <<  " --LayerPlaneData: "  << std::scientific << std::endl ; 
+      io <<  " Planes : " << std::endl 
+         <<  "  layerID parentID zPosition normal u thickness radiationLength" << std::endl ;
+
+      for( const auto& l : d.planes ){
+        io << "  " << l.layerID
+           << " " << l.parentID
+           << " " << l.zPosition
+           << " (" << l.normal[0] << "," << l.normal[1] << "," << l.normal[2] << ")"
+           << " (" << l.u[0] << "," << l.u[1] << "," << l.u[2] << ")"
+           << " " << l.thickness
+           << " " << l.radiationLength
+           << std::endl ;
+      }
+      return io ;
+    }
+
     std::ostream& operator<<(std::ostream& io, const DoubleParameters& d) {
       boost::io::ios_base_all_saver ifs(io);
       io <<  " --DoubleParameters: "  << std::scientific << std::endl ;
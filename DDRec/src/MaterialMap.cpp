@@ -0,0 +1,266 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+#include <DDRec/MaterialMap.h>
+
+#include <DD4hep/Printout.h>
+
+#include <cmath>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+namespace dd4hep {
+  namespace rec {
+
+    namespace {
+
+      /// File signature and format version
+      const char          MAP_MAGIC[8] = { 'D','D','4','h','e','p','M','M' } ;
+      const std::uint32_t MAP_VERSION  = 1 ;
+
+      template <typename T> inline void put(std::ostream& os, const T& value) {
+	os.write( reinterpret_cast<const char*>( &value ), sizeof( T ) ) ;
+      }
+      template <typename T> inline T get(std::istream& is) {
+	T value{} ;
+	is.read( reinterpret_cast<char*>( &value ), sizeof( T ) ) ;
+	return value ;
+      }
+
+      /// Add the weighted node value to the interpolated result
+      inline void add(MaterialMap::Entry& result, const MaterialMap::Entry& e, double w) {
+	result.length         += w * e.length ;
+	result.x0             += w * e.x0 ;
+	result.lambda         += w * e.lambda ;
+	result.rho_l          += w * e.rho_l ;
+	result.rho_l_over_A   += w * e.rho_l_over_A ;
+	result.rho_l_Z_over_A += w * e.rho_l_Z_over_A ;
+	result.valid           = result.valid && e.valid ;
+      }
+
+      /// Grid cell and fractional position of a coordinate
+      inline std::size_t locate(double x, double x_min, double scale, std::size_t n, double& frac) {
+	double f = std::min( std::max( ( x - x_min ) * scale, 0e0 ), double( n - 1 ) ) ;
+	std::size_t i = std::min( std::size_t( f ), n - 2 ) ;
+	frac = f - double( i ) ;
+	return i ;
+      }
+    }
+
+    MaterialMap::MaterialMap(const std::string& nam, Type typ, const Vector3D& origin, double inner, double outer,
+			     double u_min, double u_max, std::size_t nu,
+			     double v_min, double v_max, std::size_t nv)
+      : _name( nam ), _type( typ ), _origin( origin ), _inner( inner ), _outer( outer ),
+	_uMin( u_min ), _uMax( u_max ), _nu( nu ), _vMin( v_min ), _vMax( v_max ), _nv( nv ) {
+      if( nu < 2 || nv < 2 || !( u_max > u_min ) || !( v_max > v_min ) ) {
+	except( "MaterialMap", "+++ %s: Invalid grid [%g,%g]x%ld [%g,%g]x%ld. At least 2 nodes per dimension required.",
+		nam.c_str(), u_min, u_max, long( nu ), v_min, v_max, long( nv ) ) ;
+      }
+      _entries.resize( _nu * _nv ) ;
+      updateScale() ;
+    }
+
+    void MaterialMap::updateScale() {
+      _uScale = double( _nu - 1 ) / ( _uMax - _uMin ) ;
+      _vScale = double( _nv - 1 ) / ( _vMax - _vMin ) ;
+    }
+
+    MaterialScanEngine::Ray MaterialMap::ray(std::size_t i, std::size_t j) const {
+      MaterialScanEngine::Ray r ;
+      const double u = _uMin + double( i ) / _uScale ;
+      const double v = _vMin + double( j ) / _vScale ;
+      if( _type == PLANAR ) {
+	r.start = _origin + Vector3D( u, v, _inner ) ;
+	r.end   = _origin + Vector3D( u, v, _outer ) ;
+	return r ;
+      }
+      const Vector3D dir( std::sin( u ) * std::cos( v ), std::sin( u ) * std::sin( v ), std::cos( u ) ) ;
+      double scale = 1e0 ;
+      if( _type == CYLINDRICAL ) {
+	const double sin_t = std::sin( u ) ;
+	/// Parallel to the cylinder axis: no intersection, leave an empty ray
+	if( std::fabs( sin_t ) < 1e-12 ) {
+	  r.start = r.end = _origin ;
+	  return r ;
+	}
+	scale = 1e0 / std::fabs( sin_t ) ;
+      }
+      r.start = _origin + ( _inner * scale ) * dir ;
+      r.end   = _origin + ( _outer * scale ) * dir ;
+      return r ;
+    }
+
+    void MaterialMap::build(MaterialScanEngine& engine) {
+      const std::size_t nv = _nv ;
+      engine.scan( [this, nv]( std::uint64_t index, MaterialScanEngine::Ray& r ) {
+		     if( index >= _entries.size() ) return false ;
+		     r = ray( index / nv, index % nv ) ;
+		     return true ;
+		   },
+		   [this]( std::uint64_t index, const MaterialScanEngine::Ray&, const Entry& result ) {
+		     _entries[index] = result ;
+		   } ) ;
+      printout( DEBUG, "MaterialMap", "+++ %s: Built material map with %ld x %ld nodes.",
+		_name.c_str(), long( _nu ), long( _nv ) ) ;
+    }
+
+    void MaterialMap::setEntry(std::size_t i, std::size_t j, const Entry& value) {
+      if( i >= _nu || j >= _nv ) {
+	except( "MaterialMap", "+++ %s: Grid node (%ld,%ld) out of range [%ld,%ld].",
+		_name.c_str(), long( i ), long( j ), long( _nu ), long( _nv ) ) ;
+      }
+      _entries[ i * _nv + j ] = value ;
+    }
+
+    MaterialMap::Entry MaterialMap::interpolate(double u, double v) const {
+      Entry result ;
+      if( _entries.empty() ) return result ;
+      double fu, fv ;
+      const std::size_t i = locate( u, _uMin, _uScale, _nu, fu ) ;
+      const std::size_t j = locate( v, _vMin, _vScale, _nv, fv ) ;
+      const Entry* e = &_entries[ i * _nv + j ] ;
+      result.valid = true ;
+      add( result, e[0],       ( 1e0 - fu ) * ( 1e0 - fv ) ) ;
+      add( result, e[1],       ( 1e0 - fu ) * fv ) ;
+      add( result, e[_nv],     fu * ( 1e0 - fv ) ) ;
+      add( result, e[_nv + 1], fu * fv ) ;
+      return result ;
+    }
+
+    MaterialMap::Entry MaterialMap::lookup(const Vector3D& point) const {
+      const Vector3D d = point - _origin ;
+      if( _type == PLANAR )
+	return interpolate( d.x(), d.y() ) ;
+      double phi = d.phi() ;
+      /// Map phi periodically into the grid range if possible
+      if( phi < _vMin && phi + 2e0 * M_PI <= _vMax )
+	phi += 2e0 * M_PI ;
+      else if( phi > _vMax && phi - 2e0 * M_PI >= _vMin )
+	phi -= 2e0 * M_PI ;
+      return interpolate( d.theta(), phi ) ;
+    }
+
+    MaterialData MaterialMap::averagedMaterial(const Vector3D& point) const {
+      return averagedMaterial( lookup( point ) ) ;
+    }
+
+    MaterialData MaterialMap::averagedMaterial(const Entry& e) {
+      if( !( e.length > 0e0 ) || !( e.rho_l_over_A > 0e0 ) )
+	return MaterialData() ;
+      return MaterialData( "MaterialMap_average",
+			   e.rho_l_Z_over_A / e.rho_l_over_A,
+			   e.rho_l / e.rho_l_over_A,
+			   e.rho_l / e.length,
+			   e.length / e.x0,
+			   e.length / e.lambda ) ;
+    }
+
+    void MaterialMap::write(std::ostream& os) const {
+      put( os, std::uint32_t( _name.length() ) ) ;
+      os.write( _name.c_str(), _name.length() ) ;
+      put( os, std::int32_t( _type ) ) ;
+      put( os, _origin.x() ) ;
+      put( os, _origin.y() ) ;
+      put( os, _origin.z() ) ;
+      put( os, _inner ) ;
+      put( os, _outer ) ;
+      put( os, _uMin ) ;
+      put( os, _uMax ) ;
+      put( os, std::uint64_t( _nu ) ) ;
+      put( os, _vMin ) ;
+      put( os, _vMax ) ;
+      put( os, std::uint64_t( _nv ) ) ;
+      for( const auto& e : _entries ) {
+	put( os, e.length ) ;
+	put( os, e.x0 ) ;
+	put( os, e.lambda ) ;
+	put( os, e.rho_l ) ;
+	put( os, e.rho_l_over_A ) ;
+	put( os, e.rho_l_Z_over_A ) ;
+	put( os, std::uint8_t( e.valid ? 1 : 0 ) ) ;
+      }
+    }
+
+    void MaterialMap::read(std::istream& is) {
+      _name.resize( get<std::uint32_t>( is ) ) ;
+      is.read( &_name[0], _name.length() ) ;
+      _type  = Type( get<std::int32_t>( is ) ) ;
+      double x = get<double>( is ), y = get<double>( is ), z = get<double>( is ) ;
+      _origin = Vector3D( x, y, z ) ;
+      _inner = get<double>( is ) ;
+      _outer = get<double>( is ) ;
+      _uMin  = get<double>( is ) ;
+      _uMax  = get<double>( is ) ;
+      _nu    = get<std::uint64_t>( is ) ;
+      _vMin  = get<double>( is ) ;
+      _vMax  = get<double>( is ) ;
+      _nv    = get<std::uint64_t>( is ) ;
+      if( !is.good() || _nu < 2 || _nv < 2 || _type < SPHERICAL || _type > PLANAR ) {
+	except( "MaterialMap", "+++ Corrupted material map header [%s].", _name.c_str() ) ;
+      }
+      _entries.resize( _nu * _nv ) ;
+      for( auto& e : _entries ) {
+	e.length         = get<double>( is ) ;
+	e.x0             = get<double>( is ) ;
+	e.lambda         = get<double>( is ) ;
+	e.rho_l          = get<double>( is ) ;
+	e.rho_l_over_A   = get<double>( is ) ;
+	e.rho_l_Z_over_A = get<double>( is ) ;
+	e.valid          = get<std::uint8_t>( is ) != 0 ;
+      }
+      if( !is.good() ) {
+	except( "MaterialMap", "+++ %s: Truncated material map data.", _name.c_str() ) ;
+      }
+      updateScale() ;
+    }
+
+    void MaterialMap::save(const std::string& file_name, const std::vector<MaterialMap>& maps) {
+      std::ofstream os( file_name, std::ios::binary | std::ios::trunc ) ;
+      if( !os.good() ) {
+	except( "MaterialMap", "+++ Cannot open file %s for writing: %s",
+		file_name.c_str(), std::strerror( errno ) ) ;
+      }
+      os.write( MAP_MAGIC, sizeof( MAP_MAGIC ) ) ;
+      put( os, MAP_VERSION ) ;
+      put( os, std::uint32_t( maps.size() ) ) ;
+      for( const auto& m : maps )
+	m.write( os ) ;
+      if( !os.good() ) {
+	except( "MaterialMap", "+++ Failed to write material maps to %s", file_name.c_str() ) ;
+      }
+      printout( INFO, "MaterialMap", "+++ Saved %ld material maps to %s",
+		long( maps.size() ), file_name.c_str() ) ;
+    }
+
+    std::vector<MaterialMap> MaterialMap::load(const std::string& file_name) {
+      std::ifstream is( file_name, std::ios::binary ) ;
+      char magic[sizeof( MAP_MAGIC )] ;
+      if( !is.good() ) {
+	except( "MaterialMap", "+++ Cannot open file %s for reading: %s",
+		file_name.c_str(), std::strerror( errno ) ) ;
+      }
+      is.read( magic, sizeof( magic ) ) ;
+      std::uint32_t version = get<std::uint32_t>( is ) ;
+      if( !is.good() || std::memcmp( magic, MAP_MAGIC, sizeof( magic ) ) != 0 || version != MAP_VERSION ) {
+	except( "MaterialMap", "+++ %s is no material map file of version %u", file_name.c_str(), MAP_VERSION ) ;
+      }
+      std::vector<MaterialMap> maps( get<std::uint32_t>( is ) ) ;
+      for( auto& m : maps )
+	m.read( is ) ;
+      return maps ;
+    }
+
+  } /* namespace rec */
+} /* namespace dd4hep */
@@ -0,0 +1,315 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+#include <DDRec/MaterialScanEngine.h>
+
+#include <DD4hep/Printout.h>
+
+#include <TGeoManager.h>
+#include <TGeoNavigator.h>
+#include <TGeoMaterial.h>
+#include <TGeoMedium.h>
+#include <TGeoNode.h>
+
+#include <cmath>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <condition_variable>
+
+#define MINSTEP 1.e-5
+
+namespace dd4hep {
+  namespace rec {
+
+    namespace {
+
+      /// Stateless 64 bit mixing function (splitmix64)
+      inline std::uint64_t mix64(std::uint64_t x) {
+	x += 0x9E3779B97F4A7C15ULL ;
+	x  = ( x ^ ( x >> 30 ) ) * 0xBF58476D1CE4E5B9ULL ;
+	x  = ( x ^ ( x >> 27 ) ) * 0x94D049BB133111EBULL ;
+	return x ^ ( x >> 31 ) ;
+      }
+
+      /// Uniform number in [0,1) from 64 random bits
+      inline double uniform(std::uint64_t x) {
+	return double( x >> 11 ) * ( 1.0 / 9007199254740992.0 ) ;
+      }
+
+      /// Add a material layer of given thickness to the integrated result
+      inline void accumulate(const TGeoMaterial* mat, double length, MaterialScanEngine::Result& result) {
+	const double rho_l = mat->GetDensity() * length ;
+	result.length         += length ;
+	result.x0             += length / mat->GetRadLen() ;
+	result.lambda         += length / mat->GetIntLen() ;
+	result.rho_l          += rho_l ;
+	result.rho_l_over_A   += rho_l / mat->GetA() ;
+	result.rho_l_Z_over_A += rho_l * mat->GetZ() / mat->GetA() ;
+      }
+
+      /// Block of rays traced in one round by the worker threads
+      struct Block {
+	std::uint64_t                           first{0} ;
+	std::vector<MaterialScanEngine::Ray>    rays{} ;
+	std::vector<MaterialScanEngine::Result> results{} ;
+      } ;
+    }
+
+    MaterialScanEngine::MaterialScanEngine(Detector& description, int num_threads, double eps)
+      : _tgeoMgr( description.world().volume()->GetGeoManager() ),
+	_numThreads( std::max( num_threads, 1 ) ), _epsilon( eps ) {
+    }
+
+    void MaterialScanEngine::setBlockSize(std::size_t block_size) {
+      _blockSize = std::max( block_size, std::size_t(1) ) ;
+    }
+
+    void MaterialScanEngine::trace(TGeoNavigator* nav, const Ray& ray, Result& result) const {
+      double startpoint[3], endpoint[3], direction[3] ;
+      double L = 0 ;
+
+      result = Result() ;
+      for( int i = 0 ; i < 3 ; ++i ) {
+	startpoint[i] = ray.start[i] ;
+	endpoint[i]   = ray.end[i] ;
+	direction[i]  = endpoint[i] - startpoint[i] ;
+	L += direction[i] * direction[i] ;
+      }
+      double totDist = std::sqrt( L ) ;
+      if( totDist <= 0e0 )
+	return ;
+      for( int i = 0 ; i < 3 ; ++i )
+	direction[i] /= totDist ;
+
+      TGeoNode* node1 = nav->InitTrack( startpoint, direction ) ;
+      if( ! node1 )
+	return ;
+
+      bool added = false ;
+      auto add = [this, &result, &added]( const TGeoNode* node, double length ) {
+	if( length > _epsilon ) {
+	  accumulate( node->GetMedium()->GetMaterial(), length, result ) ;
+	  added = true ;
+	}
+      } ;
+      // Same stepping as MaterialManager::materialsBetween
+      while( ! nav->IsOutside() ) {
+	TGeoNode* node2 = nav->FindNextBoundaryAndStep( 500, 1 ) ;
+	if( ! node2 || nav->IsOutside() )
+	  break ;
+
+	const double* position    = nav->GetCurrentPoint() ;
+	const double* previouspos = nav->GetLastPoint() ;
+	double        length      = nav->GetStep() ;
+
+	if( length < MINSTEP ) {
+	  nav->SetCurrentPoint( position[0] + MINSTEP * direction[0],
+				position[1] + MINSTEP * direction[1],
+				position[2] + MINSTEP * direction[2] ) ;
+	  length      = nav->GetStep() ;
+	  node2       = nav->FindNextBoundaryAndStep( 500, 1 ) ;
+	  position    = nav->GetCurrentPoint() ;
+	  previouspos = nav->GetLastPoint() ;
+	  if( ! node2 )
+	    break ;
+	}
+	Vector3D posV( position ) ;
+	if( ( posV - ray.start ).r() > totDist ) {
+	  length = std::sqrt( std::pow( endpoint[0] - previouspos[0], 2 ) +
+			      std::pow( endpoint[1] - previouspos[1], 2 ) +
+			      std::pow( endpoint[2] - previouspos[2], 2 ) ) ;
+	  add( node1, length ) ;
+	  break ;
+	}
+	add( node1, length ) ;
+	node1 = node2 ;
+      }
+      if( ! added ) {
+	accumulate( node1->GetMedium()->GetMaterial(), totDist, result ) ;
+      }
+      result.valid = true ;
+    }
+
+    std::uint64_t MaterialScanEngine::scan(const generator_t& generator, const output_t& output) {
+      std::uint64_t index = 0 ;
+      bool          done  = false ;
+      Ray           ray ;
+
+      /// Single threaded: use the navigator of the caller and restore its state
+      if( _numThreads <= 1 ) {
+	TGeoNavigator* nav = _tgeoMgr->GetCurrentNavigator() ;
+	Result         result ;
+	nav->DoBackupState() ;
+	for( ; generator( index, ray ) ; ++index ) {
+	  trace( nav, ray, result ) ;
+	  output( index, ray, result ) ;
+	}
+	nav->DoRestoreState() ;
+	return index ;
+      }
+
+      /// Multi threaded: every worker thread navigates with its own navigator
+      if( _tgeoMgr->GetMaxThreads() < _numThreads ) {
+	printout( INFO, "MaterialScanEngine", "+++ Enable multi-threaded navigation for %d threads.", _numThreads ) ;
+	_tgeoMgr->SetMaxThreads( _numThreads ) ;
+      }
+      static constexpr std::size_t CHUNK = 64 ;
+      std::mutex               lock ;
+      std::condition_variable  work_cond, done_cond ;
+      std::atomic<std::size_t> next{0} ;
+      std::uint64_t            generation = 0 ;
+      Block*                   current = nullptr ;
+      int                      busy = 0 ;
+      bool                     stop = false ;
+      Block                    blocks[2] ;
+      std::vector<std::thread> workers ;
+
+      auto worker = [&]() {
+	TGeoNavigator* nav  = _tgeoMgr->GetCurrentNavigator() ;
+	std::uint64_t  seen = 0 ;
+	if( ! nav ) nav = _tgeoMgr->AddNavigator() ;
+	for(;;) {
+	  Block* block = nullptr ;
+	  {
+	    std::unique_lock<std::mutex> guard( lock ) ;
+	    work_cond.wait( guard, [&]() { return stop || generation != seen ; } ) ;
+	    if( stop ) break ;
+	    seen  = generation ;
+	    block = current ;
+	  }
+	  const std::size_t n = block->rays.size() ;
+	  for( std::size_t i = next.fetch_add( CHUNK ) ; i < n ; i = next.fetch_add( CHUNK ) ) {
+	    for( std::size_t j = i, last = std::min( i + CHUNK, n ) ; j < last ; ++j )
+	      trace( nav, block->rays[j], block->results[j] ) ;
+	  }
+	  std::lock_guard<std::mutex> guard( lock ) ;
+	  if( --busy == 0 ) done_cond.notify_one() ;
+	}
+	_tgeoMgr->RemoveNavigator( nav ) ;
+      } ;
+      auto fill = [&]( Block& block ) {
+	const std::size_t max_rays = _blockSize * _numThreads ;
+	block.first = index ;
+	block.rays.clear() ;
+	while( ! done && block.rays.size() < max_rays ) {
+	  if( ! generator( index, ray ) ) {
+	    done = true ;
+	    break ;
+	  }
+	  block.rays.emplace_back( ray ) ;
+	  ++index ;
+	}
+	block.results.resize( block.rays.size() ) ;
+      } ;
+      auto start = [&]( Block& block ) {
+	{
+	  std::lock_guard<std::mutex> guard( lock ) ;
+	  current = &block ;
+	  busy    = _numThreads ;
+	  next    = 0 ;
+	  ++generation ;
+	}
+	work_cond.notify_all() ;
+      } ;
+      auto wait = [&]() {
+	std::unique_lock<std::mutex> guard( lock ) ;
+	done_cond.wait( guard, [&]() { return busy == 0 ; } ) ;
+      } ;
+      auto flush = [&]( const Block& block ) {
+	for( std::size_t i = 0 ; i < block.rays.size() ; ++i )
+	  output( block.first + i, block.rays[i], block.results[i] ) ;
+      } ;
+
+      for( int i = 0 ; i < _numThreads ; ++i )
+	workers.emplace_back( worker ) ;
+
+      /// While the workers trace one block, the previous one is written and the next one generated
+      int  cur = 0 ;
+      bool have_prev = false ;
+      try {
+	fill( blocks[cur] ) ;
+	while( ! blocks[cur].rays.empty() ) {
+	  start( blocks[cur] ) ;
+	  if( have_prev ) flush( blocks[1-cur] ) ;
+	  fill( blocks[1-cur] ) ;
+	  wait() ;
+	  have_prev = true ;
+	  cur = 1 - cur ;
+	}
+	if( have_prev ) flush( blocks[1-cur] ) ;
+      }
+      catch( ... ) {
+	wait() ;
+	{
+	  std::lock_guard<std::mutex> guard( lock ) ;
+	  stop = true ;
+	}
+	work_cond.notify_all() ;
+	for( auto& w : workers ) w.join() ;
+	throw ;
+      }
+      {
+	std::lock_guard<std::mutex> guard( lock ) ;
+	stop = true ;
+      }
+      work_cond.notify_all() ;
+      for( auto& w : workers ) w.join() ;
+      return index ;
+    }
+
+    void MaterialScanEngine::scan(const std::vector<Ray>& rays, std::vector<Result>& results) {
+      results.resize( rays.size() ) ;
+      scan( [&rays]( std::uint64_t index, Ray& ray ) {
+	      if( index >= rays.size() ) return false ;
+	      ray = rays[index] ;
+	      return true ;
+	    },
+	    [&results]( std::uint64_t index, const Ray&, const Result& result ) {
+	      results[index] = result ;
+	    } ) ;
+    }
+
+    MaterialScanEngine::generator_t
+    MaterialScanEngine::grid(const Vector3D& origin, const Vector3D& du, const Vector3D& dv,
+			     std::size_t nu, std::size_t nv, const Vector3D& path) {
+      return [=]( std::uint64_t index, Ray& ray ) {
+	if( nv == 0 || index >= std::uint64_t( nu ) * nv ) return false ;
+	double i = double( index / nv ), j = double( index % nv ) ;
+	ray.start = origin + i * du + j * dv ;
+	ray.end   = ray.start + path ;
+	return true ;
+      } ;
+    }
+
+    MaterialScanEngine::generator_t
+    MaterialScanEngine::random(const Vector3D& origin, double length, std::uint64_t count,
+			       double theta_min, double theta_max,
+			       double phi_min, double phi_max, std::uint64_t seed) {
+      const double cos_max = std::cos( theta_min ), cos_min = std::cos( theta_max ) ;
+      return [=]( std::uint64_t index, Ray& ray ) {
+	if( index >= count ) return false ;
+	std::uint64_t h1 = mix64( seed ^ mix64( index ) ) ;
+	std::uint64_t h2 = mix64( h1 ) ;
+	double cos_t = cos_min + uniform( h1 ) * ( cos_max - cos_min ) ;
+	double sin_t = std::sqrt( std::max( 0e0, 1e0 - cos_t * cos_t ) ) ;
+	double phi   = phi_min + uniform( h2 ) * ( phi_max - phi_min ) ;
+	ray.start = origin ;
+	ray.end   = origin + length * Vector3D( sin_t * std::cos( phi ), sin_t * std::sin( phi ), cos_t ) ;
+	return true ;
+      } ;
+    }
+
+  } /* namespace rec */
+} /* namespace dd4hep */
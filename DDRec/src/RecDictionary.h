@@ -65,12 +65,16 @@ using namespace dd4hep::rec;
 
 #pragma link C++ class NeighbourSurfacesStruct+;
 
+#pragma link C++ class LayerPlaneStruct+;
+#pragma link C++ class LayerPlaneStruct::LayerPlane+;
+
 #pragma link C++ class StructExtension<FixedPadSizeTPCStruct>+;
 #pragma link C++ class StructExtension<ZPlanarStruct>+;
 #pragma link C++ class StructExtension<ZDiskPetalsStruct>+;
 #pragma link C++ class StructExtension<ConicalSupportStruct>+;
 #pragma link C++ class StructExtension<LayeredCalorimeterStruct>+;
 #pragma link C++ class StructExtension<NeighbourSurfacesStruct>+;
+#pragma link C++ class StructExtension<LayerPlaneStruct>+;
 
 // DDRec/DetectorSurfaces.h
 #pragma link C++ class DetectorSurfaces+;
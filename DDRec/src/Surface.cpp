@@ -17,7 +17,9 @@
 #include "DDRec/MaterialManager.h"
 
 #include <cmath>
+#include <limits>
 #include <memory>
+#include <algorithm>
 #include <exception>
 
 #include "TGeoMatrix.h"
@@ -716,6 +718,29 @@ namespace dd4hep {
       return _volSurf.insideBounds( localPoint , epsilon) ;
     }
 
+    void Surface::boundingBox( Vector3D& lower, Vector3D& upper ) const {
+
+      // all TGeo shapes provide their bounding box
+      const TGeoBBox* box = static_cast<const TGeoBBox*>( volume()->GetShape() ) ;
+      const double*   o   = box->GetOrigin() ;
+      const double    d[3] = { box->GetDX() , box->GetDY() , box->GetDZ() } ;
+
+      for( int i = 0 ; i < 3 ; ++i ) {
+        lower[i] =  std::numeric_limits<double>::max() ;
+        upper[i] = -std::numeric_limits<double>::max() ;
+      }
+      for( int c = 0 ; c < 8 ; ++c ) {
+        double local[3], global[3] ;
+        for( int i = 0 ; i < 3 ; ++i )
+          local[i] = o[i] + ( ( c >> i ) & 1 ? d[i] : -d[i] ) ;
+        _wtM->LocalToMaster( local , global ) ;
+        for( int i = 0 ; i < 3 ; ++i ) {
+          lower[i] = std::min( lower[i] , global[i] ) ;
+          upper[i] = std::max( upper[i] , global[i] ) ;
+        }
+      }
+    }
+
     void Surface::initialize() {
       
       // first we need to find the right volume for the local surface in the DetElement's volumes
@@ -0,0 +1,250 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+#include <DDRec/SurfaceIndex.h>
+#include <DDRec/Surface.h>
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace dd4hep {
+  namespace rec {
+
+    namespace {
+
+      /// Maximal number of surfaces per leaf
+      constexpr std::uint32_t LEAF_SIZE   = 4 ;
+      /// Maximal depth of the traversal stack
+      constexpr std::size_t   STACK_DEPTH = 64 ;
+      /// Number of samples to bracket the crossings with curved surfaces
+      constexpr int           NUM_SAMPLES = 32 ;
+
+      inline bool contains(const double lower[3], const double upper[3], const Vector3D& p) {
+	return p[0] >= lower[0] && p[0] <= upper[0] &&
+	  p[1] >= lower[1] && p[1] <= upper[1] &&
+	  p[2] >= lower[2] && p[2] <= upper[2] ;
+      }
+
+      /// Clip the interval [t0, t1] of the ray to the box. Returns false if the ray misses the box
+      inline bool clip(const double lower[3], const double upper[3],
+		       const Vector3D& start, const Vector3D& direction, double& t0, double& t1) {
+	for( int i = 0 ; i < 3 ; ++i ) {
+	  const double d = direction[i], s = start[i] ;
+	  if( d == 0e0 ) {
+	    if( s < lower[i] || s > upper[i] ) return false ;
+	    continue ;
+	  }
+	  double ta = ( lower[i] - s ) / d, tb = ( upper[i] - s ) / d ;
+	  if( ta > tb ) std::swap( ta, tb ) ;
+	  t0 = std::max( t0, ta ) ;
+	  t1 = std::min( t1, tb ) ;
+	  if( t0 > t1 ) return false ;
+	}
+	return true ;
+      }
+    }
+
+    SurfaceIndex::SurfaceIndex(const std::multimap<unsigned long, ISurface*>& surfaces, double tolerance)
+      : SurfaceIndex( [&surfaces]() {
+	  std::vector<ISurface*> v ;
+	  v.reserve( surfaces.size() ) ;
+	  for( const auto& s : surfaces ) v.emplace_back( s.second ) ;
+	  return v ;
+	}(), tolerance ) {
+    }
+
+    SurfaceIndex::SurfaceIndex(const std::vector<ISurface*>& surfaces, double tolerance)
+      : _tolerance( tolerance ) {
+      _items.reserve( surfaces.size() ) ;
+      for( ISurface* surf : surfaces ) {
+	const Surface* s = dynamic_cast<const Surface*>( surf ) ;
+	if( ! s || surf->type().isUnbounded() ) {
+	  _unbounded.emplace_back( surf ) ;
+	  continue ;
+	}
+	Vector3D lower, upper ;
+	s->boundingBox( lower, upper ) ;
+	Item item ;
+	for( int i = 0 ; i < 3 ; ++i ) {
+	  item.lower[i] = lower[i] - _tolerance ;
+	  item.upper[i] = upper[i] + _tolerance ;
+	}
+	item.surface = surf ;
+	_items.emplace_back( item ) ;
+      }
+      if( ! _items.empty() ) {
+	_nodes.reserve( 2 * _items.size() / LEAF_SIZE + 1 ) ;
+	build( 0, std::uint32_t( _items.size() ) ) ;
+      }
+    }
+
+    std::uint32_t SurfaceIndex::build(std::uint32_t first, std::uint32_t last) {
+      const std::uint32_t idx = std::uint32_t( _nodes.size() ) ;
+      Node   node ;
+      double c_lower[3], c_upper[3] ;
+      for( int i = 0 ; i < 3 ; ++i ) {
+	node.lower[i] = c_lower[i] =  std::numeric_limits<double>::max() ;
+	node.upper[i] = c_upper[i] = -std::numeric_limits<double>::max() ;
+      }
+      for( std::uint32_t k = first ; k < last ; ++k ) {
+	const Item& it = _items[k] ;
+	for( int i = 0 ; i < 3 ; ++i ) {
+	  const double c = 0.5 * ( it.lower[i] + it.upper[i] ) ;
+	  node.lower[i] = std::min( node.lower[i], it.lower[i] ) ;
+	  node.upper[i] = std::max( node.upper[i], it.upper[i] ) ;
+	  c_lower[i]    = std::min( c_lower[i], c ) ;
+	  c_upper[i]    = std::max( c_upper[i], c ) ;
+	}
+      }
+      node.first = first ;
+      node.count = last - first ;
+      _nodes.emplace_back( node ) ;
+      if( last - first <= LEAF_SIZE )
+	return idx ;
+
+      /// Median split along the longest extent of the box centers
+      int axis = 0 ;
+      for( int i = 1 ; i < 3 ; ++i )
+	if( c_upper[i] - c_lower[i] > c_upper[axis] - c_lower[axis] ) axis = i ;
+      const std::uint32_t mid = first + ( last - first ) / 2 ;
+      std::nth_element( _items.begin() + first, _items.begin() + mid, _items.begin() + last,
+			[axis]( const Item& a, const Item& b ) {
+			  return a.lower[axis] + a.upper[axis] < b.lower[axis] + b.upper[axis] ;
+			} ) ;
+      build( first, mid ) ;
+      const std::uint32_t right = build( mid, last ) ;
+      _nodes[idx].first = right ;
+      _nodes[idx].count = 0 ;
+      return idx ;
+    }
+
+    void SurfaceIndex::findSurfaces(const Vector3D& point, std::vector<ISurface*>& result, double epsilon) const {
+      result.clear() ;
+      for( ISurface* surf : _unbounded )
+	if( surf->insideBounds( point, epsilon ) ) result.emplace_back( surf ) ;
+      if( _nodes.empty() )
+	return ;
+
+      std::uint32_t stack[STACK_DEPTH] ;
+      std::size_t   top = 0 ;
+      stack[top++] = 0 ;
+      while( top > 0 ) {
+	const std::uint32_t idx  = stack[--top] ;
+	const Node&         node = _nodes[idx] ;
+	if( ! contains( node.lower, node.upper, point ) )
+	  continue ;
+	if( node.count > 0 ) {
+	  for( std::uint32_t k = node.first, n = node.first + node.count ; k < n ; ++k ) {
+	    const Item& it = _items[k] ;
+	    if( contains( it.lower, it.upper, point ) && it.surface->insideBounds( point, epsilon ) )
+	      result.emplace_back( it.surface ) ;
+	  }
+	  continue ;
+	}
+	stack[top++] = node.first ;
+	stack[top++] = idx + 1 ;
+      }
+    }
+
+    std::vector<ISurface*> SurfaceIndex::findSurfaces(const Vector3D& point, double epsilon) const {
+      std::vector<ISurface*> result ;
+      findSurfaces( point, result, epsilon ) ;
+      return result ;
+    }
+
+    void SurfaceIndex::intersect(ISurface* surf, const Vector3D& start, const Vector3D& direction,
+				 double t_min, double t_max, double epsilon, std::vector<Intersection>& result) const {
+      Intersection x ;
+      x.surface = surf ;
+      if( surf->type().isPlane() ) {
+	const Vector3D n     = surf->normal() ;
+	const double   denom = n * direction ;
+	if( std::fabs( denom ) < 1e-12 )
+	  return ;
+	x.distance = ( ( surf->origin() - start ) * n ) / denom ;
+	if( x.distance < t_min || x.distance > t_max )
+	  return ;
+	x.point = start + x.distance * direction ;
+	if( surf->insideBounds( x.point, epsilon ) )
+	  result.emplace_back( x ) ;
+	return ;
+      }
+      /// Curved surfaces: bracket the sign changes of the distance and bisect
+      const double dt = ( t_max - t_min ) / double( NUM_SAMPLES ) ;
+      double ta = t_min, fa = surf->distance( start + ta * direction ) ;
+      for( int k = 1 ; k <= NUM_SAMPLES ; ++k ) {
+	double tb = t_min + double( k ) * dt, fb = surf->distance( start + tb * direction ) ;
+	if( ( fa <= 0e0 && fb > 0e0 ) || ( fa >= 0e0 && fb < 0e0 ) ) {
+	  double lo = ta, hi = tb, flo = fa ;
+	  for( int iter = 0 ; iter < 60 && hi - lo > 1e-9 ; ++iter ) {
+	    const double t = 0.5 * ( lo + hi ), f = surf->distance( start + t * direction ) ;
+	    if( ( flo <= 0e0 ) == ( f <= 0e0 ) ) {
+	      lo  = t ;
+	      flo = f ;
+	    }
+	    else {
+	      hi = t ;
+	    }
+	  }
+	  x.distance = 0.5 * ( lo + hi ) ;
+	  x.point    = start + x.distance * direction ;
+	  if( surf->insideBounds( x.point, epsilon ) )
+	    result.emplace_back( x ) ;
+	}
+	ta = tb ;
+	fa = fb ;
+      }
+    }
+
+    void SurfaceIndex::intersect(const Vector3D& start, const Vector3D& direction, double max_distance,
+				 std::vector<Intersection>& result, double epsilon) const {
+      result.clear() ;
+      for( ISurface* surf : _unbounded )
+	intersect( surf, start, direction, 0e0, max_distance, epsilon, result ) ;
+      if( ! _nodes.empty() ) {
+	std::uint32_t stack[STACK_DEPTH] ;
+	std::size_t   top = 0 ;
+	stack[top++] = 0 ;
+	while( top > 0 ) {
+	  const std::uint32_t idx  = stack[--top] ;
+	  const Node&         node = _nodes[idx] ;
+	  double t0 = 0e0, t1 = max_distance ;
+	  if( ! clip( node.lower, node.upper, start, direction, t0, t1 ) )
+	    continue ;
+	  if( node.count > 0 ) {
+	    for( std::uint32_t k = node.first, n = node.first + node.count ; k < n ; ++k ) {
+	      const Item& it = _items[k] ;
+	      double a = 0e0, b = max_distance ;
+	      if( clip( it.lower, it.upper, start, direction, a, b ) )
+		intersect( it.surface, start, direction, a, b, epsilon, result ) ;
+	    }
+	    continue ;
+	  }
+	  stack[top++] = node.first ;
+	  stack[top++] = idx + 1 ;
+	}
+      }
+      std::sort( result.begin(), result.end(),
+		 []( const Intersection& a, const Intersection& b ) { return a.distance < b.distance ; } ) ;
+    }
+
+    std::vector<SurfaceIndex::Intersection>
+    SurfaceIndex::intersect(const Vector3D& start, const Vector3D& direction, double max_distance, double epsilon) const {
+      std::vector<Intersection> result ;
+      intersect( start, direction, max_distance, result, epsilon ) ;
+      return result ;
+    }
+
+  } /* namespace rec */
+} /* namespace dd4hep */
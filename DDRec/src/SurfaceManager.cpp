@@ -52,6 +52,23 @@ namespace dd4hep {
       return 0 ;
     }
 
+    const SurfaceIndex* SurfaceManager::index( const std::string& name ) const {
+
+      const SurfaceMap* sm = map( name ) ;
+
+      if( ! sm )
+        return 0 ;
+
+      std::lock_guard<std::mutex> lock( _indexLock ) ;
+
+      std::unique_ptr<SurfaceIndex>& idx = _index[ name ] ;
+
+      if( ! idx )
+        idx.reset( new SurfaceIndex( *sm ) ) ;
+
+      return idx.get() ;
+    }
+
     void SurfaceManager::initialize(const Detector& description) {
       
       const std::vector<std::string>& types = description.detectorTypes() ;
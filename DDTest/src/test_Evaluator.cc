@@ -81,6 +81,30 @@ int main(int /* argc */, char** /* argv */ ){
       test( r.first, Evaluator::OK, " status OK");
     }
     
+    {
+      // compiled expressions must follow re-definitions of the variables
+      e.setVariable("cacheA", 3.);
+      e.setVariable("cacheB", "cacheA*2");
+      auto r = e.evaluate("cacheB+1");
+      test( r.second , 7., " expression variable");
+      e.setVariable("cacheA", 5.);
+      r = e.evaluate("cacheB+1");
+      test( r.second , 11., " re-defined variable");
+      e.setVariable("cacheB", "cacheA*3");
+      r = e.evaluate("cacheB+1");
+      test( r.second , 16., " re-defined expression variable");
+    }
+
+    {
+      // repeated evaluation must give the same diagnostics
+      for( int i = 0; i < 2; ++i )  {
+        auto r = e.evaluate("1/0");
+        test( r.first, Evaluator::ERROR_CALCULATION_ERROR, " status CALCULATION ERROR");
+        r = e.evaluate("max(1,2");
+        test( r.first, Evaluator::ERROR_UNPAIRED_PARENTHESIS, " status UNPAIRED PARENTHESIS");
+      }
+    }
+
     {
       //use cm as length
       Evaluator e_cm(100.);
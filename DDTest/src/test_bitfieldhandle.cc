@@ -0,0 +1,158 @@
+#include "DD4hep/DDTest.h"
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <algorithm>
+
+#include "DDSegmentation/BitFieldCoder.h"
+
+using namespace std;
+using namespace dd4hep;
+using namespace DDSegmentation;
+
+namespace {
+  /// Time a decoding loop over all identifiers. Returns nanoseconds per identifier
+  template <typename DECODE> double timeit(const vector<CellID>& ids, FieldID& sum, DECODE decode)  {
+    auto start = chrono::steady_clock::now();
+    for( CellID id : ids ) sum += decode(id);
+    auto stop  = chrono::steady_clock::now();
+    return double(chrono::duration_cast<chrono::nanoseconds>(stop-start).count()) / double(ids.size());
+  }
+}
+
+//=============================================================================
+int main(int /* argc */, char** /* argv */ ){
+  // this should be the first line in your test
+  DDTest test( "bitfieldhandle" );
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test bitfieldhandle" );
+
+    // initialize with a string that uses all 64 bits :
+    const BitFieldCoder bf("system:5,side:-2,layer:9,module:8,sensor:8,x:32:-16,y:-16" ) ;
+
+    CellID field = 0  ;
+    BitFieldHandle layer  = bf.handle( "layer" ) ;
+    BitFieldHandle module = bf.handle( "module" ) ;
+    BitFieldHandle sensor = bf.handle( "sensor" ) ;
+    BitFieldHandle side   = bf.handle( "side" ) ;
+    BitFieldHandle system = bf.handle( bf.index( "system" ) ) ;
+    BitFieldHandle x      = bf.handle( "x" ) ;
+    BitFieldHandle y      = bf.handle( "y" ) ;
+
+    layer.set(  field, 373 );
+    module.set( field, 254 );
+    sensor.set( field, 202 );
+    side.set(   field, 1 );
+    system.set( field, 30 );
+    x.set(      field, -310 );
+    y.set(      field, -16710 );
+
+    test(  field , CellID(0xbebafecacafebabeUL)  , " same value 0xbebafecacafebabeUL from handle initialization " );
+
+    test( layer.value( field ) ,  373 , " handle field value: layer" );
+    test( module.value( field ),  254 , " handle field value: module" );
+    test( sensor.value( field ),  202 , " handle field value: sensor" );
+    test( side.value( field ),    1   , " handle field value: side" );
+    test( system.value( field ),  30  , " handle field value: system" );
+    test( x.value( field ),      -310 , " handle field value: x" );
+    test( y.value( field ),    -16710 , " handle field value: y" );
+
+    // out of range values must throw like BitFieldCoder::set
+    bool thrown = false ;
+    try { CellID f = 0 ; side.set( f, 2 ) ; } catch( const exception& ) { thrown = true ; }
+    test( thrown, true, " handle range check: side=2" );
+
+    // compile time layout of the same descriptor
+    typedef BitFieldFixed<7,9>    Layer ;
+    typedef BitFieldFixed<5,-2>   Side ;
+    typedef BitFieldFixed<48,-16> Y ;
+    test( Layer::matches( bf["layer"] ), true , " fixed layout matches: layer" );
+    test( Side::matches(  bf["side"]  ), true , " fixed layout matches: side" );
+    test( Y::matches(     bf["y"]     ), true , " fixed layout matches: y" );
+    test( Layer::matches( bf["module"] ), false , " fixed layout differs: module" );
+    test( Layer::value( field ) ,  373  , " fixed field value: layer" );
+    test( Side::value( field )  ,  1    , " fixed field value: side" );
+    test( Y::value( field )     , -16710, " fixed field value: y" );
+    test( Y::set( Side::set( field, -2 ), 77 ), CellID(0x004dfecacafebadeUL), " fixed field assignment" );
+
+    // all field values of random identifiers must agree with the coder
+    vector<CellID> ids( 1000000 ) ;
+    mt19937_64 rndm( 12345 ) ;
+    for( auto& id : ids ) id = rndm() ;
+
+    size_t mismatches = 0 ;
+    for( size_t i = 0 ; i < bf.size() ; ++i ) {
+      BitFieldHandle h = bf.handle( i ) ;
+      for( size_t j = 0 ; j < 10000 ; ++j ) {
+        CellID id = ids[j], other = ids[j+1], ref = other ;
+        FieldID val = bf.get( id, i ) ;
+        bf.set( ref, i, val ) ;
+        h.set( other, val ) ;
+        if( h.value( id ) != val || other != ref ) ++mismatches ;
+      }
+    }
+    test( mismatches, size_t(0), " handle agrees with coder for random identifiers" );
+
+    // batch decoding and encoding of contiguous arrays
+    vector<FieldID> values( ids.size() ), tuples( 1000 * bf.size() ) ;
+    vector<CellID>  encoded( 1000 ) ;
+    bf.get( ids.data(), ids.size(), bf.index( "x" ), values.data() ) ;
+    mismatches = 0 ;
+    for( size_t j = 0 ; j < ids.size() ; ++j )
+      if( values[j] != bf.get( ids[j], "x" ) ) ++mismatches ;
+    test( mismatches, size_t(0), " batch decoding agrees with coder" );
+
+    bf.decode( ids.data(), 1000, tuples.data() ) ;
+    bf.encode( tuples.data(), 1000, encoded.data() ) ;
+    test( equal( encoded.begin(), encoded.end(), ids.begin() ), true, " batch decode/encode round trip" );
+
+    vector<CellID> copy( ids.begin(), ids.begin() + 1000 ) ;
+    vector<FieldID> sides( 1000, 1 ) ;
+    sides[500] = 2 ;
+    thrown = false ;
+    try { bf.set( copy.data(), copy.size(), bf.index( "side" ), sides.data() ) ; } catch( const exception& ) { thrown = true ; }
+    test( thrown && equal( copy.begin(), copy.end(), ids.begin() ), true, " batch range check leaves input unchanged" );
+
+    // micro-benchmark: decode the signed field y by name, index, handle and fixed layout
+    FieldID sum[4] = { 0, 0, 0, 0 } ;
+    size_t  idx = bf.index( "y" ) ;
+    double  t_name   = timeit( ids, sum[0], [&bf](CellID id)     { return bf.get( id, "y" ) ; } ) ;
+    double  t_index  = timeit( ids, sum[1], [&bf,idx](CellID id) { return bf.get( id, idx ) ; } ) ;
+    double  t_handle = timeit( ids, sum[2], [&y](CellID id)      { return y.value( id ) ; } ) ;
+    double  t_fixed  = timeit( ids, sum[3], [](CellID id)        { return Y::value( id ) ; } ) ;
+
+    test( sum[0] == sum[1] && sum[1] == sum[2] && sum[2] == sum[3], true, " decoded sums agree" );
+
+    auto start = chrono::steady_clock::now() ;
+    y.values( ids.data(), ids.size(), values.data() ) ;
+    auto stop  = chrono::steady_clock::now() ;
+    double t_batch = double( chrono::duration_cast<chrono::nanoseconds>( stop - start ).count() ) / double( ids.size() ) ;
+    test( accumulate( values.begin(), values.end(), FieldID(0) ), sum[3], " batch decoded sum agrees" );
+
+    stringstream str ;
+    str << " decode [nsec/id]  name: " << t_name << "  index: " << t_index
+        << "  handle: " << t_handle << "  fixed: " << t_fixed << "  batch: " << t_batch ;
+    test.log( str.str() );
+
+    // --------------------------------------------------------------------
+
+
+  } catch( exception &e ){
+    //} catch( ... ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
+
+//=============================================================================
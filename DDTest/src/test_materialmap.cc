@@ -0,0 +1,102 @@
+#include "DD4hep/DDTest.h"
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <cstdio>
+
+#include "DDRec/MaterialMap.h"
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::rec;
+
+namespace {
+  /// Node values linear in (u,v): reproduced exactly by the bilinear interpolation
+  MaterialMap::Entry linear(double u, double v)  {
+    MaterialMap::Entry e ;
+    e.length         = 10. + 0.5 * u - 0.25 * v ;
+    e.x0             = e.length / 9.37 ;
+    e.lambda         = e.length / 46.52 ;
+    e.rho_l          = 2.33 * e.length ;
+    e.rho_l_over_A   = e.rho_l / 28.0855 ;
+    e.rho_l_Z_over_A = e.rho_l_over_A * 14. ;
+    e.valid          = true ;
+    return e ;
+  }
+  bool close(double a, double b)  {
+    return std::fabs( a - b ) <= 1e-9 * std::max( 1., std::fabs( b ) ) ;
+  }
+}
+
+//=============================================================================
+int main(int /* argc */, char** /* argv */ ){
+  // this should be the first line in your test
+  DDTest test( "materialmap" );
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test materialmap" );
+
+    MaterialMap planar( "endcap", MaterialMap::PLANAR, Vector3D( 0., 0., 100. ), 0., 5., -10., 10., 5, -20., 20., 9 ) ;
+    for( size_t i = 0 ; i < planar.nu() ; ++i )  {
+      for( size_t j = 0 ; j < planar.nv() ; ++j )  {
+        MaterialScanEngine::Ray r = planar.ray( i, j ) ;
+        planar.setEntry( i, j, linear( r.start.x(), r.start.y() ) ) ;
+      }
+    }
+    MaterialScanEngine::Ray r = planar.ray( 4, 8 ) ;
+    test( close( r.start.x(), 10. ) && close( r.start.y(), 20. ) && close( r.start.z(), 100. ) && close( r.end.z(), 105. ),
+          true, " planar ray of the last grid node" );
+
+    MaterialMap::Entry e = planar.lookup( Vector3D( 3.3, -4.1, 102. ) ), ref = linear( 3.3, -4.1 ) ;
+    test( close( e.length, ref.length ) && close( e.x0, ref.x0 ) && close( e.lambda, ref.lambda ), true,
+          " bilinear interpolation between grid nodes" );
+
+    e = planar.interpolate( 50., 0. ) ;
+    test( close( e.length, linear( 10., 0. ).length ), true, " coordinates outside the grid are clamped" );
+
+    MaterialData avg = MaterialMap::averagedMaterial( e ) ;
+    test( close( avg.Z(), 14. ) && close( avg.A(), 28.0855 ) && close( avg.density(), 2.33 ) &&
+          close( avg.radiationLength(), 9.37 ) && close( avg.interactionLength(), 46.52 ), true,
+          " averaged material of a single material layer" );
+
+    // theta-phi map between two cylinders
+    MaterialMap barrel( "barrel", MaterialMap::CYLINDRICAL, Vector3D(), 10., 12., M_PI/4, 3*M_PI/4, 11, -M_PI, M_PI, 37 ) ;
+    r = barrel.ray( 0, 18 ) ;
+    test( close( r.start.rho(), 10. ) && close( r.end.rho(), 12. ) && close( r.start.theta(), M_PI/4 ), true,
+          " cylindrical ray between the bounding surfaces" );
+
+    // serialization round trip of several layers
+    const string fname = "test_materialmap.bin" ;
+    MaterialMap::save( fname, { planar, barrel } ) ;
+    vector<MaterialMap> maps = MaterialMap::load( fname ) ;
+    ::remove( fname.c_str() ) ;
+    test( maps.size(), size_t(2), " number of loaded maps" );
+    test( maps[0].name() == "endcap" && maps[1].name() == "barrel" && maps[1].type() == MaterialMap::CYLINDRICAL,
+          true, " names and types of loaded maps" );
+    MaterialMap::Entry l = maps[0].lookup( Vector3D( 3.3, -4.1, 102. ) ) ;
+    e = planar.lookup( Vector3D( 3.3, -4.1, 102. ) ) ;
+    test( l.length == e.length && l.x0 == e.x0 && l.lambda == e.lambda && l.valid, true,
+          " loaded map gives identical results" );
+
+    bool thrown = false ;
+    try { MaterialMap( "bad", MaterialMap::PLANAR, Vector3D(), 0., 1., 0., 1., 1, 0., 1., 2 ) ; } catch( const exception& ) { thrown = true ; }
+    test( thrown, true, " grid with less than 2 nodes is rejected" );
+
+    // --------------------------------------------------------------------
+
+
+  } catch( exception &e ){
+    //} catch( ... ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
+
+//=============================================================================
@@ -43,6 +43,28 @@ int main() {
     test.error( "exception occurred" );
   }
 
+  try{
+    // identifiers changed through the parameters like the compact converter does
+    BitFieldCoder bf("system:8,barrel:3,layer:8,slice:5,u:-16,v:-16");
+    Segmentation base("CartesianGridXY","Test",&bf);
+    CartesianGridXY seg(base);
+
+    seg.setGridSizeX(2.0);
+    seg.setGridSizeY(3.0);
+    base.parameter("identifier_x")->setValue("u");
+    base.parameter("identifier_y")->setValue("v");
+
+    CellID cellID = seg.cellID(Position(5.0, -7.0, 0), Position(), 0);
+    test( bf.get(cellID, "u") ==  3, " CG_XY: identifier_x parameter selects field u" );
+    test( bf.get(cellID, "v") == -2, " CG_XY: identifier_y parameter selects field v" );
+    test( fabs(seg.position(cellID).X() - 6.0) < 1e-11, " CG_XY: position in X from field u" );
+    test( fabs(seg.position(cellID).Y() + 6.0) < 1e-11, " CG_XY: position in Y from field v" );
+
+  } catch( std::exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
   try{
     BitFieldCoder bf("system:8,barrel:3,layer:8,slice:5,x:16,z:16");
     Segmentation base("CartesianGridXZ","Test",&bf);
@@ -0,0 +1,115 @@
+#include "DD4hep/DDTest.h"
+#include <exception>
+#include <iostream>
+#include <fstream>
+#include <cmath>
+#include <cstdio>
+
+#include "DDG4/Geant4ShowerLibrary.h"
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::sim;
+
+namespace {
+  /// Shower with n spots along the shower axis, sharing the given visible fraction
+  vector<Geant4ShowerLibrary::Spot> shower(size_t n, float fraction)  {
+    vector<Geant4ShowerLibrary::Spot> spots ;
+    for( size_t i = 0 ; i < n ; ++i )
+      spots.emplace_back( Geant4ShowerLibrary::Spot { 0.f, float(i), 10.f * float(i), fraction / float(n) } ) ;
+    return spots ;
+  }
+}
+
+//=============================================================================
+int main(int /* argc */, char** /* argv */ ){
+  // this should be the first line in your test
+  DDTest test( "showerlibrary" );
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test showerlibrary" );
+
+    Geant4ShowerLibrary::Binning b ;
+    b.energyMin   = 10. ;
+    b.energyMax   = 1000. ;
+    b.numEnergy   = 2 ;
+    b.thetaMax    = M_PI ;
+    b.numTheta    = 2 ;
+    b.depthMin    = 0. ;
+    b.depthMax    = 12. ;
+    b.numDepth    = 3 ;
+    b.depthPeriod = 12. ;
+
+    Geant4ShowerLibrary lib( b ) ;
+    test( lib.numBins(), size_t(12), " number of bins" );
+    test( lib.bin( 50., 0.1, 1. ), 0L, " first bin" );
+    test( lib.bin( 200., 0.1, 1. ), 6L, " logarithmic energy binning" );
+    test( lib.bin( 50., 2.0, 5. ), 4L, " theta and depth binning" );
+    test( lib.bin( 50., 0.1, 12. * 7 + 9. ) == lib.bin( 50., 0.1, 9. ), true, " depth is taken modulo the period" );
+    test( lib.bin( 50., 0.1, -3. ) == lib.bin( 50., 0.1, 9. ), true, " negative depth is wrapped into the period" );
+    test( lib.bin( 5., 0.1, 1. ), -1L, " energy below the library range" );
+    test( lib.bin( 1000., 0.1, 1. ), -1L, " energy above the library range" );
+
+    test( lib.add( 50., 0.1, 1., shower( 3, 0.5f ) ), true, " add shower to the first bin" );
+    test( lib.add( 60., 0.1, 13., shower( 5, 0.4f ) ), true, " add shower to the first bin with wrapped depth" );
+    test( lib.add( 500., 2.0, 9., shower( 2, 0.3f ) ), true, " add shower to the last bin" );
+    test( lib.add( 5000., 0.1, 1., shower( 2, 0.3f ) ), false, " shower outside the library range is rejected" );
+    test( lib.numPending(), size_t(3), " number of showers in memory" );
+
+    // write and map the library
+    const string fname = "test_showerlibrary.bin" ;
+    lib.save( fname ) ;
+    Geant4ShowerLibrary in ;
+    in.open( fname ) ;
+    test( in.isOpen() && in.numShowers() == 3 && in.numSpots() == 10, true, " number of mapped showers and spots" );
+    test( in.numBins() == lib.numBins() && in.binning().depthPeriod == 12., true, " binning of the mapped library" );
+    long ibin = in.bin( 55., 0.2, 2. ) ;
+    test( in.numShowers( ibin ), size_t(2), " number of showers in the first bin" );
+    test( in.numShowers( in.bin( 50., 2.0, 5. ) ), size_t(0), " empty bin" );
+    test( in.numShowers( -1 ), size_t(0), " no showers outside the library range" );
+
+    const Geant4ShowerLibrary::Shower& s = in.shower( ibin, 1 ) ;
+    const Geant4ShowerLibrary::Spot*   p = in.spots( s ) ;
+    float sum = 0.f ;
+    for( uint32_t i = 0 ; i < s.count ; ++i ) sum += p[i].energy ;
+    test( s.count == 5 && s.energy == 60.f && fabs( sum - 0.4f ) < 1e-6f && p[4].z == 40.f, true,
+          " content of the mapped shower" );
+    const Geant4ShowerLibrary::Shower& l = in.shower( in.bin( 500., 2.0, 9. ), 0 ) ;
+    test( l.count == 2 && in.spots( l )[1].y == 1.f, true, " content of the last shower" );
+    in.close() ;
+    test( in.isOpen(), false, " library is unmapped" );
+
+    // truncated files are rejected
+    {
+      ifstream is( fname, ios::binary ) ;
+      string data( ( istreambuf_iterator<char>( is ) ), istreambuf_iterator<char>() ) ;
+      ofstream os( fname, ios::binary | ios::trunc ) ;
+      os.write( data.data(), data.size() - sizeof( Geant4ShowerLibrary::Spot ) ) ;
+    }
+    bool thrown = false ;
+    try { in.open( fname ) ; } catch( const exception& ) { thrown = true ; }
+    ::remove( fname.c_str() ) ;
+    test( thrown, true, " truncated library file is rejected" );
+
+    thrown = false ;
+    b.energyMin = 0. ;
+    try { Geant4ShowerLibrary bad( b ) ; } catch( const exception& ) { thrown = true ; }
+    test( thrown, true, " invalid binning is rejected" );
+
+    // --------------------------------------------------------------------
+
+
+  } catch( exception &e ){
+    //} catch( ... ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
+
+//=============================================================================
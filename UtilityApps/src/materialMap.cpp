@@ -0,0 +1,179 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+//
+//  Program to compute radiation and interaction length maps along
+//  many straight rays with the multi-threaded material scan engine.
+//  The results are streamed as text: one line per ray.
+//  Alternatively a binary material lookup table of a layer is built.
+//
+//  Author     : M.Frank, CERN
+//
+//==========================================================================
+
+#include <TError.h>
+
+// Framework include files
+#include <DD4hep/Detector.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/DD4hepUnits.h>
+#include <DDRec/MaterialScanEngine.h>
+#include <DDRec/MaterialMap.h>
+#include "main.h"
+
+// C/C++ include files
+#include <chrono>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+using namespace dd4hep;
+using namespace dd4hep::rec;
+
+int main_wrapper(int argc, char** argv)   {
+  struct Handler  {
+    Handler() { SetErrorHandler(Handler::print); }
+    static void print(int level, Bool_t abort, const char *location, const char *msg)  {
+      if ( level > kInfo || abort ) ::printf("%s: %s\n", location, msg);
+    }
+    static void usage()  {
+      std::cout << " usage: materialMap compact.xml -grid   x y z  ux uy uz nu  vx vy vz nv  px py pz  [options]" << std::endl
+                << "        -> rays from (x,y,z) + i*(ux,uy,uz) + j*(vx,vy,vz) to start + (px,py,pz)" << std::endl
+                << " or:    materialMap compact.xml -random x y z  length count  thetaMin thetaMax phiMin phiMax  [options]" << std::endl
+                << "        -> rays of given length from (x,y,z) with random directions (angles in degrees)" << std::endl
+                << " or:    materialMap compact.xml -table type inner outer  umin umax nu  vmin vmax nv  -output <file> [options]" << std::endl
+                << "        -> lookup table of the layer between two surfaces. type: spherical, cylindrical (u,v = theta,phi in degrees)" << std::endl
+                << "           or planar (u,v = x,y; planes at z=inner and z=outer)" << std::endl
+                << " options:" << std::endl
+                << "        -threads <number>   Number of worker threads (default: hardware concurrency)" << std::endl
+                << "        -output  <file>     Output file (default: stdout)" << std::endl
+                << "        -seed    <number>   Seed of the random directions (default: 1)" << std::endl
+                << "        -name    <string>   Name of the layer table (default: layer)" << std::endl
+                << " output: index x0 y0 z0 x1 y1 z1 length X0 lambda   (one line per ray)" << std::endl
+		<< " NOTE:  ALL lengths in units of [cm]"
+                << std::endl;
+      exit(EINVAL);
+    }
+  } _handler;
+
+  if ( argc < 3 ) Handler::usage();
+
+  std::string   inFile = argv[1], mode = argv[2], outFile, name = "layer";
+  int           num_threads = std::max(1, int(std::thread::hardware_concurrency()));
+  std::uint64_t seed = 1;
+  std::vector<std::string> args;
+
+  for( int i = 3; i < argc; ++i )   {
+    if ( ::strcmp(argv[i],"-threads") == 0 && i+1 < argc )
+      num_threads = ::atoi(argv[++i]);
+    else if ( ::strcmp(argv[i],"-output") == 0 && i+1 < argc )
+      outFile = argv[++i];
+    else if ( ::strcmp(argv[i],"-seed") == 0 && i+1 < argc )
+      seed = ::strtoull(argv[++i], nullptr, 10);
+    else if ( ::strcmp(argv[i],"-name") == 0 && i+1 < argc )
+      name = argv[++i];
+    else
+      args.emplace_back(argv[i]);
+  }
+  std::stringstream sstr;
+  for( const auto& a : args ) sstr << a << " ";
+  sstr << "NONE";
+
+  MaterialScanEngine::generator_t generator;
+  std::unique_ptr<MaterialMap>    table;
+  if ( mode == "-table" && args.size() == 9 && !outFile.empty() )   {
+    std::string type;
+    double inner, outer, umin, umax, vmin, vmax;
+    std::size_t nu, nv;
+    sstr >> type >> inner >> outer >> umin >> umax >> nu >> vmin >> vmax >> nv;
+    if ( !sstr.good() ) Handler::usage();
+    if ( type == "planar" )   {
+      table.reset(new MaterialMap(name, MaterialMap::PLANAR, Vector3D(), inner*dd4hep::cm, outer*dd4hep::cm,
+                                  umin*dd4hep::cm, umax*dd4hep::cm, nu, vmin*dd4hep::cm, vmax*dd4hep::cm, nv));
+    }
+    else if ( type == "spherical" || type == "cylindrical" )   {
+      table.reset(new MaterialMap(name, type == "spherical" ? MaterialMap::SPHERICAL : MaterialMap::CYLINDRICAL,
+                                  Vector3D(), inner*dd4hep::cm, outer*dd4hep::cm,
+                                  umin*dd4hep::degree, umax*dd4hep::degree, nu,
+                                  vmin*dd4hep::degree, vmax*dd4hep::degree, nv));
+    }
+    else   {
+      Handler::usage();
+    }
+  }
+  else if ( mode == "-grid" && args.size() == 14 )   {
+    double x, y, z, ux, uy, uz, vx, vy, vz, px, py, pz;
+    std::size_t nu, nv;
+    sstr >> x >> y >> z >> ux >> uy >> uz >> nu >> vx >> vy >> vz >> nv >> px >> py >> pz;
+    if ( !sstr.good() ) Handler::usage();
+    generator = MaterialScanEngine::grid(Vector3D(x*dd4hep::cm, y*dd4hep::cm, z*dd4hep::cm),
+                                         Vector3D(ux*dd4hep::cm, uy*dd4hep::cm, uz*dd4hep::cm),
+                                         Vector3D(vx*dd4hep::cm, vy*dd4hep::cm, vz*dd4hep::cm),
+                                         nu, nv,
+                                         Vector3D(px*dd4hep::cm, py*dd4hep::cm, pz*dd4hep::cm));
+  }
+  else if ( mode == "-random" && args.size() == 9 )   {
+    double x, y, z, length, theta_min, theta_max, phi_min, phi_max;
+    std::uint64_t count;
+    sstr >> x >> y >> z >> length >> count >> theta_min >> theta_max >> phi_min >> phi_max;
+    if ( !sstr.good() ) Handler::usage();
+    generator = MaterialScanEngine::random(Vector3D(x*dd4hep::cm, y*dd4hep::cm, z*dd4hep::cm),
+                                           length*dd4hep::cm, count,
+                                           theta_min*dd4hep::degree, theta_max*dd4hep::degree,
+                                           phi_min*dd4hep::degree, phi_max*dd4hep::degree, seed);
+  }
+  else   {
+    Handler::usage();
+  }
+
+  setPrintLevel(WARNING);
+  Detector& description = Detector::getInstance();
+  description.fromXML(inFile);
+
+  if ( table )   {
+    MaterialScanEngine engine(description, num_threads);
+    auto start = std::chrono::steady_clock::now();
+    table->build(engine);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    MaterialMap::save(outFile, { *table });
+    printout(ALWAYS, "materialMap", "+++ Built table %s with %ld x %ld nodes with %d threads in %.3f seconds.",
+             name.c_str(), long(table->nu()), long(table->nv()), engine.numThreads(), secs);
+    return 0;
+  }
+
+  FILE* out = outFile.empty() ? stdout : ::fopen(outFile.c_str(), "w");
+  if ( !out )   {
+    except("materialMap", "+++ Cannot open output file %s: %s", outFile.c_str(), ::strerror(errno));
+  }
+  ::fprintf(out, "# index x0 y0 z0 x1 y1 z1 length X0 lambda\n");
+
+  MaterialScanEngine engine(description, num_threads);
+  std::uint64_t num_invalid = 0;
+  auto start = std::chrono::steady_clock::now();
+  std::uint64_t num_rays = engine.scan(generator,
+    [out, &num_invalid](std::uint64_t index, const MaterialScanEngine::Ray& ray, const MaterialScanEngine::Result& r)  {
+      if ( !r.valid ) ++num_invalid;
+      ::fprintf(out, "%llu %g %g %g %g %g %g %g %g %g\n", (unsigned long long)index,
+                ray.start.x()/dd4hep::cm, ray.start.y()/dd4hep::cm, ray.start.z()/dd4hep::cm,
+                ray.end.x()/dd4hep::cm,   ray.end.y()/dd4hep::cm,   ray.end.z()/dd4hep::cm,
+                r.length/dd4hep::cm, r.x0, r.lambda);
+    });
+  double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if ( out != stdout ) ::fclose(out);
+
+  printout(ALWAYS, "materialMap", "+++ Scanned %llu rays with %d threads in %.3f seconds [%.0f rays/sec]. %llu rays started outside the world.",
+           (unsigned long long)num_rays, engine.numThreads(), secs, secs > 0 ? double(num_rays)/secs : 0e0,
+           (unsigned long long)num_invalid);
+  return 0;
+}
@@ -26,6 +26,7 @@
 #include "EVENT/SimCalorimeterHit.h"
 
 #include <sstream>
+#include <chrono>
 
 using namespace std;
 using namespace dd4hep;
@@ -56,8 +57,20 @@ struct TestCounter{
 struct TestCounters{
   TestCounter position{} ;
   TestCounter cellid{} ;
+  TestCounter bulk{} ;
+  TestCounter index{} ;
+  unsigned    nCells{} ;
+  double      tSingle{} ;
+  double      tBulk{} ;
+  double      tParallel{} ;
+  double      tNavigator{} ;
+  double      tIndex{} ;
 };
 
+double seconds_since( const std::chrono::steady_clock::time_point& start ){
+  return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() ;
+}
+
 typedef std::map<std::string, TestCounters > TestMap ;
 
 
@@ -77,6 +90,13 @@ int main_wrapper(int argc, char** argv ){
 
   CellIDPositionConverter idposConv( description )  ;
 
+  // second converter using the spatial index for the position -> cellID lookup
+  CellIDPositionConverter idposIndex( description )  ;
+  auto start_index = std::chrono::steady_clock::now() ;
+  idposIndex.buildSpatialIndex() ;
+  std::cout << " -- built spatial index of " << idposIndex.spatialIndex()->size() << " sensitive volumes in "
+            << seconds_since( start_index ) << " seconds" << std::endl ;
+
   
   //---------------------------------------------------------------------
   //    open lcio file with SimCalorimeterHits
@@ -171,6 +191,60 @@ int main_wrapper(int argc, char** argv ){
 	  tMap[ colNames[icol] ].position.failed++ ;
 
       }
+
+      // ====== benchmark the bulk conversion of all hits against the hit by hit conversion ==========
+      std::vector<CellID>   ids, idsNavigator, idsIndex ;
+      std::vector<Position> single, bulk, parallel, points ;
+      for(int i=0, n=col->getNumberOfElements() ; i< n ; ++i){
+        SimCalorimeterHit* sHit = (SimCalorimeterHit*) col->getElementAt(i) ;
+        ids.push_back( idDecoder0.toLong( sHit->getCellID0() , sHit->getCellID1() ) ) ;
+        points.emplace_back( sHit->getPosition()[0]* dd4hep::mm , sHit->getPosition()[1]* dd4hep::mm ,  sHit->getPosition()[2]* dd4hep::mm ) ;
+      }
+      TestCounters& cnt = tMap[ colNames[icol] ] ;
+      auto start = std::chrono::steady_clock::now() ;
+      for( CellID id : ids )
+        single.push_back( idposConv.position( id ) ) ;
+      cnt.tSingle += seconds_since( start ) ;
+
+      start = std::chrono::steady_clock::now() ;
+      idposConv.positions( ids, bulk ) ;
+      cnt.tBulk += seconds_since( start ) ;
+
+      start = std::chrono::steady_clock::now() ;
+      idposConv.positions( ids, parallel, 4 ) ;
+      cnt.tParallel += seconds_since( start ) ;
+      cnt.nCells += ids.size() ;
+
+      for(std::size_t i=0 ; i < ids.size() ; ++i){
+        if( dist( single[i], bulk[i] ) < epsilon && dist( single[i], parallel[i] ) < epsilon )
+          cnt.bulk.passed++ ;
+        else
+          cnt.bulk.failed++ ;
+      }
+      std::stringstream sst2 ;
+      sst2 << " bulk positions of " << ids.size() << " hits in collection " << colNames[icol] ;
+      test( cnt.bulk.failed, 0U, sst2.str() ) ;
+
+      // ====== benchmark the position -> cellID lookup: TGeo navigator against the spatial index ====
+      start = std::chrono::steady_clock::now() ;
+      for( const Position& p : points )
+        idsNavigator.push_back( idposConv.cellID( p ) ) ;
+      cnt.tNavigator += seconds_since( start ) ;
+
+      start = std::chrono::steady_clock::now() ;
+      for( const Position& p : points )
+        idsIndex.push_back( idposIndex.cellID( p ) ) ;
+      cnt.tIndex += seconds_since( start ) ;
+
+      for(std::size_t i=0 ; i < points.size() ; ++i){
+        if( idsNavigator[i] == idsIndex[i] )
+          cnt.index.passed++ ;
+        else
+          cnt.index.failed++ ;
+      }
+      std::stringstream sst3 ;
+      sst3 << " spatial index cellIDs of " << points.size() << " hits in collection " << colNames[icol] ;
+      test( cnt.index.failed, 0U, sst3.str() ) ;
     }
     
   }
@@ -191,6 +265,16 @@ int main_wrapper(int argc, char** argv ){
            name.c_str(), pos_failed , id_failed, total ) ;
 
   }
+  std::cout << "\n ----------------------- timing  -----------------------   " << std::endl ;
+
+  for( const auto& res : tMap )  {
+    const TestCounters& cnt = res.second ;
+    double n = std::max( cnt.nCells, 1U ) ;
+    printf(" %-30s \t  %7d hits  [usec/hit] single: %7.3f  bulk: %7.3f  bulk 4 threads: %7.3f  failed: %5d \n",
+           res.first.c_str(), cnt.nCells, 1e6*cnt.tSingle/n, 1e6*cnt.tBulk/n, 1e6*cnt.tParallel/n, cnt.bulk.failed ) ;
+    printf(" %-30s \t  %7d hits  [usec/hit] navigator: %7.3f  spatial index: %7.3f  failed: %5d \n",
+           res.first.c_str(), cnt.nCells, 1e6*cnt.tNavigator/n, 1e6*cnt.tIndex/n, cnt.index.failed ) ;
+  }
   std::cout << "\n -------------------------------------------------------- " << std::endl ;
 
   
@@ -16,6 +16,7 @@
 #include "DDRec/DetectorSurfaces.h"
 #include "DDRec/SurfaceManager.h"
 #include "DDRec/SurfaceHelper.h"
+#include "DDRec/SurfaceIndex.h"
 #include "DD4hep/DDTest.h"
 
 #include "DD4hep/DD4hepUnits.h"
@@ -28,7 +29,10 @@
 #include "UTIL/ILDConf.h"
 
 #include <map>
+#include <chrono>
+#include <vector>
 #include <sstream>
+#include <algorithm>
 
 using namespace std ;
 using namespace dd4hep ;
@@ -94,6 +98,9 @@ int main_wrapper(int argc, char** argv ){
 
   EVENT::LCEvent* evt = 0 ;
 
+  // hit points and their surfaces for the lookup benchmark
+  std::vector< std::pair< Vector3D, ISurface* > > hitSurfaces ;
+
 
   while( ( evt = rdr->readNextEvent() ) != 0 ){
 
@@ -159,6 +166,8 @@ int main_wrapper(int argc, char** argv ){
           // ====== test that hit points are inside their surface ================================
 	  
           test( isInside , true , sst.str() ) ;
+
+          if( isInside ) hitSurfaces.emplace_back( point , surf ) ;
 	  
           if( ! isInside ) {
 
@@ -212,6 +221,64 @@ int main_wrapper(int argc, char** argv ){
     
     
   }
+
+  //---------------------------------------------------------------------
+  //    benchmark the surface lookup: linear scan vs. spatial index
+  //---------------------------------------------------------------------
+
+  typedef std::chrono::steady_clock bench_clock ;
+
+  auto t0 = bench_clock::now() ;
+  const SurfaceIndex& surfIndex = *surfMan.index( "world" ) ;
+  auto t1 = bench_clock::now() ;
+
+  std::vector< ISurface* > found ;
+  std::vector< SurfaceIndex::Intersection > crossings ;
+  unsigned nLinear = std::min< unsigned >( hitSurfaces.size() , 1000 ) ;
+  unsigned nFound = 0 ;
+
+  auto t2 = bench_clock::now() ;
+  for( unsigned i=0 ; i < nLinear ; ++i ){
+    for( const auto& s : surfMap ){
+      if( s.second->insideBounds( hitSurfaces[i].first ) ) ++nFound ;
+    }
+  }
+  auto t3 = bench_clock::now() ;
+  for( const auto& h : hitSurfaces ){
+    surfIndex.findSurfaces( h.first , found ) ;
+    nFound += found.size() ;
+  }
+  auto t4 = bench_clock::now() ;
+
+  for( const auto& h : hitSurfaces ){
+
+    // ====== test that the index finds the surface of every hit ================================
+
+    surfIndex.findSurfaces( h.first , found ) ;
+    std::stringstream sst ;
+    sst << " index finds surface " << std::hex << h.second->id() << std::dec << " for point " << h.first ;
+    test( std::find( found.begin() , found.end() , h.second ) != found.end() , true , sst.str() ) ;
+
+    // ====== test that a ray from the origin to the hit crosses its surface ====================
+
+    surfIndex.intersect( Vector3D() , h.first.unit() , h.first.r() + 1e-3 , crossings ) ;
+    sst.str("") ;
+    sst << " ray to point " << h.first << " crosses surface " << std::hex << h.second->id() << std::dec ;
+    test( std::find_if( crossings.begin() , crossings.end() ,
+                        [&h]( const SurfaceIndex::Intersection& c ){ return c.surface == h.second ; } ) != crossings.end() ,
+          true , sst.str() ) ;
+  }
+
+  auto usec = []( bench_clock::time_point a , bench_clock::time_point b ){
+    return std::chrono::duration<double,std::micro>( b - a ).count() ;
+  } ;
+  std::stringstream sst ;
+  sst << " surface lookup for " << hitSurfaces.size() << " hits, " << surfIndex.size() << " surfaces [" << nFound << "]:"
+      << " index build: " << usec( t0 , t1 ) << " us"
+      << "  linear scan: " << ( nLinear ? usec( t2 , t3 ) / nLinear : 0. ) << " us/point"
+      << "  index: " << ( hitSurfaces.size() ? usec( t3 , t4 ) / hitSurfaces.size() : 0. ) << " us/point" ;
+  test.log( sst.str() ) ;
+
   return 0;
 }
 
@@ -0,0 +1,119 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#
+import os
+import time
+import logging
+import DDG4
+from DDG4 import OutputLevel as Output
+from g4units import GeV, MeV, m
+#
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+#
+"""
+
+   dd4hep simulation example setup in the Geant4 sub-event parallel mode (Geant4 >= 11.2)
+
+   The master thread tracks the primaries. All secondaries are shipped to
+   sub-events, which are tracked by the worker threads. The hits and the
+   MC truth of the sub-events are merged into the master event before
+   the master event is written.
+
+   @author  M.Frank
+   @version 1.0
+
+"""
+
+
+def setupParticleHandler(kernel):
+  part = DDG4.GeneratorAction(kernel, "Geant4ParticleHandler/ParticleHandler")
+  kernel.generatorAction().adopt(part)
+  part.SaveProcesses = ['Decay']
+  part.MinimalKineticEnergy = 100 * MeV
+  part.OutputLevel = Output.INFO
+  part.enableUI()
+  user = DDG4.Action(kernel, "Geant4TCUserParticleHandler/UserParticleHandler")
+  user.TrackingVolume_Zmax = 3.0 * m
+  user.TrackingVolume_Rmax = 3.0 * m
+  user.enableUI()
+  part.adopt(user)
+  return part
+
+
+def setupWorker(geant4):
+  kernel = geant4.kernel()
+  logger.info('#PYTHON: +++ Creating Geant4 worker thread ....')
+  # The worker threads only track sub-events: collect their MC truth
+  setupParticleHandler(kernel)
+  return 1
+
+
+def setupMaster(geant4):
+  kernel = geant4.master()
+  logger.info('#PYTHON: +++ Setting up master thread for %d workers', int(kernel.NumberOfThreads))
+  prt = DDG4.EventAction(kernel, 'Geant4ParticlePrint/ParticlePrint')
+  prt.OutputLevel = Output.INFO
+  prt.OutputType = 3  # Print both: table and tree
+  kernel.eventAction().adopt(prt)
+
+  geant4.setupROOTOutput('RootOutput', 'SiliconBlockSubEvents_' + time.strftime('%Y-%m-%d_%H-%M'))
+
+  gun = geant4.setupGun("Gun", particle='e+', energy=20 * GeV, multiplicity=1)
+  gun.OutputLevel = Output.INFO
+  setupParticleHandler(kernel)
+
+  # Ship all secondaries of the primaries to the worker threads
+  stack = DDG4.StackingAction(kernel, 'Geant4SubEventStackingAction/SubEvents')
+  stack.Generation = 1
+  stack.MinimumEnergy = 0 * MeV
+  kernel.stackingAction().add(stack)
+  return 1
+
+
+def setupSensitives(geant4):
+  geant4.setupTracker('SiliconBlockUpper')
+  geant4.setupTracker('SiliconBlockDown')
+  return 1
+
+
+def run():
+  args = DDG4.CommandLine()
+  kernel = DDG4.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  kernel.loadGeometry(str("file:" + install_dir + "/examples/ClientTests/compact/SiliconBlock.xml"))
+  DDG4.importConstants(kernel.detectorDescription(), debug=False)
+
+  kernel.NumberOfThreads = 2
+  kernel.RunManagerType = 'G4SubEvtRunManager'
+  geant4 = DDG4.Geant4(kernel, tracker='Geant4TrackerCombineAction')
+  geant4.printDetectors()
+  ui = geant4.setupCshUI()
+  if args.batch:
+    ui.Commands = ['/run/beamOn ' + str(args.events), '/ddg4/UI/terminate']
+
+  geant4.addUserInitialization(worker=setupWorker, worker_args=(geant4,),
+                               master=setupMaster, master_args=(geant4,))
+
+  seq, act = geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+  seq, act = geant4.addDetectorConstruction("Geant4PythonDetectorConstruction/SetupSD",
+                                            sensitives=setupSensitives, sensitives_args=(geant4,))
+  seq, act = geant4.addDetectorConstruction("Geant4DetectorSensitivesConstruction/ConstructSD")
+  geant4.setupTrackingFieldMT()
+
+  phys = geant4.setupPhysics('QGSP_BERT')
+  phys.dump()
+  geant4.run()
+
+
+if __name__ == "__main__":
+  run()
@@ -0,0 +1,38 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+
+
+def run():
+  import DigiTest
+  from dd4hep import units
+  digi = DigiTest.Test(geometry=None)
+
+  event = DigiTest.test_setup_1(digi)
+  proc = event.adopt_action('DigiContainerSequenceAction/Noise',
+                            parallel=False,
+                            input_mask=0xEEE5,
+                            input_segment='deposits',
+                            output_mask=0xFFF0,
+                            output_segment='outputs')
+  # Noise generated per container in one batch from counter based random streams
+  noise = digi.create_action('DigiDepositNoiseOnSignal/NoiseOnSignal')
+  noise.processor_type = 'DigiGaussianNoise'
+  noise.processor_properties = {'sigma': str(1 * units.keV)}
+  proc.adopt_container_processor(noise, digi.containers())
+
+  event.adopt_action('DigiStoreDump/HeaderDump')
+  # ========================================================================================================
+  digi.info('Starting digitization core')
+  digi.run_checked(num_events=5, num_threads=7, parallel=5)
+
+
+if __name__ == '__main__':
+  run()
@@ -0,0 +1,53 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from g4units import ns
+
+
+def run():
+  import DigiTest
+  digi = DigiTest.Test(geometry=None)
+
+  input_action = digi.input_action('DigiParallelActionSequence/READER')
+  # ========================================================================================================
+  digi.info('Created SIGNAL input')
+  signal = input_action.adopt_action('DigiDDG4ROOT/SignalReader', mask=0x0, input=[digi.next_input()])
+  digi.check_creation([signal])
+  # ========================================================================================================
+  digi.info('Creating pile-up library....')
+  # ========================================================================================================
+  pileup = input_action.adopt_action('DigiPileupLibrary/PileupLibrary',
+                                     input=[digi.next_input(), digi.next_input()],
+                                     library_size=50,
+                                     multiplicity=3.0,
+                                     poisson=True,
+                                     output_mask=0x1,
+                                     bunch_spacing=25 * ns,
+                                     bunch_range=[-2, 2])
+  digi.check_creation([pileup])
+  digi.info('Created input.pileup')
+  # ========================================================================================================
+  event = digi.event_action('DigiSequentialActionSequence/EventAction')
+  combine = event.adopt_action('DigiContainerCombine/Combine',
+                               parallel=True,
+                               input_masks=[0x0, 0x1],
+                               output_mask=0xFEED,
+                               output_segment='deposits',
+                               erase_combined=True)
+  dump = event.adopt_action('DigiStoreDump/StoreDump')
+  digi.check_creation([combine, dump])
+  digi.info('Created event.dump')
+
+  # ========================================================================================================
+  digi.run_checked(num_events=5, num_threads=10, parallel=3)
+
+
+if __name__ == '__main__':
+  run()
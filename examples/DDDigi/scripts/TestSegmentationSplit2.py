@@ -32,6 +32,7 @@ def run():
   splitter = digi.create_action('DigiSegmentSplitter/Splitter',
                                 parallel=True,
                                 split_by='module',
+                                skip_empty=True,
                                 detector='Minitel1')
   printer = digi.create_action('DigiSegmentDepositPrint/P1')
   splitter.get().adopt_segment_processor(printer, 1)
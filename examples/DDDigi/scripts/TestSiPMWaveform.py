@@ -0,0 +1,56 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from g4units import ns, MeV
+
+
+def run():
+  import DigiTest
+  digi = DigiTest.Test(geometry=None)
+  digi.load_geo()
+  input_action = digi.input_action('DigiParallelActionSequence/READER')
+  # ========================================================================
+  digi.info('Created SIGNAL input')
+  signal = input_action.adopt_action('DigiDDG4ROOT/SignalReader',
+                                     mask=0x0,
+                                     input=[digi.next_input()])
+  digi.check_creation([signal])
+  # ========================================================================
+  event = digi.event_action('DigiSequentialActionSequence/EventAction')
+  split_action = event.adopt_action('DigiContainerSequenceAction/WaveformSequence',
+                                    parallel=True,
+                                    input_mask=0x0,
+                                    input_segment='inputs',
+                                    output_segment='outputs',
+                                    output_mask=0xBABE)
+  splitter = digi.create_action('DigiSegmentSplitter/Splitter',
+                                parallel=True,
+                                split_by='module',
+                                detector='Minitel1')
+  waveform = digi.create_action('DigiSiPMWaveform/Waveform',
+                                light_yield=100.0 / MeV,
+                                rise_time=1.0 * ns,
+                                fall_time=15.0 * ns,
+                                window_start=-5.0 * ns,
+                                sampling_period=0.5 * ns,
+                                num_samples=160,
+                                noise_sigma=0.2,
+                                threshold=2.0)
+  splitter.adopt_segment_processor(waveform, [1, 2, 3, 4, 5, 6, 7, 8, 9])
+  split_action.adopt_container_processor(splitter, splitter.collection_names())
+
+  event.adopt_action('DigiStoreDump/StoreDump')
+  digi.info('Created event.dump')
+  # ========================================================================
+  digi.run_checked(num_events=5, num_threads=10, parallel=3)
+
+
+if __name__ == '__main__':
+  run()
@@ -0,0 +1,132 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+/// Framework include files
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/Primitives.h>
+#include <DDDigi/DigiKernel.h>
+#include <DDDigi/DigiContext.h>
+#include <DDDigi/noise/DigiRandomNoise.h>
+#include <DDDigi/noise/DigiGaussianNoise.h>
+
+/// C/C++ include files
+#include <map>
+#include <cmath>
+#include <vector>
+#include <memory>
+#include <iostream>
+
+using namespace dd4hep;
+using namespace dd4hep::digi;
+
+namespace  {
+
+  /// Event context with a private counter based random generator
+  class TestContext : public DigiContext  {
+  public:
+    TestContext(const DigiKernel& krnl, int event, std::uint64_t seed)
+      : DigiContext(krnl, std::make_unique<DigiEvent>(event))
+    {
+      auto random = std::make_shared<DigiRandomGenerator>();
+      random->seed = seed;
+      set_random_generator(random);
+    }
+  };
+
+  /// Process the cells in the given order, split into batches of at most 'chunk' cells
+  std::map<CellID, double> run(const DigiKernel& krnl, const DigiSignalProcessor& proc,
+                               int event, std::vector<CellID> cells, std::size_t chunk)  {
+    TestContext context(krnl, event, 12345);
+    std::map<CellID, double> result;
+    for( std::size_t i = 0; i < cells.size(); i += chunk )  {
+      std::size_t n = std::min(chunk, cells.size() - i);
+      std::vector<double> signals(n, 1e0), values(n, 0e0);
+      DigiCellBatch batch(context, n, cells.data() + i, signals.data(), values.data());
+      proc.process(batch);
+      for( std::size_t j = 0; j < n; ++j )
+        result[cells[i+j]] = values[j];
+    }
+    return result;
+  }
+
+  /// Correlation coefficient of the values of the same cells
+  double correlation(const std::map<CellID, double>& a, const std::map<CellID, double>& b)  {
+    double sa = 0, sb = 0, saa = 0, sbb = 0, sab = 0, n = double(a.size());
+    for( const auto& v : a )  {
+      double x = v.second, y = b.at(v.first);
+      sa += x; sb += y; saa += x*x; sbb += y*y; sab += x*y;
+    }
+    return (sab/n - sa*sb/n/n) / std::sqrt((saa/n - sa*sa/n/n) * (sbb/n - sb*sb/n/n));
+  }
+}
+
+/// Plugin to test the reproducibility of the batch noise generation
+/**
+ *  Factory: DD4hep_DigiNoiseBatch
+ *
+ *  The noise of each cell must not depend on the composition nor on the order
+ *  of the batches. The colored noise must be correlated between consecutive events.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ */
+static long test_DigiNoiseBatch(Detector& description, int argc, char** argv) {
+  std::size_t num_cells = 2000;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-cells",argv[i],3) )
+      num_cells = ::atol(argv[++i]);
+    else  {
+      std::cout <<
+        "Usage: -plugin DD4hep_DigiNoiseBatch -arg [-arg]                         \n"
+        "     -cells    <value>  Number of cells to be processed [default: 2000]  \n"
+        "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  DigiKernel& krnl = DigiKernel::instance(description);
+  std::vector<CellID> cells, reversed;
+  for( std::size_t i = 0; i < num_cells; ++i )
+    cells.emplace_back(CellID(i) * 7919 + 3);
+  reversed.assign(cells.rbegin(), cells.rend());
+
+  auto* gauss = new DigiGaussianNoise(krnl, "GaussianNoise");
+  gauss->property("sigma") = 1e0;
+  gauss->initialize();
+  auto* pink = new DigiRandomNoise(krnl, "PinkNoise");
+  pink->property("alpha")    = 1e0;
+  pink->property("variance") = 1e0;
+  pink->initialize();
+
+  bool ok = true;
+  for( const DigiSignalProcessor* proc : { (const DigiSignalProcessor*)gauss, (const DigiSignalProcessor*)pink } )  {
+    auto ref      = run(krnl, *proc, 10, cells, cells.size());
+    auto repeated = run(krnl, *proc, 10, cells, cells.size());
+    auto split    = run(krnl, *proc, 10, reversed, 97);
+    auto next     = run(krnl, *proc, 11, cells, cells.size());
+    bool same = ref == repeated && ref == split;
+    double corr = correlation(ref, next);
+    printout(INFO, "DigiNoiseBatch", "%-16s reproducible: %s  correlation to next event: %7.3f",
+             proc->name().c_str(), same ? "YES" : "NO ", corr);
+    ok &= same && ref != next;
+    if ( proc == gauss )
+      ok &= std::abs(corr) < 0.1;
+    else
+      ok &= corr > 0.3;
+  }
+  detail::releasePtr(gauss);
+  detail::releasePtr(pink);
+  printout(ok ? INFO : ERROR, "DigiNoiseBatch", "+++ Batch noise test %s", ok ? "PASSED" : "FAILED");
+  return ok ? 1 : 0;
+}
+DECLARE_APPLY(DD4hep_DigiNoiseBatch,test_DigiNoiseBatch)